@@ -1,6 +1,8 @@
 #pragma once
 
 #include "actor.h"
+#include "world_state.h"
+#include "action_pool.h"
 #include <cstdint>
 
 /**
@@ -22,6 +24,10 @@ public:
         : actor(target), duration(durationSeconds), oneShot(oneShot), elapsed(0.0f) {}
     virtual ~Action() = default;
 
+    /* Actions live in the ActionPool so registering one does not allocate during gameplay */
+    static void* operator new(std::size_t size) { return ActionPool::Instance().Allocate(size); }
+    static void operator delete(void* block, std::size_t size) noexcept { ActionPool::Instance().Release(block, size); }
+
     /**
      * @brief Called each update tick. Implementations perform their logic.
      *
@@ -46,6 +52,11 @@ public:
      */
     Actor& GetActor() { return actor; }
 
+    /**
+     * @brief Access the target actor reference (read-only).
+     */
+    const Actor& GetActor() const { return actor; }
+
     /**
      * @brief Returns true if this action uses a positive duration.
      */
@@ -67,6 +78,30 @@ public:
      */
     bool IsExpired() const { return (IsTimed() && (elapsed >= duration)) || (oneShot && performedOnce); }
 
+    /**
+     * @brief Capture kind, parameters and timing of this action.
+     *
+     * The base implementation stores timing only; concrete actions add their kind and
+     * parameters. The caller is responsible for `targetSlot` and `activeMove`.
+     *
+     * @param snapshot Record to fill.
+     */
+    virtual void SaveSnapshot(ActionSnapshot& snapshot) const {
+        snapshot.duration = duration;
+        snapshot.elapsed = elapsed;
+        snapshot.performedOnce = performedOnce;
+    }
+
+    /**
+     * @brief Restore timing captured by SaveSnapshot onto a freshly created action.
+     *
+     * @param snapshot Record to apply.
+     */
+    void RestoreTiming(const ActionSnapshot& snapshot) {
+        elapsed = snapshot.elapsed;
+        performedOnce = snapshot.performedOnce;
+    }
+
 protected:
     Actor& actor;               /**< Non-owning reference to the actor target. */
     float duration;             /**< Seconds; 0 means infinite. */
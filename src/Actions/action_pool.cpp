@@ -0,0 +1,51 @@
+#include "action_pool.h"
+#include <new>
+
+ActionPool& ActionPool::Instance() {
+    static ActionPool instance;
+    return instance;
+}
+
+void ActionPool::AddChunk() {
+    auto chunk = std::make_unique<Block[]>(CHUNK_BLOCKS);
+    // thread the new blocks onto the free list
+    for (std::size_t i = 0; i < CHUNK_BLOCKS; ++i) {
+        chunk[i].next = freeList;
+        freeList = &chunk[i];
+    }
+    chunks.push_back(std::move(chunk));
+}
+
+void ActionPool::Reserve(std::size_t blockCount) {
+    std::lock_guard<std::mutex> lock(mutex);
+    while (GetCapacity() - blocksInUse < blockCount) {
+        AddChunk();
+    }
+}
+
+void* ActionPool::Allocate(std::size_t size) {
+    if (size > BLOCK_SIZE) {
+        return ::operator new(size);
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    if (freeList == nullptr) {
+        AddChunk();
+    }
+    Block* block = freeList;
+    freeList = block->next;
+    ++blocksInUse;
+    return block;
+}
+
+void ActionPool::Release(void* block, std::size_t size) noexcept {
+    if (block == nullptr) return;
+    if (size > BLOCK_SIZE) {
+        ::operator delete(block);
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    auto* freed = static_cast<Block*>(block);
+    freed->next = freeList;
+    freeList = freed;
+    --blocksInUse;
+}
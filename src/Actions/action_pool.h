@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Fixed-size block allocator backing `Action::operator new`.
+ *
+ * Actions are created and destroyed constantly during gameplay (every key press,
+ * every patrol turn). The pool hands out blocks from a free list carved out of
+ * preallocated chunks, so registering an action does not touch the heap once the
+ * pool is warm. Requests larger than `BLOCK_SIZE` fall back to the global heap.
+ *
+ * Guarded by a mutex: parallel actor update jobs create actions on worker threads.
+ */
+class ActionPool {
+public:
+    static constexpr std::size_t BLOCK_SIZE = 64;   /**< Bytes per block; concrete actions must fit. */
+    static constexpr std::size_t CHUNK_BLOCKS = 64; /**< Blocks added whenever the pool runs dry. */
+
+    static ActionPool& Instance();
+
+    /**
+     * @brief Allocate storage for an action of the given size.
+     */
+    void* Allocate(std::size_t size);
+
+    /**
+     * @brief Return storage obtained from Allocate (size must match the request).
+     */
+    void Release(void* block, std::size_t size) noexcept;
+
+    /**
+     * @brief Make sure at least blockCount blocks are available without further allocation.
+     */
+    void Reserve(std::size_t blockCount);
+
+    /** Blocks currently handed out. */
+    std::size_t GetBlocksInUse() const noexcept { return blocksInUse; }
+
+    /** Blocks owned by the pool (in use and free). */
+    std::size_t GetCapacity() const noexcept { return chunks.size() * CHUNK_BLOCKS; }
+
+private:
+    ActionPool() = default;
+    ActionPool(const ActionPool&) = delete;
+    ActionPool& operator=(const ActionPool&) = delete;
+
+    union Block {
+        Block* next;
+        alignas(std::max_align_t) std::byte storage[BLOCK_SIZE];
+    };
+
+    void AddChunk();
+
+    std::vector<std::unique_ptr<Block[]>> chunks;
+    Block* freeList = nullptr;
+    std::size_t blocksInUse = 0;
+    std::mutex mutex;
+};
@@ -23,4 +23,10 @@ void Jump::OnPerform(float delta) {
     // Compute effective jump force and invoke the jump implementation.
     const float jumpForce = (customJumpStrength > 0.0f) ? customJumpStrength : jumpable->GetJumpStrength();
     jumpable->DoJump(jumpForce);
+}
+
+void Jump::SaveSnapshot(ActionSnapshot& snapshot) const {
+    Action::SaveSnapshot(snapshot);
+    snapshot.kind = ActionSnapshot::Kind::Jump;
+    snapshot.param = customJumpStrength;
 }
\ No newline at end of file
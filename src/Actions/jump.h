@@ -29,6 +29,13 @@ public:
      */
     void OnPerform(float delta) override;
 
+    /**
+     * @brief Capture the jump strength override in addition to timing.
+     */
+    void SaveSnapshot(ActionSnapshot& snapshot) const override;
+
 private:
     float customJumpStrength; /**< Optional override for jump strength. */
-};
\ No newline at end of file
+};
+
+static_assert(sizeof(Jump) <= ActionPool::BLOCK_SIZE, "Jump must fit an ActionPool block");
\ No newline at end of file
@@ -33,6 +33,13 @@ void Move::OnPerform(float delta) {
     }
 }
 
+void Move::SaveSnapshot(ActionSnapshot& snapshot) const {
+    Action::SaveSnapshot(snapshot);
+    snapshot.kind = ActionSnapshot::Kind::Move;
+    snapshot.direction = moveDir;
+    snapshot.param = customSpeed;
+}
+
 /**
  * @brief Destructor ensures velocity is reset when action is destroyed.
  */
@@ -31,7 +31,14 @@ public:
      */
     void OnPerform(float delta) override;
 
+    /**
+     * @brief Capture direction and speed override in addition to timing.
+     */
+    void SaveSnapshot(ActionSnapshot& snapshot) const override;
+
 private:
     const GameTypes::Direction moveDir; /**< Direction of motion. */
     float customSpeed;                  /**< Optional speed override. */
 };
+
+static_assert(sizeof(Move) <= ActionPool::BLOCK_SIZE, "Move must fit an ActionPool block");
@@ -2,7 +2,7 @@
 #include "config.hpp"
 
 void Jumpable::DoJump(float jumpStrength) {
-    velocity.y = -jumpStrength;
+    SetVelocityY(-jumpStrength);
     SetMovementState(Movable::MovementState::Jumping);
     if (!isGrounded) {
         doubleJumpDone = true;
@@ -18,10 +18,10 @@ void Jumpable::Update(float delta) {
         doubleJumpDone = false;  // reset jump state when grounded
     }
 
-    if (GetPreviousMovementState() != Movable::MovementState::Jumping &&
-        GetMovementState() == Movable::MovementState::Jumping) {
-        if (jumpingAnimation) {
-            self.SetCurrentAnimation(jumpingAnimation);
-        }
+    // compare against the played clip rather than the previous movement state, so the jump
+    // is still noticed when this runs at a lower tick rate than the movement update
+    if (GetMovementState() == Movable::MovementState::Jumping && jumpingClip != NO_ANIMATION_CLIP &&
+        self.GetCurrentAnimation() != jumpingClip) {
+        self.SetCurrentAnimation(jumpingClip);
     }
 }
\ No newline at end of file
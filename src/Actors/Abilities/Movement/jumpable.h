@@ -3,9 +3,7 @@
 #include "types.h"
 #include "movable.h"
 #include "action.h"
-#include "animation2d.h"
-#include "ianimation2d.h"
-#include <memory>
+#include "animation_clip.h"
 
 /**
  * @brief Ability mixin enabling jump behavior for an Actor.
@@ -28,7 +26,9 @@ public:
      * @param jumpingAnim Animation data for jump state.
      */
     Jumpable(float jumpStrength, GameTypes::AnimationData jumpingAnim)
-        : Movable(*this), jumpStrength(jumpStrength), jumpingAnimation(std::make_shared<Animation2D>(jumpingAnim)) {}
+        : Movable(*this),
+          jumpStrength(jumpStrength),
+          jumpingClip(AnimationClipLibrary::Instance().GetClip(jumpingAnim)) {}
 
     /**
      * @brief Virtual destructor.
@@ -71,9 +71,19 @@ public:
      */
     void Update(float delta);
 
+    /**
+     * @brief Store double-jump tracking into a snapshot record.
+     */
+    void SaveJump(ActorSnapshot& snapshot) const { snapshot.doubleJumpDone = doubleJumpDone; }
+
+    /**
+     * @brief Restore double-jump tracking.
+     */
+    void RestoreJump(const ActorSnapshot& snapshot) { doubleJumpDone = snapshot.doubleJumpDone; }
+
 protected:
 private:
     float jumpStrength;                             /**< Jump impulse strength. */
     bool doubleJumpDone = false;                    /**< Tracks if the double jump has been performed */
-    std::shared_ptr<IAnimation2D> jumpingAnimation; /**< Optional jumping animation; falls back to defaultAnimation */
+    AnimationClipId jumpingClip = NO_ANIMATION_CLIP; /**< Optional jumping animation; falls back to the default */
 };
\ No newline at end of file
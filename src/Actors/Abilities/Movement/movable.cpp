@@ -4,15 +4,20 @@
 #include <algorithm>
 
 /**
- * @brief Move the owning actor by the specified delta and clamp to map bounds.
+ * @brief Move the owning actor by the specified delta, clamped to map bounds and stopped by solid tiles.
  *
  * @param dx Horizontal world delta.
  * @param dy Vertical world delta.
  */
 void Movable::MoveBy(float dx, float dy) {
+    if constexpr (MoveConfig::FIXED_POINT_PHYSICS) {
+        MoveByFixed({Fixed::FromFloat(dx), Fixed::FromFloat(dy)});
+        return;
+    }
     TmxMap* map = self.GetGameLevel().GetMap();
 
-    Vector2 position = self.GetPosition();
+    const Vector2 start = self.GetPosition();
+    Vector2 position = start;
     Rectangle rect = self.GetRect();
     position.x += dx;
     position.y += dy;
@@ -28,31 +33,149 @@ void Movable::MoveBy(float dx, float dy) {
         position.y = map->height * map->tileHeight - rect.height;
         velocity.y = 0;  // reset vertical velocity when clamped to bottom
     }
-    self.SetPosition(position.x, position.y);
+    const Vector2 moved = SweepAgainstTiles({position.x - start.x, position.y - start.y});
+    self.SetPosition(start.x + moved.x, start.y + moved.y);
+}
+
+void Movable::MoveByFixed(FixedVec2 motion) {
+    TmxMap* map = self.GetGameLevel().GetMap();
+
+    const FixedVec2 start = GetBodyPosition();
+    FixedVec2 position = start + motion;
+    const Rectangle rect = self.GetRect();
+
+    // clip the position to the map bounds (integer pixels)
+    const Fixed maxX = Fixed::FromInt(map->width * map->tileWidth) - Fixed::FromFloat(rect.width);
+    const Fixed maxY = Fixed::FromInt(map->height * map->tileHeight) - Fixed::FromFloat(rect.height);
+    position.x = std::clamp(position.x, Fixed{}, maxX);
+    if (position.y > maxY) {
+        position.y = maxY;
+        SetFixedVelocityY(Fixed{});  // reset vertical velocity when clamped to bottom
+    }
+
+    // the tiles are swept in float; an axis nothing stopped keeps its exact fixed-point target
+    const Vector2 wanted = (position - start).ToVector2();
+    const Vector2 moved = SweepAgainstTiles(wanted);
+    if (moved.x != wanted.x) position.x = start.x + Fixed::FromFloat(moved.x);
+    if (moved.y != wanted.y) position.y = start.y + Fixed::FromFloat(moved.y);
+    SetBodyPosition(position);
+}
+
+FixedVec2 Movable::GetBodyPosition() noexcept {
+    const Vector2& position = self.GetPosition();
+    if (position.x != publishedPosition.x || position.y != publishedPosition.y) {
+        bodyPosition = FixedVec2::FromVector2(position);
+        publishedPosition = position;
+    }
+    return bodyPosition;
+}
+
+void Movable::SetBodyPosition(FixedVec2 position) noexcept {
+    bodyPosition = position;
+    publishedPosition = position.ToVector2();
+    self.SetPosition(publishedPosition);
+}
+
+/**
+ * @brief Resolve a displacement against the ground layer, horizontal axis first.
+ *
+ * Horizontal motion stops at walls. The bottom of the swept box is raised by the vertical
+ * snap tolerance so that resting on the floor (the ground snap overlaps it by a pixel) and
+ * small steps do not block walking. Vertical motion is only blocked downwards: tiles act as
+ * one-way platforms that can be jumped through from below, as the foot sensor always did.
+ */
+Vector2 Movable::SweepAgainstTiles(Vector2 motion) {
+    const TileCollisionGrid& grid = self.GetGameLevel().GetCollisionGrid();
+    Rectangle body = self.GetRect();
+    TileSweepHit hit;
+
+    if (motion.x != 0.0f) {
+        wallSide = 0;
+        const float stepTolerance =
+            std::min(static_cast<float>(MoveConfig::VERTICAL_SNAP_TOLERANCE), body.height * 0.5f);
+        const Rectangle swept{body.x, body.y, body.width, body.height - stepTolerance};
+        if (grid.SweepBox(swept, {motion.x, 0.0f}, hit) && hit.normal.x != 0.0f) {
+            motion.x *= hit.time;
+            wallSide = hit.normal.x > 0.0f ? -1 : 1;
+        }
+        body.x += motion.x;
+    }
+    if (motion.y > 0.0f && grid.SweepBox(body, {0.0f, motion.y}, hit) && hit.normal.y < 0.0f) {
+        // landed on top of a shape; the foot sensor grounds and snaps the actor next update
+        motion.y *= hit.time;
+        SetVelocityY(0.0f);
+    }
+    return motion;
 }
 
 /**
  * @brief Update movable physics each frame: ground checks, gravity and animation selection.
  */
 void Movable::Update(float delta) {
+    UpdateGrounding(delta);
+    Integrate(delta);
+}
+
+void Movable::UpdateGrounding(float delta) {
+    if (!self.IsAlive()) return;
+    // Update grounded state via foot sensor hysteresis after physics integration
+    UpdateGroundedState(delta);
+}
+
+void Movable::Integrate(float delta) {
+    if constexpr (MoveConfig::FIXED_POINT_PHYSICS) {
+        Fixed velocityY = fixedVelocityY;
+        Fixed displacementY;
+        const std::uint32_t gravityMask = GetGravityMask();
+        const Fixed step = std::min(Fixed::FromFloat(delta), BodyIntegrator::MAX_FIXED_STEP);
+        BodyIntegrator::IntegrateFixedScalar(&velocityY.raw, &displacementY.raw, &gravityMask, 1, step);
+        FinishIntegration(velocityY, displacementY);
+        return;
+    }
+    float velocityY = velocity.y;
+    float displacementY = 0.0f;
+    const std::uint32_t gravityMask = GetGravityMask();
+    BodyIntegrator::IntegrateScalar(&velocityY, &displacementY, &gravityMask, 1, delta);
+    FinishIntegration(velocityY, displacementY);
+}
+
+void Movable::FinishIntegration(float velocityY, float displacementY) {
     if (!self.IsAlive()) {
         // set velocity to 0
         velocity.x = 0;
         velocity.y = 0;
         return;
     }
-    // Update grounded state via foot sensor hysteresis after physics integration
-    UpdateGroundedState(delta);
 
-    // apply gravity if not grounded or if currently in jumping movement state
-    if (!isGrounded || movementState == MovementState::Jumping) {
-        velocity.y += MoveConfig::GRAVITY_CONSTANT * delta;  // gravity constant
-        // Update vertical position
-        self.SetPosition(self.GetPosition().x, self.GetPosition().y + (velocity.y * delta));
-    } else {
-        velocity.y = 0;  // reset vertical velocity when grounded
+    // gravity was applied if not grounded or if currently in jumping movement state (zero velocity otherwise)
+    velocity.y = velocityY;
+    if (displacementY != 0.0f) {
+        // Update vertical position, landing on platforms crossed during the step
+        const Vector2 moved = SweepAgainstTiles({0.0f, displacementY});
+        self.SetPosition(self.GetPosition().x, self.GetPosition().y + moved.y);
     }
+    ResolveMovementState();
+}
 
+void Movable::FinishIntegration(Fixed velocityY, Fixed displacementY) {
+    if (!self.IsAlive()) {
+        velocity.x = 0;
+        SetFixedVelocityY(Fixed{});
+        return;
+    }
+
+    SetFixedVelocityY(velocityY);
+    if (displacementY != Fixed{}) {
+        // vertical move without the map clamp (falling out of the map kills); exact unless a platform stopped it
+        const FixedVec2 start = GetBodyPosition();
+        const float wanted = displacementY.ToFloat();
+        const Vector2 moved = SweepAgainstTiles({0.0f, wanted});
+        SetBodyPosition({start.x, start.y + (moved.y == wanted ? displacementY : Fixed::FromFloat(moved.y))});
+    }
+    ResolveMovementState();
+}
+
+void Movable::ResolveMovementState() {
     // resolve facing direction
     if (velocity.x < 0) {
         self.SetFacingDirection(GameTypes::Direction::Left);
@@ -73,12 +196,13 @@ void Movable::Update(float delta) {
         self.ResetToDefaultAnimation();
     }
 
-    if (prevMovementState != MovementState::Falling && fallingAnimation && movementState == MovementState::Falling) {
-        self.SetCurrentAnimation(fallingAnimation);
+    if (prevMovementState != MovementState::Falling && fallingClip != NO_ANIMATION_CLIP &&
+        movementState == MovementState::Falling) {
+        self.SetCurrentAnimation(fallingClip);
     } else if ((prevMovementState != MovementState::MovingLeft && prevMovementState != MovementState::MovingRight) &&
-               movingAnimation &&
+               movingClip != NO_ANIMATION_CLIP &&
                (movementState == MovementState::MovingLeft || movementState == MovementState::MovingRight)) {
-        self.SetCurrentAnimation(movingAnimation);
+        self.SetCurrentAnimation(movingClip);
     }
 
     // Death by falling out of the map bottom
@@ -89,6 +213,30 @@ void Movable::Update(float delta) {
     prevMovementState = movementState;
 }
 
+void Movable::SaveMovement(ActorSnapshot& snapshot) const {
+    snapshot.velocity = velocity;
+    snapshot.grounded = isGrounded;
+    snapshot.groundTimer = timeSinceLastGround;
+    snapshot.movementState = static_cast<std::uint8_t>(movementState);
+    snapshot.prevMovementState = static_cast<std::uint8_t>(prevMovementState);
+    snapshot.wallSide = wallSide;
+    snapshot.bodyPosition = {bodyPosition.x.raw, bodyPosition.y.raw};
+    snapshot.bodyVelocityY = fixedVelocityY.raw;
+}
+
+void Movable::RestoreMovement(const ActorSnapshot& snapshot) {
+    velocity = snapshot.velocity;
+    isGrounded = snapshot.grounded;
+    timeSinceLastGround = snapshot.groundTimer;
+    movementState = static_cast<MovementState>(snapshot.movementState);
+    prevMovementState = static_cast<MovementState>(snapshot.prevMovementState);
+    wallSide = snapshot.wallSide;
+    bodyPosition = {Fixed::FromRaw(snapshot.bodyPosition[0]), Fixed::FromRaw(snapshot.bodyPosition[1])};
+    publishedPosition = snapshot.position;
+    fixedVelocityY = Fixed::FromRaw(snapshot.bodyVelocityY);
+    activeMoveAction = nullptr;
+}
+
 /**
  * @brief Query whether the ground layer contains a tile at given world coordinates.
  *
@@ -121,46 +269,33 @@ bool Movable::HasGroundTileAt(float worldX, float worldY) const {
  */
 void Movable::UpdateGroundedState(float delta) {
     bool groundedNow = false;
-    TmxMap* map = self.GetGameLevel().GetMap();
-    const TmxLayer* ground = self.GetGameLevel().GetCachedGroundLayer();
-
-    if (map != nullptr && ground != nullptr) {
-        Rectangle body = self.GetRect();
+    const TileCollisionGrid& grid = self.GetGameLevel().GetCollisionGrid();
 
-        // calculate sensor dimensions and create rectangle
-        float sensorWidth = body.width * MoveConfig::FOOT_SENSOR_WIDTH_RATIO;
+    Rectangle body = self.GetRect();
 
-        // Clamp sensor width to reasonable range
-        sensorWidth = std::clamp(sensorWidth, body.width * MoveConfig::FOOT_SENSOR_MIN_WIDTH_RATIO, body.width);
+    // calculate sensor dimensions and create rectangle
+    float sensorWidth = body.width * MoveConfig::FOOT_SENSOR_WIDTH_RATIO;
 
-        Rectangle sensor{body.x + ((body.width - sensorWidth) * 0.5f),
-                         body.y + body.height + MoveConfig::FOOT_SENSOR_GAP, sensorWidth,
-                         MoveConfig::FOOT_SENSOR_HEIGHT};
+    // Clamp sensor width to reasonable range
+    sensorWidth = std::clamp(sensorWidth, body.width * MoveConfig::FOOT_SENSOR_MIN_WIDTH_RATIO, body.width);
 
-        uint32_t hitCount = 0;
-        TmxObject* collisionObjects = CheckCollisionTMXTileLayersRecAllAlloc(map, ground, 1, sensor, &hitCount);
-
-        // in case of no hits nothing to do, make sure to free memory
-        if (hitCount == 0 || collisionObjects == NULL) {
-            if (collisionObjects != NULL) {
-                MemFree(collisionObjects);
-            }
-        } else {
-            groundedNow = true;
-            // go through all hits and find the highest top
-            float highestCollisionTop = collisionObjects[0].y;  // take the first hit to start with
-            for (uint32_t i = 1; i < hitCount; i++) {
-                if (collisionObjects[i].y < highestCollisionTop) {
-                    highestCollisionTop = collisionObjects[i].y;
-                }
-            }
+    Rectangle sensor{body.x + ((body.width - sensorWidth) * 0.5f),
+                     body.y + body.height + MoveConfig::FOOT_SENSOR_GAP, sensorWidth,
+                     MoveConfig::FOOT_SENSOR_HEIGHT};
 
-            // we don't need the collision objects anymore
-            MemFree(collisionObjects);
+    // find the highest ground shape under the sensor (baked per tile, no allocation)
+    float highestCollisionTop = 0.0f;
+    if (grid.FindHighestTop(sensor, highestCollisionTop)) {
+        groundedNow = true;
 
-            // If grounded and moving downward (or resting), snap actor to stand on the highest
-            // ground tile
-            if (velocity.y >= 0.0f) {
+        // If grounded and moving downward (or resting), snap actor to stand on the highest
+        // ground tile
+        if (velocity.y >= 0.0f) {
+            if constexpr (MoveConfig::FIXED_POINT_PHYSICS) {
+                const Fixed top = Fixed::FromFloat(highestCollisionTop);
+                SetBodyPosition({GetBodyPosition().x, top - Fixed::FromFloat(body.height) + Fixed::FromInt(1)});
+                SetFixedVelocityY(Fixed{});
+            } else {
                 self.SetPosition(self.GetPosition().x, highestCollisionTop - body.height + 1);
                 velocity.y = 0.0f;
             }
@@ -4,7 +4,10 @@
 #include "actor.h"
 #include "action.h"
 #include "raylib.h"
-#include "ianimation2d.h"
+#include "animation_clip.h"
+#include "body_integrator.h"
+#include "config.hpp"
+#include "fixed_point.h"
 
 /**
  * @brief Ability mixin adding movement and basic physics to an Actor.
@@ -12,6 +15,12 @@
  * Movable provides velocity, gravity handling, ground-snapping and optional
  * animations for moving/falling. It is designed as a mixin and holds a
  * non-owning reference to the `Actor` it augments.
+ *
+ * With MoveConfig::FIXED_POINT_PHYSICS the body keeps its position and vertical velocity
+ * in 16.16 fixed point: integration, moves and ground snapping are integer math and the
+ * actor's float position is only written from the fixed-point one (for rendering and
+ * the code that reads positions as floats). A position changed from outside (spawn,
+ * patrol walk, restore) is picked up the next time the body moves.
  */
 class Movable /* : public Actor */ {
 public:
@@ -37,15 +46,15 @@ public:
           velocity{0, 0},
           moveSpeed(moveSpeed),
           isGrounded(false),
-          movingAnimation(std::make_shared<Animation2D>(moveAnim)) {}
+          movingClip(AnimationClipLibrary::Instance().GetClip(moveAnim)) {}
 
     Movable(Actor& self, GameTypes::AnimationData moveAnim, GameTypes::AnimationData fallAnim, float moveSpeed = 0.0f)
         : self(self),
           velocity{0, 0},
           moveSpeed(moveSpeed),
           isGrounded(false),
-          movingAnimation(std::make_shared<Animation2D>(moveAnim)),
-          fallingAnimation(std::make_shared<Animation2D>(fallAnim)) {}
+          movingClip(AnimationClipLibrary::Instance().GetClip(moveAnim)),
+          fallingClip(AnimationClipLibrary::Instance().GetClip(fallAnim)) {}
 
     /**
      * @brief Virtual destructor.
@@ -65,7 +74,15 @@ public:
     /**
      * @brief Set vertical velocity component.
      */
-    void SetVelocityY(float vy) { velocity.y = vy; }
+    void SetVelocityY(float vy) {
+        velocity.y = vy;
+        if constexpr (MoveConfig::FIXED_POINT_PHYSICS) fixedVelocityY = Fixed::FromFloat(vy);
+    }
+
+    /**
+     * @brief Vertical velocity in fixed point (kept in sync with the float one in fixed-point mode).
+     */
+    Fixed GetFixedVelocityY() const noexcept { return fixedVelocityY; }
 
     /**
      * @brief Get configured horizontal move speed.
@@ -99,29 +116,94 @@ public:
     bool IsMovingRight() const { return velocity.x > 0; }
 
     /**
-     * @brief Set a separate moving animation instance (takes ownership).
-     *
-     * @param anim Unique pointer to an Animation2D instance.
+     * @brief Set a separate moving animation clip (NO_ANIMATION_CLIP to use the default).
      */
-    void SetMovingAnimation(std::unique_ptr<Animation2D> anim) { movingAnimation = std::move(anim); }
+    void SetMovingAnimation(AnimationClipId clip) noexcept { movingClip = clip; }
 
     /**
-     * @brief Set a separate falling animation instance (takes ownership).
-     *
-     * @param anim Unique pointer to an Animation2D instance.
+     * @brief Set a separate falling animation clip (NO_ANIMATION_CLIP to use the default).
      */
-    void SetFallingAnimation(std::unique_ptr<Animation2D> anim) { fallingAnimation = std::move(anim); }
+    void SetFallingAnimation(AnimationClipId clip) noexcept { fallingClip = clip; }
 
     /**
      * @brief Move the actor by the given delta in world units.
      *
+     * The motion is clamped to the map and swept against the ground layer's collision
+     * shapes, so the actor stops at walls and lands on platforms instead of passing
+     * through them, however large the delta.
+     *
      * @param dx Horizontal delta.
      * @param dy Vertical delta.
      */
     void MoveBy(float dx, float dy);
 
+    /**
+     * @brief Whether the last horizontal move was stopped by a wall on the given side.
+     */
+    bool IsBlockedTowards(GameTypes::Direction side) const noexcept {
+        return wallSide == (side == GameTypes::Direction::Left ? -1 : 1);
+    }
+
+    /**
+     * @brief Full per-frame movement update: UpdateGrounding followed by Integrate.
+     */
     void Update(float delta);
 
+    /**
+     * @brief Update grounded state and snap to the ground (first half of Update).
+     */
+    void UpdateGrounding(float delta);
+
+    /**
+     * @brief Apply gravity, resolve facing/movement state and animations (second half of Update).
+     *
+     * Runs the scalar BodyIntegrator kernel on this body followed by FinishIntegration; the
+     * level runs the same steps batched for all of its bodies.
+     */
+    void Integrate(float delta);
+
+    /**
+     * @brief Gravity mask for the next integration (BodyIntegrator::GRAVITY_ON while airborne or jumping).
+     */
+    std::uint32_t GetGravityMask() const noexcept {
+        return (!isGrounded || movementState == MovementState::Jumping) ? BodyIntegrator::GRAVITY_ON : 0u;
+    }
+
+    /**
+     * @brief Apply an integrated velocity and displacement: sweep against tiles, update movement state.
+     *
+     * @param velocityY Vertical velocity computed by the integrator.
+     * @param displacementY Vertical displacement computed by the integrator.
+     */
+    void FinishIntegration(float velocityY, float displacementY);
+
+    /**
+     * @brief Fixed-point counterpart of FinishIntegration (MoveConfig::FIXED_POINT_PHYSICS).
+     */
+    void FinishIntegration(Fixed velocityY, Fixed displacementY);
+
+    /**
+     * @brief Store velocity, grounding and movement state into a snapshot record.
+     */
+    void SaveMovement(ActorSnapshot& snapshot) const;
+
+    /**
+     * @brief Currently active Move action (non-owning), if any.
+     */
+    Action* GetActiveMoveAction() const noexcept { return activeMoveAction; }
+
+    /**
+     * @brief Bind an already registered Move action as the active one (used when restoring state).
+     */
+    void SetActiveMoveAction(Action* action) noexcept { activeMoveAction = action; }
+
+    /**
+     * @brief Restore movement state from a snapshot record.
+     *
+     * The active move action is forgotten (actions are owned and cleared by GameLogic).
+     */
+    void RestoreMovement(const ActorSnapshot& snapshot);
+
 protected:
     Vector2 velocity{0, 0};
     bool isGrounded = false;
@@ -134,12 +216,35 @@ protected:
 private:
     Vector2 prevPosition;
     float moveSpeed;
-    std::shared_ptr<IAnimation2D> movingAnimation;  /**< Optional moving animation; falls back to defaultAnimation */
-    std::shared_ptr<IAnimation2D> fallingAnimation; /**< Optional falling animation; falls back to defaultAnimation */
+    AnimationClipId movingClip = NO_ANIMATION_CLIP;  /**< Optional moving animation; falls back to the default */
+    AnimationClipId fallingClip = NO_ANIMATION_CLIP; /**< Optional falling animation; falls back to the default */
     float timeSinceLastGround = 0.0f;
     MovementState movementState = MovementState::Idle;
     MovementState prevMovementState = MovementState::Idle;
 
+    std::int8_t wallSide = 0; /**< Wall hit by the last horizontal move: -1 left, 1 right, 0 none. */
+
+    // Fixed-point physics state (MoveConfig::FIXED_POINT_PHYSICS)
+    Fixed fixedVelocityY;
+    FixedVec2 bodyPosition;          /**< Authoritative position. */
+    Vector2 publishedPosition{0, 0}; /**< Actor position last written from bodyPosition. */
+
+    // Fixed-point position, re-read from the actor when it was moved from outside the physics
+    FixedVec2 GetBodyPosition() noexcept;
+    // Store the fixed-point position and publish it to the actor
+    void SetBodyPosition(FixedVec2 position) noexcept;
+    // Set the vertical velocity from fixed point, keeping the float copy in sync
+    void SetFixedVelocityY(Fixed vy) noexcept {
+        fixedVelocityY = vy;
+        velocity.y = vy.ToFloat();
+    }
+    // Fixed-point MoveBy: integer clamp, float tile sweep, exact position where nothing was hit
+    void MoveByFixed(FixedVec2 motion);
+    // Facing, movement state, animation and fall death after a vertical integration step
+    void ResolveMovementState();
+
     // Update grounded state using a narrow foot sensor and grace time
     void UpdateGroundedState(float delta);
+    // Sweep a displacement against the tile grid (axis-separated) and return the part that can be travelled
+    Vector2 SweepAgainstTiles(Vector2 motion);
 };
@@ -1,25 +1,60 @@
 #include "patrolable.h"
-#include "gamelogic.h"
+#include "gamelevel.h"
 #include "move.h"
+#include "jump.h"
+#include <cmath>
+
+Patrolable::Patrolable(std::uint32_t seed)
+    : Movable(*this), rng(seed), patrolSlot(self.GetGameLevel().GetPatrols().Add(self, *this)) {}
+
+Patrolable::~Patrolable() {
+    self.GetGameLevel().GetPatrols().Remove(patrolSlot);
+}
 
 /**
  * @brief Per-frame update for simple patrol AI.
  *
- * Handles falling-to-ground, waiting at edges and registering Move actions
- * when moving between edges.
+ * Handles falling-to-ground, chasing a visible player, searching where it was last seen,
+ * waiting at span ends and registering Move actions when moving between them.
  */
 void Patrolable::Update(float delta) {
     // If still falling until ground contact, check grounded flag set by Movable::Update
     if (state == PatrolState::FallingToGround) {
         if (IsGrounded()) {
             // choose initial random direction
-            std::uniform_int_distribution<int> dist(0, 1);
-            patrolDir = (dist(rng) == 0) ? GameTypes::Direction::Left : GameTypes::Direction::Right;
+            patrolDir = (rng.NextBelow(2) == 0) ? GameTypes::Direction::Left : GameTypes::Direction::Right;
             state = PatrolState::Moving;
         }
         return;
     }
 
+    // A visible player overrides everything else; losing sight sends the actor to where it was last seen
+    if (CanSeePlayer()) {
+        if (state != PatrolState::Chasing) {
+            StopBatchedPatrol();
+            StopMoving();
+            state = PatrolState::Chasing;
+            navTarget = NAV_NONE;
+        }
+    } else if (state == PatrolState::Chasing) {
+        StopMoving();
+        // the flow field was leading to the span of the nearest player
+        const std::int32_t span = FindCurrentSpan();
+        navTarget = span != NAV_NONE ? self.GetGameLevel().GetNavGraph().GetFlowTarget(static_cast<std::uint32_t>(span))
+                                     : NAV_NONE;
+        state = (navTarget != NAV_NONE) ? PatrolState::Searching : PatrolState::Moving;
+    }
+
+    if (state == PatrolState::Chasing || state == PatrolState::Searching) {
+        FollowRoute();
+        return;
+    }
+
+    // the batch walks, waits and turns the actor until something above takes it out again
+    if (self.GetGameLevel().GetPatrols().IsActive(patrolSlot)) {
+        return;
+    }
+
     if (state == PatrolState::Waiting) {
         waitTimer -= delta;
         if (waitTimer <= 0.0f) {
@@ -31,44 +66,257 @@ void Patrolable::Update(float delta) {
         return;
     }
 
-    // Determine position to check: one tile ahead at the actor's feet
-    Rectangle rect = self.GetRect();
-    float footY = self.GetPosition().y + rect.height + 1.0f;  // just below feet
-    float aheadX = (patrolDir == GameTypes::Direction::Left) ? (self.GetPosition().x - 1.0f)
-                                                             : (self.GetPosition().x + rect.width + 1.0f);
+    if (StartBatchedPatrol()) {
+        return;
+    }
 
-    // check if tile under the ahead position exists; if not, stop and wait
-    if (!HasGroundTileAt(aheadX, footY)) {
-        // reached edge: stop and schedule wait
+    // off the graph: stop and wait before turning when no ground lies ahead or a wall blocks the way
+    if (AtPatrolBound(FindCurrentSpan(), patrolDir) || IsBlockedTowards(patrolDir)) {
+        StopMoving();
         state = PatrolState::Waiting;
-        waitTimer = 0.6f;  // pause before turning
-        // deregister move action if active
-        if (activeMoveAction) {
-            GameLogic::Instance().DeregisterAction(activeMoveAction);
-            activeMoveAction = nullptr;
-        }
+        waitTimer = EnemyConfig::PATROL_WAIT_TIME;
         return;
     }
 
-    if (state == PatrolState::Moving) {
-        // Register move action for new direction
-        if (!activeMoveAction) {
-            auto act = std::make_unique<Move>(self, patrolDir);
-            Action* raw = act.get();
-            GameLogic::Instance().RegisterAction(std::move(act));
-            activeMoveAction = raw;
+    // Register move action for the current direction
+    if (!activeMoveAction) {
+        StartMoving(0.0f);
+    }
+}
+
+bool Patrolable::CanSeePlayer() const {
+    const GameLevel& level = self.GetGameLevel();
+    // look from the upper part of the body towards the centre of each living player
+    const Rectangle body = self.GetRect();
+    const Vector2 eye{body.x + body.width * 0.5f, body.y + body.height * 0.25f};
+    for (std::size_t i = 0; i < PlayerConfig::MAX_PLAYERS; ++i) {
+        const Player* player = level.GetPlayer(i);
+        if (player == nullptr || !player->IsAlive()) continue;
+        const Rectangle target = player->GetRect();
+        const Vector2 targetCentre{target.x + target.width * 0.5f, target.y + target.height * 0.5f};
+        if (std::fabs(targetCentre.x - eye.x) > EnemyConfig::SIGHT_RANGE ||
+            std::fabs(targetCentre.y - eye.y) > EnemyConfig::SIGHT_RANGE) {
+            continue;
+        }
+        if (level.GetLineOfSight().HasLineOfSight(eye, targetCentre)) return true;
+    }
+    return false;
+}
+
+const Player* Patrolable::FindNearestPlayer() const {
+    const GameLevel& level = self.GetGameLevel();
+    const Rectangle body = self.GetRect();
+    const Vector2 centre{body.x + body.width * 0.5f, body.y + body.height * 0.5f};
+    const Player* nearest = nullptr;
+    float nearestDistance = 0.0f;
+    // strict comparison: equally distant players resolve to the lower slot
+    for (std::size_t i = 0; i < PlayerConfig::MAX_PLAYERS; ++i) {
+        const Player* player = level.GetPlayer(i);
+        if (player == nullptr || !player->IsAlive()) continue;
+        const Rectangle target = player->GetRect();
+        const float dx = target.x + target.width * 0.5f - centre.x;
+        const float dy = target.y + target.height * 0.5f - centre.y;
+        const float distance = dx * dx + dy * dy;
+        if (nearest == nullptr || distance < nearestDistance) {
+            nearest = player;
+            nearestDistance = distance;
+        }
+    }
+    return nearest;
+}
+
+bool Patrolable::StartBatchedPatrol() {
+    const std::int32_t span = FindCurrentSpan();
+    if (span == NAV_NONE) return false;
+    const NavSpan& bounds = self.GetGameLevel().GetNavGraph().GetSpan(static_cast<std::uint32_t>(span));
+    // convert the span ends from collider to actor position space
+    const Rectangle rect = self.GetRect();
+    const float offsetX = rect.x - self.GetPosition().x;
+    const float minX = bounds.left - offsetX;
+    const float maxX = bounds.right - rect.width - offsetX;
+    if (maxX < minX) return false;  // span narrower than the actor
+
+    StopMoving();
+    const float wait = (state == PatrolState::Waiting) ? waitTimer : 0.0f;
+    self.GetGameLevel().GetPatrols().Start(patrolSlot, minX, maxX, patrolDir, GetMoveSpeed(), wait);
+    return true;
+}
+
+void Patrolable::StopBatchedPatrol() {
+    PatrolSystem& patrols = self.GetGameLevel().GetPatrols();
+    if (!patrols.IsActive(patrolSlot)) return;
+    patrolDir = patrols.GetDirection(patrolSlot);
+    if (patrols.IsWaiting(patrolSlot)) {
+        state = PatrolState::Waiting;
+        waitTimer = patrols.GetWaitTimer(patrolSlot);
+    } else {
+        state = PatrolState::Moving;
+    }
+    patrols.Stop(patrolSlot);
+    SetVelocityX(0.0f);
+}
+
+std::int32_t Patrolable::FindCurrentSpan() const {
+    if (!IsGrounded()) return NAV_NONE;
+    const Rectangle rect = self.GetRect();
+    return self.GetGameLevel().GetNavGraph().FindSpan({rect.x + rect.width * 0.5f, rect.y + rect.height});
+}
+
+bool Patrolable::AtPatrolBound(std::int32_t span, GameTypes::Direction dir) const {
+    const Rectangle rect = self.GetRect();
+    if (span != NAV_NONE) {
+        const NavSpan& bounds = self.GetGameLevel().GetNavGraph().GetSpan(static_cast<std::uint32_t>(span));
+        return (dir == GameTypes::Direction::Left) ? rect.x <= bounds.left : rect.x + rect.width >= bounds.right;
+    }
+    // off the graph: check for a ground tile just ahead of the feet
+    const float footY = rect.y + rect.height + 1.0f;
+    const float aheadX = (dir == GameTypes::Direction::Left) ? rect.x - 1.0f : rect.x + rect.width + 1.0f;
+    return !HasGroundTileAt(aheadX, footY);
+}
+
+/**
+ * @brief Take the next step of the route to the player (Chasing) or its last known span (Searching).
+ *
+ * Chasing reads the level's flow field, which every chaser shares; Searching asks the nav
+ * graph for the cached A* route. Within the target span the actor walks straight at the
+ * player. Drops are taken by walking off the span end; jumps by jumping at the takeoff
+ * column and steering towards the landing column until touching down.
+ */
+void Patrolable::FollowRoute() {
+    // airborne (including a jump that is about to be performed): keep the current move action
+    if (!IsGrounded() || GetMovementState() == MovementState::Jumping) return;
+
+    GameLevel& level = self.GetGameLevel();
+    const NavGraph& nav = level.GetNavGraph();
+    const std::int32_t span = FindCurrentSpan();
+    const Rectangle rect = self.GetRect();
+    const float centreX = rect.x + rect.width * 0.5f;
+
+    std::int32_t edge = NAV_NONE;
+    if (state == PatrolState::Searching) {
+        if (span == navTarget || span == NAV_NONE) {
+            // arrived (or left the graph): give up and patrol from here
+            StopMoving();
+            navTarget = NAV_NONE;
+            state = PatrolState::Moving;
+            return;
+        }
+        edge = nav.FindNextEdge(static_cast<std::uint32_t>(span), static_cast<std::uint32_t>(navTarget));
+        if (edge == NAV_NONE) {
+            StopMoving();
+            navTarget = NAV_NONE;
+            state = PatrolState::Moving;
+            return;
         }
+    } else if (span != NAV_NONE) {
+        edge = nav.GetFlowEdge(static_cast<std::uint32_t>(span));
+    }
+
+    if (edge == NAV_NONE) {
+        // on a player's span (or no route to one): walk at the nearest player without leaving the span
+        const Player* player = FindNearestPlayer();
+        if (player == nullptr) return;
+        const Rectangle target = player->GetRect();
+        SteerTowards(target.x + target.width * 0.5f, span, false);
+        return;
+    }
+
+    const NavEdge& route = nav.GetEdge(static_cast<std::uint32_t>(edge));
+    const float takeoffX = nav.GetCellCentreX(route.takeoffCell);
+    if (route.type == NavEdgeType::Drop) {
+        // the takeoff column lies just past the span end, so walking towards it leads off the edge
+        SteerTowards(takeoffX, span, true);
+        return;
+    }
+
+    if (std::fabs(takeoffX - centreX) > NavConfig::TAKEOFF_TOLERANCE) {
+        SteerTowards(takeoffX, span, false);
+        return;
+    }
+    // at the takeoff column: jump and head for the landing column (straight up when they match)
+    const float landingX = nav.GetCellCentreX(route.landingCell);
+    if (landingX == takeoffX) {
+        StopMoving();
+    } else {
+        Steer(landingX < centreX ? GameTypes::Direction::Left : GameTypes::Direction::Right, EnemyConfig::CHASE_SPEED);
+    }
+    level.GetContext().logic.RegisterAction(std::make_unique<Jump>(self));
+}
+
+void Patrolable::SteerTowards(float targetX, std::int32_t span, bool mayLeaveSpan) {
+    const Rectangle rect = self.GetRect();
+    const float dx = targetX - (rect.x + rect.width * 0.5f);
+    if (!mayLeaveSpan && std::fabs(dx) < EnemyConfig::CHASE_DEAD_ZONE) {
+        StopMoving();
+        return;
+    }
+    const GameTypes::Direction dir = (dx < 0.0f) ? GameTypes::Direction::Left : GameTypes::Direction::Right;
+    if (IsBlockedTowards(dir) || (!mayLeaveSpan && AtPatrolBound(span, dir))) {
+        // stay at the edge facing the target
+        StopMoving();
+        patrolDir = dir;
+        return;
+    }
+    Steer(dir, EnemyConfig::CHASE_SPEED);
+}
+
+void Patrolable::Steer(GameTypes::Direction dir, float speed) {
+    if (activeMoveAction && patrolDir == dir) return;
+    patrolDir = dir;
+    StartMoving(speed);
+}
+
+void Patrolable::StartMoving(float speed) {
+    StopMoving();
+    auto act = std::make_unique<Move>(self, patrolDir, speed);
+    Action* raw = act.get();
+    self.GetGameLevel().GetContext().logic.RegisterAction(std::move(act));
+    activeMoveAction = raw;
+}
+
+void Patrolable::StopMoving() {
+    if (activeMoveAction) {
+        self.GetGameLevel().GetContext().logic.DeregisterAction(activeMoveAction);
+        activeMoveAction = nullptr;
     }
 }
 
 void Patrolable::ReversePatrolDirection() {
+    StopBatchedPatrol();
     patrolDir = (patrolDir == GameTypes::Direction::Left) ? GameTypes::Direction::Right : GameTypes::Direction::Left;
     // If currently moving and have an active move action, deregister so a new one will be added
     // next update
     if (state == PatrolState::Moving) {
-        if (activeMoveAction) {
-            GameLogic::Instance().DeregisterAction(activeMoveAction);
-            activeMoveAction = nullptr;
-        }
+        StopMoving();
+    }
+}
+
+void Patrolable::SavePatrol(ActorSnapshot& snapshot) const {
+    snapshot.patrolState = static_cast<std::uint8_t>(state);
+    snapshot.patrolTimer = waitTimer;
+    snapshot.patrolDirection = patrolDir;
+    snapshot.navTarget = navTarget;
+    snapshot.rngCounter = rng.GetCounter();
+    const PatrolSystem& patrols = self.GetGameLevel().GetPatrols();
+    snapshot.patrolBatched = patrols.IsActive(patrolSlot);
+    if (snapshot.patrolBatched) {
+        // the batch owns direction, timer and moving/waiting while batched
+        const bool waiting = patrols.IsWaiting(patrolSlot);
+        snapshot.patrolState = static_cast<std::uint8_t>(waiting ? PatrolState::Waiting : PatrolState::Moving);
+        snapshot.patrolTimer = waiting ? patrols.GetWaitTimer(patrolSlot) : 0.0f;
+        snapshot.patrolDirection = patrols.GetDirection(patrolSlot);
     }
-}
\ No newline at end of file
+}
+
+void Patrolable::RestorePatrol(const ActorSnapshot& snapshot) {
+    state = static_cast<PatrolState>(snapshot.patrolState);
+    waitTimer = snapshot.patrolTimer;
+    patrolDir = snapshot.patrolDirection;
+    navTarget = snapshot.navTarget;
+    rng.SetCounter(snapshot.rngCounter);
+    // position and grounding are restored first, so the span (and thus the range) is the same
+    self.GetGameLevel().GetPatrols().Stop(patrolSlot);
+    if (snapshot.patrolBatched) {
+        StartBatchedPatrol();
+    }
+}
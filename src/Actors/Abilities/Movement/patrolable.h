@@ -2,23 +2,36 @@
 
 #include "types.h"
 #include "movable.h"
-#include <random>
+#include "nav_graph.h"
+#include "counter_rng.h"
 #include <memory>
 
+class Player;
+
 /**
  * @brief Mixin for simple patrol behaviour.
  *
  * Patrolable allows an actor to fall until it lands, then patrol left/right
- * between edges. It uses the Movable ability for movement and checks ground
- * tiles to determine edges. The class expects `self` to be a Movable/Actor.
+ * between the ends of the nav-graph span it stands on. That walking is handed to the
+ * level's PatrolSystem, which advances all patrolling actors in one batched pass; off
+ * the graph the actor falls back to Move actions, ground tile probes and wall checks. While a living player is within sight range and visible
+ * (cached line of sight over the tile grid) the actor chases the nearest player along the
+ * level's shared flow field, walking, dropping and jumping between spans. When sight is lost
+ * it heads for the span that player was last seen on (cached A* route) before resuming the patrol.
+ * The class expects `self` to be a Movable/Actor; jump edges need it to be Jumpable.
  */
 class Patrolable : virtual public Movable {
 public:
-    enum class PatrolState { FallingToGround, Moving, Waiting };
+    enum class PatrolState { FallingToGround, Moving, Waiting, Chasing, Searching };
 
-    Patrolable() : Movable(*this), rng(std::random_device{}()) {}
+    /**
+     * @brief Construct the patrol mixin and join the level's PatrolSystem.
+     *
+     * @param seed Key of the actor's random stream (see GameLevel::NextActorSeed).
+     */
+    explicit Patrolable(std::uint32_t seed);
 
-    ~Patrolable() override = default;
+    ~Patrolable() override;
 
     /**
      * @brief Update patrol state and schedule/cleanup movement actions.
@@ -27,6 +40,16 @@ public:
      */
     void Update(float delta);
 
+    /**
+     * @brief Store patrol state, wait timer and direction (from the batch while batched) into a snapshot record.
+     */
+    void SavePatrol(ActorSnapshot& snapshot) const;
+
+    /**
+     * @brief Restore patrol state from a snapshot record, re-joining the batch when it was batched.
+     */
+    void RestorePatrol(const ActorSnapshot& snapshot);
+
 protected:
     /**
      * @brief Reverse current patrol movement direction (if in Moving state).
@@ -38,8 +61,32 @@ protected:
     void ReversePatrolDirection();
 
 private:
+    // True when a living player is in range and visible from the actor's eyes
+    bool CanSeePlayer() const;
+    // Living player closest to the actor, or nullptr when all are dead
+    const Player* FindNearestPlayer() const;
+    // Span under the actor's feet, or NAV_NONE when airborne or off the graph
+    std::int32_t FindCurrentSpan() const;
+    // True when the actor has reached the end of its span (or the ground edge) towards dir
+    bool AtPatrolBound(std::int32_t span, GameTypes::Direction dir) const;
+    // Chasing/Searching: walk, drop or jump towards the route's target span
+    void FollowRoute();
+    // Hand Moving/Waiting to the PatrolSystem when standing on a span wide enough; false otherwise
+    bool StartBatchedPatrol();
+    // Take the patrol back from the PatrolSystem, copying its direction, timer and state
+    void StopBatchedPatrol();
+    // Walk towards a world x at route speed; stops within the dead zone or at the span end
+    void SteerTowards(float targetX, std::int32_t span, bool mayLeaveSpan);
+    // Keep the active move action when it already heads in dir; otherwise replace it
+    void Steer(GameTypes::Direction dir, float speed);
+    // Replace the active move action (if any) with one in patrolDir at the given speed
+    void StartMoving(float speed);
+    void StopMoving();
+
     PatrolState state = PatrolState::FallingToGround;
     float waitTimer = 0.0f;
-    std::mt19937 rng{std::random_device{}()};
+    std::int32_t navTarget = NAV_NONE; /**< Span the chased player was last seen on (Searching). */
+    CounterRng rng;           /**< Patrol decisions (initial direction). */
+    std::uint32_t patrolSlot; /**< Slot in the level's PatrolSystem. */
     GameTypes::Direction patrolDir = GameTypes::Direction::Right;
 };
\ No newline at end of file
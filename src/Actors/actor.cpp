@@ -0,0 +1,12 @@
+#include "actor.h"
+#include "gamelevel.h"
+
+Actor::Actor(GameLevel& level, GameTypes::AnimationData idleAnim, float x, float y)
+    : position{x, y},
+      gameLevel(level),
+      animations(level.GetContext().animations),
+      defaultClip(AnimationClipLibrary::Instance().GetClip(idleAnim)),
+      animation(animations.Create(defaultClip)) {
+    // consecutive slots spread the actors of slow tick groups over consecutive frames
+    tickState.slot = level.GetContext().ticks.AssignSlot();
+}
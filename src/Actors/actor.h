@@ -2,19 +2,22 @@
 
 #include "types.h"
 #include "raytmx.h"
-#include "animation2d.h"
-#include "animation2d_blinker.h"
-#include "ianimation2d.h"
+#include "animation_system.h"
+#include "actor_snapshot.h"
+#include "config.hpp"
+#include <cstdint>
+#include <limits>
 #include <memory>
 
 // Forward declare GameLevel (reference only needs this)
 class GameLevel;
+class Movable;
 
 /**
  * @brief Abstract base class for all game actors.
  *
  * Actors are game objects that have a position, an optional graphical representation
- * (animations) and can perform actions. This class provides basic state, position
+ * (an animation playback record in the world's AnimationSystem) and can perform actions. This class provides basic state, position
  * and animation management used by concrete actors (players, enemies, items).
  */
 class Actor {
@@ -31,24 +34,24 @@ public:
                      /// game over)
     };
 
-    // Default ctor - keeps compatibility with existing code that constructs Actor without params
-    Actor() = default;
-
-    // Construct with an owned Animation2D (takes ownership)
-    Actor(GameLevel& level, std::shared_ptr<Animation2D> anim, float x = 0.0f, float y = 0.0f)
-        : position{x, y}, defaultAnimation(std::move(anim)), currentAnimation(defaultAnimation), gameLevel(level) {}
+    /**
+     * @brief Stages of a per-frame actor update, run as separate parallel passes by GameLevel.
+     *
+     * Each pass finishes for all actors before the next one starts. Within a pass an actor
+     * may only touch its own state; registering/deregistering actions is deferred (see
+     * CommandBuffer).
+     */
+    enum class UpdatePhase : std::uint8_t {
+        Grounding, /**< Ground sensor and snapping. */
+        Physics,   /**< Gravity, integration, movement state (batched for GetBatchedBody actors). */
+        AI,        /**< Behaviour decisions (patrol, ...). */
+        Count
+    };
 
-    // Construct by providing animation parameters; Actor will create its own Animation2D
-    Actor(GameLevel& level, GameTypes::AnimationData idleAnim, float x = 0.0f, float y = 0.0f)
-        : position{x, y}, gameLevel(level) {
-        defaultAnimation = std::make_shared<Animation2D>(idleAnim);
-        currentAnimation = defaultAnimation;
-    }
+    // Construct by providing animation parameters; the clip is shared, the playback record is the actor's own
+    Actor(GameLevel& level, GameTypes::AnimationData idleAnim, float x = 0.0f, float y = 0.0f);
 
-    virtual ~Actor() {
-        defaultAnimation.reset();  // Ensure proper cleanup of animation
-        currentAnimation.reset();
-    }
+    virtual ~Actor() = default;
 
     /**
      * @brief Set the current runtime state for the actor.
@@ -110,10 +113,9 @@ public:
             return {position.x + colliderOffset.x, position.y + colliderOffset.y, colliderSize.x, colliderSize.y};
         }
 
-        if (currentAnimation) {
-            float frameWidth = currentAnimation->GetFrameWidth();
-            float frameHeight = currentAnimation->GetFrameHeight();
-            return {position.x, position.y, frameWidth, frameHeight};
+        const Vector2 frameSize = animations.GetFrameSize(animation);
+        if (frameSize.x > 0.0f) {
+            return {position.x, position.y, frameSize.x, frameSize.y};
         }
         return {position.x, position.y, 10.0f, 10.0f};  // Default rectangle if no animation
     }
@@ -127,21 +129,32 @@ public:
     }
 
     /**
-     * @brief Access the current primary animation.
-     *
-     * @return std::shared_ptr<IAnimation2D> Pointer to the current animation (can be nullptr).
+     * @brief Set the actor's collision layer bits and the layers it tests as a collision listener.
+     */
+    void SetCollisionFilter(std::uint32_t layer, std::uint32_t mask) noexcept {
+        collisionLayer = layer;
+        collisionMask = mask;
+    }
+
+    /** @brief CollisionConfig layer bits of this actor. */
+    std::uint32_t GetCollisionLayer() const noexcept { return collisionLayer; }
+
+    /** @brief Layers this actor collides with when it is a collision listener. */
+    std::uint32_t GetCollisionMask() const noexcept { return collisionMask; }
+
+    /**
+     * @brief Clip currently played by the actor.
      */
-    std::shared_ptr<IAnimation2D> GetCurrentAnimation() const { return currentAnimation; }
+    AnimationClipId GetCurrentAnimation() const noexcept { return animations.GetClip(animation); }
 
     /**
-     * @brief Change the current animation.
+     * @brief Change the current animation clip; a different clip starts from its first frame.
      *
-     * The provided animation becomes the current animation through shared ownership.
      * To revert to the default animation, call ResetToDefaultAnimation().
      */
-    virtual void SetCurrentAnimation(std::shared_ptr<IAnimation2D> anim) {
-        if (anim) {
-            currentAnimation = anim;
+    void SetCurrentAnimation(AnimationClipId clip) noexcept {
+        if (clip != NO_ANIMATION_CLIP) {
+            animations.Play(animation, clip);
         }
     }
 
@@ -160,7 +173,7 @@ public:
     /**
      * @brief Revert to the default/base animation.
      */
-    void ResetToDefaultAnimation() { currentAnimation = defaultAnimation; }
+    void ResetToDefaultAnimation() noexcept { animations.Play(animation, defaultClip); }
 
     /**
      * @brief Access the game level the actor belongs to.
@@ -168,17 +181,82 @@ public:
      * @return const GameLevel& Reference to the current game level.
      */
     const GameLevel& GetGameLevel() const { return gameLevel; }
+    GameLevel& GetGameLevel() { return gameLevel; }
+
+    /// Slot value for actors that are not part of a level's initial layout.
+    static constexpr std::uint32_t NO_SPAWN_SLOT = std::numeric_limits<std::uint32_t>::max();
+    /// Slot value reserved for the level's first player; player i uses PLAYER_SPAWN_SLOT - i.
+    static constexpr std::uint32_t PLAYER_SPAWN_SLOT = NO_SPAWN_SLOT - 1;
+
+    /**
+     * @brief Index of this actor in its level's initial snapshot (NO_SPAWN_SLOT when none).
+     */
+    std::uint32_t GetSpawnSlot() const noexcept { return spawnSlot; }
+
+    /**
+     * @brief Assign the index of this actor in its level's initial snapshot.
+     */
+    void SetSpawnSlot(std::uint32_t slot) noexcept { spawnSlot = slot; }
+
+    /**
+     * @brief Capture the restorable runtime state of the actor.
+     *
+     * Derived actors extend this with the state of their abilities.
+     *
+     * @param snapshot Record to fill.
+     */
+    virtual void SaveSnapshot(ActorSnapshot& snapshot) const {
+        snapshot.position = position;
+        snapshot.facing = facingDirection;
+        snapshot.alive = alive;
+        snapshot.actorState = static_cast<std::uint8_t>(actorState);
+        snapshot.tickElapsed = tickState.elapsed;
+    }
+
+    /**
+     * @brief Restore runtime state previously captured with SaveSnapshot.
+     *
+     * Reverts to the default animation and restarts it from the first frame.
+     *
+     * @param snapshot Record to apply.
+     */
+    virtual void RestoreSnapshot(const ActorSnapshot& snapshot) {
+        position = snapshot.position;
+        facingDirection = snapshot.facing;
+        alive = snapshot.alive;
+        actorState = static_cast<ActorState>(snapshot.actorState);
+        tickState.elapsed = snapshot.tickElapsed;
+        animations.Play(animation, defaultClip);
+        animations.Restart(animation);
+    }
 
     /**
      * @brief Base implementation of Update method
      *
-     * Derived classes can override this to implement specific behavior
+     * Does nothing: animation frames are derived from the world's animation clock by the
+     * AnimationSystem when drawn. Derived classes override this to implement specific behavior.
+     */
+    virtual void Update(float delta) { (void)delta; }
+
+    /**
+     * @brief Run one phase of the update; running all phases in order equals Update.
+     *
+     * The base implementation performs the whole Update in the first (Grounding) phase.
+     * Actors with more stages override this to split their work.
      */
-    virtual void Update(float delta) {
-        if (currentAnimation) {
-            currentAnimation->Update(delta);
+    virtual void RunPhase(UpdatePhase phase, float delta) {
+        if (phase == UpdatePhase::Grounding) {
+            Update(delta);
         }
-    };
+    }
+
+    /**
+     * @brief Body whose integration makes up this actor's whole Physics phase, if any.
+     *
+     * GameLevel integrates such bodies in batches (BodyIntegrator) instead of calling
+     * RunPhase(Physics). Actors with additional physics work return nullptr.
+     */
+    virtual Movable* GetBatchedBody() noexcept { return nullptr; }
 
     /**
      * @brief Draw the actor.
@@ -186,20 +264,37 @@ public:
      * This function is responsible for rendering the actor on the screen.
      */
     virtual void Draw() {
-        if (currentAnimation) {
-            currentAnimation->Draw(position, facingDirection == GameTypes::Direction::Left);
+        SpriteDraw sprite;
+        if (GetSprite(sprite)) {
+            DrawSprite(sprite);
         }
     }
 
+    /**
+     * @brief Describe how the actor is drawn this frame (used for render state snapshots).
+     *
+     * @param out Receives the sprite of the current animation frame.
+     * @return false when the actor has nothing to draw.
+     */
+    virtual bool GetSprite(SpriteDraw& out) const {
+        return animations.GetSprite(animation, position, facingDirection == GameTypes::Direction::Left, WHITE, out);
+    }
+
 protected:
     Vector2 position;
     // Fixed physics collider (optional). When width/height > 0, used for all physics queries.
     Vector2 colliderOffset{0.0f, 0.0f};
     Vector2 colliderSize{0.0f, 0.0f};
-    std::shared_ptr<IAnimation2D> defaultAnimation;  // default/base animation
-    std::shared_ptr<IAnimation2D> currentAnimation;  // current animation to be drawn (can be decorator)
-    GameLevel& gameLevel;                            // non-owning reference to the current game level
+    // Collision filter (CollisionConfig layer bits)
+    std::uint32_t collisionLayer = CollisionConfig::LAYER_DEFAULT;
+    std::uint32_t collisionMask = 0;
+    GameLevel& gameLevel;         // non-owning reference to the current game level
+    AnimationSystem& animations;  // playback records of the level's world
+    AnimationClipId defaultClip;  // default/base animation
+    AnimationHandle animation;    // this actor's playback record
     bool alive = true;                    // flag to indicate if the actor is still alive (meaning not destroyed)
     ActorState actorState = STATE_NORMAL; /**< Current general runtime state */
     GameTypes::Direction facingDirection = GameTypes::Direction::Right; /**< Current facing direction */
+    std::uint32_t spawnSlot = NO_SPAWN_SLOT; /**< Index into the level's initial snapshot */
+    TickState tickState;                     /**< Slot and pending time of the tick groups (see TickScheduler) */
 };
\ No newline at end of file
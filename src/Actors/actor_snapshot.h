@@ -0,0 +1,49 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "raylib.h"
+#include "types.h"
+#include "tick_scheduler.h"
+
+/**
+ * @brief Compact, trivially copyable record of an actor's restorable runtime state.
+ *
+ * One record covers the base actor and all ability mixins (movement, jumping,
+ * patrolling, player timers). Fields that a given actor type does not use are
+ * left at their defaults. Records are captured with `Actor::SaveSnapshot` and
+ * applied with `Actor::RestoreSnapshot`, which lets a level restore its initial
+ * layout in place instead of rebuilding it from the TMX map.
+ */
+struct ActorSnapshot {
+    Vector2 position{0.0f, 0.0f};
+    Vector2 velocity{0.0f, 0.0f};
+    float stateTimer = 0.0f;  /**< Player timed-state timer (damage / dying). */
+    float groundTimer = 0.0f; /**< Movable grounding grace timer. */
+    float patrolTimer = 0.0f; /**< Patrolable wait timer. */
+    std::array<float, TICK_GROUP_COUNT> tickElapsed{}; /**< Time not yet handed to each tick group. */
+    std::uint32_t rngCounter = 0; /**< Position in the actor's CounterRng stream. */
+    std::int32_t navTarget = -1; /**< Patrolable search target span (NAV_NONE when not searching). */
+    std::array<std::int32_t, 2> bodyPosition{}; /**< Movable fixed-point position (raw 16.16). */
+    std::int32_t bodyVelocityY = 0;              /**< Movable fixed-point vertical velocity (raw 16.16). */
+    std::int16_t lives = 0;
+    std::uint8_t actorState = 0;
+    std::uint8_t movementState = 0;
+    std::uint8_t prevMovementState = 0;
+    std::uint8_t patrolState = 0;
+    GameTypes::Direction facing = GameTypes::Direction::Right;
+    GameTypes::Direction patrolDirection = GameTypes::Direction::Right;
+    bool alive = true;
+    bool grounded = false;
+    bool doubleJumpDone = false;
+    bool patrolBatched = false; /**< Patrolable walking is advanced by the level's PatrolSystem. */
+    std::int8_t wallSide = 0; /**< Movable wall contact of the last horizontal move. */
+    std::uint8_t reserved[3] = {}; /**< Explicit tail padding: records are hashed byte-wise, so it stays zeroed. */
+};
+
+static_assert(std::is_trivially_copyable_v<ActorSnapshot>, "ActorSnapshot must stay memcpy-able");
+static_assert(sizeof(ActorSnapshot) % sizeof(std::uint32_t) == 0, "ActorSnapshot size must be a whole number of words");
+static_assert(offsetof(ActorSnapshot, reserved) + sizeof(ActorSnapshot::reserved) == sizeof(ActorSnapshot),
+              "ActorSnapshot must not have implicit padding: HashWorldState hashes its bytes");
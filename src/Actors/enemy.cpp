@@ -1,5 +1,14 @@
 #include "enemy.h"
 #include "config.hpp"
+#include "gamelevel.h"
+
+Enemy::Enemy(GameLevel& level, float x, float y, float moveSpeed, GameTypes::AnimationData idleAnim,
+             GameTypes::AnimationData patrolAnim)
+    : Actor(level, idleAnim, x, y), Movable(*this, patrolAnim, moveSpeed),
+      Jumpable(EnemyConfig::JUMP_STRENGTH),
+      Patrolable(level.NextActorSeed()) {
+    EnemyInit();
+}
 
 /**
  * @brief Update the enemy each frame.
@@ -10,12 +19,40 @@
  * @param delta Time in seconds since last frame.
  */
 void Enemy::Update(float delta) {
-    /* Call the base and mixin update routines in the correct order so that
-       animation advancement, physics integration and patrol decisions are
-       performed every frame. */
-    Actor::Update(delta);
-    Movable::Update(delta);
-    Patrolable::Update(delta);
+    /* Call the mixin update routines in the correct order so that grounding,
+       physics integration and patrol decisions are performed every frame
+       (animation frames are derived from the world's animation clock when drawn). */
+    for (std::uint8_t phase = 0; phase < static_cast<std::uint8_t>(UpdatePhase::Count); ++phase) {
+        RunPhase(static_cast<UpdatePhase>(phase), delta);
+    }
+}
+
+void Enemy::RunPhase(UpdatePhase phase, float delta) {
+    /* Sensors, animation checks and patrol decisions run at their tick group's rate; a
+       group that runs receives the time since it last ran for this enemy. Physics runs
+       every frame. */
+    TickScheduler& ticks = gameLevel.GetContext().ticks;
+    float elapsed = 0.0f;
+    switch (phase) {
+        case UpdatePhase::Grounding:
+            if (ticks.Tick(TickGroup::Sensors, tickState, delta, elapsed)) {
+                UpdateGrounding(elapsed);
+            }
+            if (ticks.Tick(TickGroup::Animation, tickState, delta, elapsed)) {
+                Jumpable::Update(elapsed);
+            }
+            break;
+        case UpdatePhase::Physics:
+            Integrate(delta);
+            break;
+        case UpdatePhase::AI:
+            if (ticks.Tick(TickGroup::AI, tickState, delta, elapsed)) {
+                Patrolable::Update(elapsed);
+            }
+            break;
+        case UpdatePhase::Count:
+            break;
+    }
 }
 
 /**
@@ -27,10 +64,25 @@ void Enemy::Draw() {
     Actor::Draw();
 }
 
+void Enemy::SaveSnapshot(ActorSnapshot& snapshot) const {
+    Actor::SaveSnapshot(snapshot);
+    SaveMovement(snapshot);
+    SaveJump(snapshot);
+    SavePatrol(snapshot);
+}
+
+void Enemy::RestoreSnapshot(const ActorSnapshot& snapshot) {
+    Actor::RestoreSnapshot(snapshot);
+    RestoreMovement(snapshot);
+    RestoreJump(snapshot);
+    RestorePatrol(snapshot);
+}
+
 void Enemy::EnemyInit() {
     /*
      * Configure a fixed physics collider for enemies.
      */
     SetCollider(EnemyConfig::COLLIDER_OFFSET_X, EnemyConfig::COLLIDER_OFFSET_Y, EnemyConfig::COLLIDER_WIDTH,
                 EnemyConfig::COLLIDER_HEIGHT);
+    SetCollisionFilter(CollisionConfig::LAYER_ENEMY, CollisionConfig::ENEMY_MASK);
 }
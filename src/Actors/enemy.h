@@ -2,22 +2,23 @@
 
 #include "actor.h"
 #include "patrolable.h"
+#include "jumpable.h"
 #include "movable.h"
 #include "types.h"
-#include <random>
 
 /**
  * @brief Simple Enemy actor: falls until it lands on ground, then patrols horizontally.
  *
- * The Enemy composes `Movable` and `Patrolable` to get gravity, collision and patrol behaviour.
+ * The Enemy composes `Movable`, `Jumpable` and `Patrolable` to get gravity, collision and
+ * patrol behaviour; jumping lets it follow the nav graph's jump edges while chasing.
  */
-class Enemy : public Actor, virtual public Movable, public Patrolable {
+class Enemy : public Actor, virtual public Movable, public Jumpable, public Patrolable {
 public:
+    /**
+     * @brief Construct an enemy; its patrol RNG is seeded from the level (see GameLevel::NextActorSeed).
+     */
     Enemy(GameLevel& level, float x, float y, float moveSpeed, GameTypes::AnimationData idleAnim,
-          GameTypes::AnimationData patrolAnim)
-        : Actor(level, idleAnim, x, y), Movable(*this, patrolAnim, moveSpeed), Patrolable() {
-        EnemyInit();
-    }
+          GameTypes::AnimationData patrolAnim);
 
     /**
      * @brief Update enemy each frame: animations, physics and patrol logic.
@@ -26,11 +27,33 @@ public:
      */
     void Update(float delta) override;
 
+    /**
+     * @brief Run one update phase: grounding, physics or patrol AI.
+     *
+     * Grounding and AI work is paced by the world's TickScheduler groups.
+     */
+    void RunPhase(UpdatePhase phase, float delta) override;
+
+    /**
+     * @brief The enemy's Physics phase is plain Movable integration, so the level batches it.
+     */
+    Movable* GetBatchedBody() noexcept override { return this; }
+
     /**
      * @brief Draw the enemy using the current animation frame.
      */
     void Draw() override;
 
+    /**
+     * @brief Capture actor, movement, jump and patrol state.
+     */
+    void SaveSnapshot(ActorSnapshot& snapshot) const override;
+
+    /**
+     * @brief Restore actor, movement, jump and patrol state.
+     */
+    void RestoreSnapshot(const ActorSnapshot& snapshot) override;
+
 private:
     void EnemyInit();
 };
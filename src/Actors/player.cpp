@@ -8,34 +8,40 @@
 #include "jump.h"
 #include "types.h"
 #include "collision_system.h"
-#include "animation2d.h"
-#include "animation2d_blinker.h"
-#include "enemy.h"
+
+Player::~Player() {
+    EventBus& events = gameLevel.GetContext().events;
+    events.Unsubscribe<KeyEvent>(this);
+    events.Unsubscribe<CollisionEvent>(this);
+    events.Unsubscribe<DamageEvent>(this);
+    gameLevel.GetContext().collisions.UnregisterListener(this);
+}
 
 /**
- * @brief Draw the player using Actor drawing logic.
+ * @brief Describe the player sprite; blinks while taking damage and fades out when dying.
  */
-void Player::Draw() {
-    // Apply fade-out when dying
+bool Player::GetSprite(SpriteDraw& out) const {
+    Color tint = WHITE;
     if (actorState == Actor::STATE_DYING) {
+        // Apply fade-out when dying
         float alpha = 1.0f - std::min(stateTimer / PlayerConfig::DEATH_FADE_DURATION, 1.0f);
-        Color tint = {255, 255, 255, static_cast<unsigned char>(alpha * 255)};
-        if (const IAnimation2D* anim = GetCurrentAnimation().get()) {
-            anim->Draw(GetPosition(), GetFacingDirection() == GameTypes::Direction::Left, tint, 1.0f);
+        tint.a = static_cast<unsigned char>(alpha * 255);
+    } else if (actorState == Actor::STATE_TAKING_DAMAGE) {
+        // two-frame cycle of BLINK_DURATION each (visible, faded), starting visible when hit
+        if (AnimationSystem::FrameAt(stateTimer, PlayerConfig::BLINK_DURATION, 2) != 0) {
+            tint.a = static_cast<unsigned char>(PlayerConfig::BLINK_MIN_ALPHA * 255.0f + 0.5f);
         }
-    } else {
-        Actor::Draw();
     }
+    return animations.GetSprite(animation, GetPosition(), GetFacingDirection() == GameTypes::Direction::Left, tint,
+                                out);
 }
 
 /**
  * @brief Per-frame update for the player.
  *
- * This updates animations, jump state and physics integration in the proper order.
+ * This updates jump state and physics integration in the proper order.
  */
 void Player::Update(float delta) {
-    // Update base animation state first
-    Actor::Update(delta);
     // Update jump-related state (resets double-jump when grounded, sets jump animation)
     Jumpable::Update(delta);
     // Then apply physics/movement integration
@@ -46,27 +52,35 @@ void Player::Update(float delta) {
         stateTimer += delta;
         if (stateTimer >= PlayerConfig::DAMAGE_STATE_DURATION) {
             actorState = Actor::STATE_NORMAL;
-            RefreshAnimation();
         }
     } else if (actorState == Actor::STATE_DYING) {
-        // Handle dying fade and level reset
+        // a co-op player out of lives stays dead while the others play on
+        if (lives == 0) return;
+        // Handle dying fade; the level decides between reset, respawn and game over
         stateTimer += delta;
         if (stateTimer >= PlayerConfig::DEATH_FADE_DURATION) {
             SetLives(lives - 1);
-            if (lives > 0) {
-                gameLevel.Reset();  // Reset level after fade completes
-            } else {
-                gameLevel.GameOver();  // no more lives, game over
-            }
+            gameLevel.OnPlayerDied(*this);
         }
         return;
     }
 }
 
+void Player::OnEvents(std::span<const KeyEvent> events) {
+    for (const KeyEvent& event : events) {
+        if (event.port != playerIndex) continue;
+        if (event.pressed) {
+            OnKeyPressed(event.key);
+        } else {
+            OnKeyReleased(event.key);
+        }
+    }
+}
+
 /**
  * @brief Handle key press events for movement and jumping.
  *
- * Registers Move/Jump actions in the global GameLogic when appropriate keys are pressed.
+ * Registers Move/Jump actions in the level's GameLogic when appropriate keys are pressed.
  */
 void Player::OnKeyPressed(int key) {
     if (actorState == Actor::STATE_DYING) return;  // ignore input when dying
@@ -77,16 +91,16 @@ void Player::OnKeyPressed(int key) {
         Action* raw = act.get();
         // If a previous move action exists, remove it before registering a new one
         if (activeMoveAction) {
-            GameLogic::Instance().DeregisterAction(activeMoveAction);
+            gameLevel.GetContext().logic.DeregisterAction(activeMoveAction);
             activeMoveAction = nullptr;
         }
-        GameLogic::Instance().RegisterAction(std::move(act));
+        gameLevel.GetContext().logic.RegisterAction(std::move(act));
         activeMoveAction = raw;
     }
 
     if (key == KEY_SPACE && CanJump()) {
         auto act = std::make_unique<Jump>(*this);
-        GameLogic::Instance().RegisterAction(std::move(act));
+        gameLevel.GetContext().logic.RegisterAction(std::move(act));
     }
 }
 
@@ -100,7 +114,7 @@ void Player::Destroy() {
     stateTimer = 0.0f;
 
     if (activeMoveAction) {
-        GameLogic::Instance().DeregisterAction(activeMoveAction);
+        gameLevel.GetContext().logic.DeregisterAction(activeMoveAction);
         activeMoveAction = nullptr;
     }
 }
@@ -114,12 +128,9 @@ void Player::TakeDamage() {
         actorState = Actor::STATE_TAKING_DAMAGE;
         stateTimer = 0.0f;
 
-        // Update animation to blinking version
-        RefreshAnimation();
-
         // Apply a jump impulse when colliding with an enemy
         auto act = std::make_unique<Jump>(*this);
-        GameLogic::Instance().RegisterAction(std::move(act));
+        gameLevel.GetContext().logic.RegisterAction(std::move(act));
     } else {
         // No lives left, initiate death sequence
         Destroy();
@@ -133,21 +144,25 @@ void Player::OnKeyReleased(int key) {
     if ((key == KEY_LEFT || key == KEY_RIGHT) && activeMoveAction) {
         // Only deregister when the released key corresponds to current motion direction
         if ((key == KEY_LEFT && IsMovingLeft()) || (key == KEY_RIGHT && IsMovingRight())) {
-            GameLogic::Instance().DeregisterAction(activeMoveAction);
+            gameLevel.GetContext().logic.DeregisterAction(activeMoveAction);
             activeMoveAction = nullptr;
         }
     }
 }
 
 void Player::PlayerInit() {
-    InputManager::Instance().RegisterListener(this);
-    CollisionSystem::Instance().RegisterListener(this);
+    EventBus& events = gameLevel.GetContext().events;
+    events.Subscribe<KeyEvent>(this);
+    events.Subscribe<CollisionEvent>(this);
+    events.Subscribe<DamageEvent>(this);
+    gameLevel.GetContext().collisions.RegisterListener(this);
     /*
      * Configure a fixed physics collider so animation frame size changes do not
      * affect collision and ground detection.
      */
     SetCollider(PlayerConfig::COLLIDER_OFFSET_X, PlayerConfig::COLLIDER_OFFSET_Y, PlayerConfig::COLLIDER_WIDTH,
                 PlayerConfig::COLLIDER_HEIGHT);
+    SetCollisionFilter(CollisionConfig::LAYER_PLAYER, CollisionConfig::PLAYER_MASK);
 }
 
 void Player::ResetState() {
@@ -156,38 +171,42 @@ void Player::ResetState() {
     stateTimer = 0.0f;
 }
 
-void Player::SetLives(int livesNew) {
-    lives = std::clamp(livesNew, 0, PlayerConfig::MAX_LIVES);
+void Player::SaveSnapshot(ActorSnapshot& snapshot) const {
+    Actor::SaveSnapshot(snapshot);
+    SaveMovement(snapshot);
+    SaveJump(snapshot);
+    snapshot.stateTimer = stateTimer;
+    snapshot.lives = static_cast<std::int16_t>(lives);
 }
 
-void Player::OnCollision(Actor& self, Actor& other, const Rectangle& overlap) {
-    if (&self == &other) return;
-    if (actorState == Actor::STATE_DYING) return;
-    // in case of collision with enemy set state to take damage
-    if (typeid(Enemy) == typeid(other) && actorState != Actor::STATE_TAKING_DAMAGE) {
-        TakeDamage();
-    }
+void Player::RestoreSnapshot(const ActorSnapshot& snapshot) {
+    Actor::RestoreSnapshot(snapshot);
+    RestoreMovement(snapshot);
+    RestoreJump(snapshot);
+    stateTimer = snapshot.stateTimer;
+    SetLives(snapshot.lives);
 }
 
-void Player::SetCurrentAnimation(std::shared_ptr<IAnimation2D> anim) {
-    if (actorState == Actor::STATE_TAKING_DAMAGE) {
-        // wrap the animation to a blinking decorator
-        anim = std::make_shared<BlinkingAnimation2D>(anim, PlayerConfig::BLINK_DURATION, PlayerConfig::BLINK_MIN_ALPHA);
+void Player::SetLives(int livesNew) {
+    lives = std::clamp(livesNew, 0, PlayerConfig::MAX_LIVES);
+}
+
+void Player::OnEvents(std::span<const CollisionEvent> events) {
+    if (actorState == Actor::STATE_DYING || actorState == Actor::STATE_TAKING_DAMAGE) return;
+    for (const CollisionEvent& event : events) {
+        // the collision mask only reports enemies; a contact that outlasts the invulnerability hurts again
+        if (event.self != this || event.phase == ContactPhase::Exit) continue;
+        gameLevel.GetContext().events.Publish(DamageEvent{this, event.other});
+        return;
     }
-    Actor::SetCurrentAnimation(anim);
 }
 
-void Player::RefreshAnimation() {
-    if (actorState == Actor::STATE_TAKING_DAMAGE) {
-        // wrap the animation to a blinking decorator
-        currentAnimation = std::make_shared<BlinkingAnimation2D>(currentAnimation, PlayerConfig::BLINK_DURATION,
-                                                                 PlayerConfig::BLINK_MIN_ALPHA);
-    } else {
-        if (typeid(*currentAnimation) == typeid(BlinkingAnimation2D)) {
-            // unwrap to get the original animation
-            if (auto blinkAnim = dynamic_cast<BlinkingAnimation2D*>(currentAnimation.get())) {
-                currentAnimation = blinkAnim->GetWrappedAnimation();
-            }
+void Player::OnEvents(std::span<const DamageEvent> events) {
+    for (const DamageEvent& event : events) {
+        // invulnerable while taking damage
+        if (event.target == this && actorState != Actor::STATE_TAKING_DAMAGE) {
+            TakeDamage();
         }
     }
 }
+
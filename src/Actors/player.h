@@ -3,7 +3,8 @@
 #include "raytmx.h"
 #include "movable.h"
 #include "action.h"
-#include "keyboard_listener.h"
+#include "event_handler.h"
+#include "game_events.h"
 #include "input_manager.h"
 #include "jumpable.h"
 #include "config.hpp"
@@ -13,20 +14,22 @@
 /**
  * @brief Player actor representing the user-controlled character.
  *
- * The Player composes movement, jumping and input-listening behaviors. It registers
- * itself with the `InputManager` to receive keyboard events and updates animation
- * and physics state each frame.
+ * The Player composes movement, jumping and input-handling behaviors. It subscribes to
+ * its level's event bus for the key events of its input port, its collisions and the
+ * damage those cause, and updates animation and physics state each frame.
  */
 class Player : public Actor,
                virtual public Movable,
                public Jumpable,
-               public KeyboardListener,
+               public IEventHandler<KeyEvent>,
+               public IEventHandler<CollisionEvent>,
+               public IEventHandler<DamageEvent>,
                public ICollisionListener {
 public:
     /**
      * @brief Construct a new Player instance.
      *
-     * Registers the player as a keyboard listener on construction.
+     * Subscribes the player to its level's events on construction.
      *
      * @param level Reference to the owning GameLevel.
      * @param x Initial X position.
@@ -63,13 +66,10 @@ public:
     }
 
     /**
-     * @brief Destroy the Player and unregister keyboard listener.
+     * @brief Destroy the Player and unsubscribe from the level's events.
      */
-    ~Player() {
-        InputManager::Instance().UnregisterListener(this);
-        CollisionSystem::Instance().UnregisterListener(this);
-    }
-    // Non-copyable/movable: listener registration ties lifetime to this instance
+    ~Player();
+    // Non-copyable/movable: event subscriptions tie lifetime to this instance
     Player(const Player&) = delete;
     Player(Player&&) = delete;
     Player& operator=(const Player&) = delete;
@@ -83,22 +83,27 @@ public:
     void Update(float delta) override;
 
     /**
-     * @brief Draw the player; overrides Movable/Actor drawing behavior to handle flipping.
+     * @brief Describe the player sprite; overrides Actor to blink while taking damage and fade out while dying.
      */
-    void Draw() override;
+    bool GetSprite(SpriteDraw& out) const override;
 
     /**
-     * @brief KeyboardListener callback: key pressed event.
+     * @brief Start or stop moving and jumping for the key events of the player's input port.
      */
-    void OnKeyPressed(int key) override;
+    void OnEvents(std::span<const KeyEvent> events) override;
 
     /**
-     * @brief KeyboardListener callback: key released event.
+     * @brief Turn the first enemy contact of this tick into a DamageEvent (unless invulnerable or dying).
      */
-    void OnKeyReleased(int key) override;
+    void OnEvents(std::span<const CollisionEvent> events) override;
 
     /**
-     * @brief Override to start a dying sequence (fade out) and reset the level.
+     * @brief Take the damage published for this player.
+     */
+    void OnEvents(std::span<const DamageEvent> events) override;
+
+    /**
+     * @brief Override to start a dying sequence (fade out); see GameLevel::OnPlayerDied.
      */
     void Destroy() override;
 
@@ -113,9 +118,14 @@ public:
     void ResetState();
 
     /**
-     * @brief Collision callback from CollisionSystem.
+     * @brief Capture actor, movement, jump, timed-state and lives state.
+     */
+    void SaveSnapshot(ActorSnapshot& snapshot) const override;
+
+    /**
+     * @brief Restore state captured by SaveSnapshot, re-applying damage effects if needed.
      */
-    void OnCollision(Actor& self, Actor& other, const Rectangle& overlap) override;
+    void RestoreSnapshot(const ActorSnapshot& snapshot) override;
 
     Actor& GetCollisionActor() override { return *this; }
 
@@ -135,18 +145,27 @@ public:
     void AddLife() { SetLives(lives + 1); }
 
     /**
-     * @brief Override to add specific effects when changing animation (e.g. blinking).
+     * @brief Player slot in the level, which is also the input port the player listens to.
+     */
+    std::size_t GetPlayerIndex() const noexcept { return playerIndex; }
+
+    /**
+     * @brief Move the player to another slot and input port (done by GameLevel when adding players).
      */
-    void SetCurrentAnimation(std::shared_ptr<IAnimation2D> anim) override;
+    void SetPlayerIndex(std::size_t index) noexcept { playerIndex = index; }
 
 private:
     // timer for timed actor states (state is left after timer runs out)
     float stateTimer = 0.0f;
     // remaining lives
     int lives = PlayerConfig::START_LIVES;
+    // player slot and input port
+    std::size_t playerIndex = 0;
 
     // Helper to initialize player-specific settings
     void PlayerInit();
-    // Re-set the current animation to apply any effects (e.g. blinking).
-    void RefreshAnimation();
+    // Key press: register Move/Jump actions
+    void OnKeyPressed(int key);
+    // Key release: stop the current movement if it matches the key
+    void OnKeyReleased(int key);
 };
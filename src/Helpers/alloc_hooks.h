@@ -0,0 +1,31 @@
+/*
+ * Allocation hooks for raylib and header-only libraries that allocate through RL_MALLOC.
+ *
+ * This header is force-included (see THE_GAME_ALLOC_TRACKING in CMakeLists.txt) into the
+ * raylib target and the game, so raylib's MemAlloc/MemFree and raytmx allocations are
+ * counted by AllocTracker. It must stay valid C.
+ */
+#ifndef GAME_ALLOC_HOOKS_H
+#define GAME_ALLOC_HOOKS_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void* GameTrackedMalloc(size_t size);
+void* GameTrackedCalloc(size_t count, size_t size);
+void* GameTrackedRealloc(void* block, size_t size);
+void GameTrackedFree(void* block);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define RL_MALLOC(sz) GameTrackedMalloc(sz)
+#define RL_CALLOC(n, sz) GameTrackedCalloc(n, sz)
+#define RL_REALLOC(ptr, sz) GameTrackedRealloc(ptr, sz)
+#define RL_FREE(ptr) GameTrackedFree(ptr)
+
+#endif /* GAME_ALLOC_HOOKS_H */
@@ -0,0 +1,164 @@
+#include "alloc_tracker.h"
+#include "alloc_hooks.h"
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <new>
+#include "raylib.h"
+
+namespace {
+std::atomic<std::uint64_t> totalAllocations{0};
+std::atomic<std::uint64_t> totalBytes{0};
+std::atomic<std::uint64_t> totalFrees{0};
+std::atomic<bool> strictMode{false};
+
+thread_local AllocCounts threadCounts;
+thread_local int allowDepth = 0;
+thread_local bool reportingViolation = false;
+
+void ReportStrictViolation(std::size_t bytes) noexcept {
+    // the report itself must not recurse into the check
+    if (reportingViolation) return;
+    reportingViolation = true;
+    TraceLog(LOG_ERROR, "AllocTracker: %zu byte allocation during steady-state gameplay (strict mode)", bytes);
+    assert(!"heap allocation in strict mode");
+    reportingViolation = false;
+}
+}  // namespace
+
+bool AllocTracker::IsEnabled() noexcept {
+#if defined(GAME_ALLOC_TRACKING)
+    return true;
+#else
+    return false;
+#endif
+}
+
+AllocCounts AllocTracker::GetTotals() noexcept {
+    return {totalAllocations.load(std::memory_order_relaxed), totalBytes.load(std::memory_order_relaxed),
+            totalFrees.load(std::memory_order_relaxed)};
+}
+
+AllocCounts AllocTracker::GetThreadTotals() noexcept {
+    return threadCounts;
+}
+
+void AllocTracker::SetStrict(bool enabled) noexcept {
+    strictMode.store(enabled, std::memory_order_relaxed);
+}
+
+bool AllocTracker::IsStrict() noexcept {
+    return strictMode.load(std::memory_order_relaxed);
+}
+
+void AllocTracker::RecordAllocation(std::size_t bytes) noexcept {
+    totalAllocations.fetch_add(1, std::memory_order_relaxed);
+    totalBytes.fetch_add(bytes, std::memory_order_relaxed);
+    ++threadCounts.allocations;
+    threadCounts.bytes += bytes;
+    if (allowDepth == 0 && strictMode.load(std::memory_order_relaxed)) {
+        ReportStrictViolation(bytes);
+    }
+}
+
+void AllocTracker::RecordFree() noexcept {
+    totalFrees.fetch_add(1, std::memory_order_relaxed);
+    ++threadCounts.frees;
+}
+
+AllocTracker::AllowScope::AllowScope() noexcept {
+    ++allowDepth;
+}
+
+AllocTracker::AllowScope::~AllowScope() {
+    --allowDepth;
+}
+
+/* raylib (RL_MALLOC family) hooks; always defined so a force-included alloc_hooks.h links */
+extern "C" void* GameTrackedMalloc(size_t size) {
+    AllocTracker::RecordAllocation(size);
+    return std::malloc(size);
+}
+
+extern "C" void* GameTrackedCalloc(size_t count, size_t size) {
+    AllocTracker::RecordAllocation(count * size);
+    return std::calloc(count, size);
+}
+
+extern "C" void* GameTrackedRealloc(void* block, size_t size) {
+    // resizing keeps the live block count: realloc(nullptr, n) allocates, realloc(p, 0) frees
+    if (block == nullptr) {
+        AllocTracker::RecordAllocation(size);
+    } else if (size == 0) {
+        AllocTracker::RecordFree();
+        std::free(block);
+        return nullptr;
+    }
+    return std::realloc(block, size);
+}
+
+extern "C" void GameTrackedFree(void* block) {
+    if (block != nullptr) AllocTracker::RecordFree();
+    std::free(block);
+}
+
+#if defined(GAME_ALLOC_TRACKING)
+/*
+ * Replacements for the global allocation functions. Over-aligned variants are left to
+ * the standard library (they pair with its own aligned deallocation and are rare here).
+ */
+namespace {
+void* TrackedNew(std::size_t size) noexcept {
+    AllocTracker::RecordAllocation(size);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void TrackedDelete(void* block) noexcept {
+    if (block == nullptr) return;
+    AllocTracker::RecordFree();
+    std::free(block);
+}
+}  // namespace
+
+void* operator new(std::size_t size) {
+    if (void* block = TrackedNew(size)) return block;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    if (void* block = TrackedNew(size)) return block;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return TrackedNew(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return TrackedNew(size);
+}
+
+void operator delete(void* block) noexcept {
+    TrackedDelete(block);
+}
+
+void operator delete[](void* block) noexcept {
+    TrackedDelete(block);
+}
+
+void operator delete(void* block, std::size_t) noexcept {
+    TrackedDelete(block);
+}
+
+void operator delete[](void* block, std::size_t) noexcept {
+    TrackedDelete(block);
+}
+
+void operator delete(void* block, const std::nothrow_t&) noexcept {
+    TrackedDelete(block);
+}
+
+void operator delete[](void* block, const std::nothrow_t&) noexcept {
+    TrackedDelete(block);
+}
+#endif
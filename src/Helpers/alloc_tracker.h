@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Allocation counts (monotonic totals; subtract two samples for a period).
+ */
+struct AllocCounts {
+    std::uint64_t allocations = 0;
+    std::uint64_t bytes = 0; /**< Requested bytes of all allocations. */
+    std::uint64_t frees = 0;
+};
+
+/**
+ * @brief Process-wide heap allocation accounting.
+ *
+ * When the build defines `GAME_ALLOC_TRACKING`, global `operator new`/`delete` and
+ * raylib's RL_MALLOC family (see alloc_hooks.h) report every allocation here. Totals
+ * are kept for the whole process and per thread; the profiler samples them to report
+ * allocations per frame and per zone.
+ *
+ * Strict mode turns any allocation into an assertion failure, which is how the
+ * steady-state gameplay loop is kept allocation free. Code that legitimately allocates
+ * while strict mode is on (writing reports, starting a capture) opens an `AllowScope`.
+ */
+class AllocTracker {
+public:
+    /** Whether allocation tracking is compiled in. */
+    static bool IsEnabled() noexcept;
+
+    /** Totals over all threads. */
+    static AllocCounts GetTotals() noexcept;
+
+    /** Totals of the calling thread. */
+    static AllocCounts GetThreadTotals() noexcept;
+
+    /**
+     * @brief Enable or disable strict mode (assert on every allocation).
+     */
+    static void SetStrict(bool enabled) noexcept;
+
+    static bool IsStrict() noexcept;
+
+    /** Called by the allocation hooks. */
+    static void RecordAllocation(std::size_t bytes) noexcept;
+    static void RecordFree() noexcept;
+
+    /**
+     * @brief Allows allocations on the current thread while strict mode is on.
+     */
+    class AllowScope {
+    public:
+        AllowScope() noexcept;
+        ~AllowScope();
+        AllowScope(const AllowScope&) = delete;
+        AllowScope& operator=(const AllowScope&) = delete;
+    };
+};
@@ -0,0 +1,40 @@
+#include "animation_clip.h"
+#include "texture_manager.h"
+
+AnimationClipLibrary& AnimationClipLibrary::Instance() {
+    static AnimationClipLibrary instance;
+    return instance;
+}
+
+AnimationClipId AnimationClipLibrary::GetClip(const GameTypes::AnimationData& data) {
+    // fall back to a single frame / 0.1 s per frame for incomplete definitions
+    const int frameCount = data.frameCount > 0 ? data.frameCount : 1;
+    const float frameDuration = data.frameDuration > 0.0f ? data.frameDuration : 0.1f;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    const std::size_t count = clipCount.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < count; ++i) {
+        const ClipKey& key = keys[i];
+        if (key.texturePath == data.texturePath && key.frameCount == frameCount &&
+            key.frameDuration == frameDuration && key.offsetX == data.offsetX && key.offsetY == data.offsetY) {
+            return static_cast<AnimationClipId>(i);
+        }
+    }
+    if (count == clips.size()) {
+        TraceLog(LOG_ERROR, "AnimationClipLibrary: clip limit reached, ignoring %.*s",
+                 static_cast<int>(data.texturePath.size()), data.texturePath.data());
+        return NO_ANIMATION_CLIP;
+    }
+
+    const CachedTexture& texture = TextureManager::Instance().GetTexture(data.texturePath);
+    AnimationClip& clip = clips[count];
+    clip.texture = &texture;
+    clip.frameCount = frameCount;
+    clip.frameDuration = frameDuration;
+    clip.frameWidth = static_cast<float>(texture.GetWidth()) / static_cast<float>(frameCount);
+    clip.frameHeight = static_cast<float>(texture.GetHeight());
+    clip.drawOffset = {data.offsetX, data.offsetY};
+    keys[count] = {std::string(data.texturePath), frameCount, frameDuration, data.offsetX, data.offsetY};
+    clipCount.store(count + 1, std::memory_order_release);
+    return static_cast<AnimationClipId>(count);
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <string>
+#include "raylib.h"
+#include "types.h"
+#include "config.hpp"
+
+class CachedTexture;
+
+/// Index of a clip in the AnimationClipLibrary.
+using AnimationClipId = std::uint16_t;
+/// Clip id meaning "no animation".
+inline constexpr AnimationClipId NO_ANIMATION_CLIP = std::numeric_limits<AnimationClipId>::max();
+
+/**
+ * @brief Immutable definition of a sprite-sheet animation, shared by every actor using it.
+ *
+ * Frames are laid out horizontally in the texture. Playback state (clip and start
+ * time) lives in an AnimationPlayback record, not here.
+ */
+struct AnimationClip {
+    const CachedTexture* texture = nullptr; /**< Owned by TextureManager. */
+    int frameCount = 1;
+    float frameDuration = 0.1f; /**< Seconds per frame. */
+    float frameWidth = 0.0f;    /**< Width of one frame in pixels. */
+    float frameHeight = 0.0f;   /**< Height of one frame in pixels. */
+    Vector2 drawOffset{0.0f, 0.0f};
+};
+
+/**
+ * @brief Process-wide, thread-safe registry of animation clips.
+ *
+ * `GetClip` builds a clip from `GameTypes::AnimationData` the first time a definition is
+ * seen and returns the same id for every later request, so all actors of a kind share
+ * one clip. Clips are stored in a fixed array and never change after creation, which
+ * makes `Get` lock-free.
+ */
+class AnimationClipLibrary {
+public:
+    static AnimationClipLibrary& Instance();
+
+    /**
+     * @brief Find or create the clip for an animation definition.
+     *
+     * @return Clip id, or NO_ANIMATION_CLIP when the library is full.
+     */
+    AnimationClipId GetClip(const GameTypes::AnimationData& data);
+
+    /**
+     * @brief Access a clip by id (id must come from GetClip).
+     */
+    const AnimationClip& Get(AnimationClipId id) const noexcept { return clips[id]; }
+
+    /** Number of clips created so far. */
+    std::size_t GetClipCount() const noexcept { return clipCount.load(std::memory_order_acquire); }
+
+private:
+    AnimationClipLibrary() = default;
+    AnimationClipLibrary(const AnimationClipLibrary&) = delete;
+    AnimationClipLibrary& operator=(const AnimationClipLibrary&) = delete;
+
+    // Definition a clip was built from, used to find existing clips
+    struct ClipKey {
+        std::string texturePath;
+        int frameCount = 0;
+        float frameDuration = 0.0f;
+        float offsetX = 0.0f;
+        float offsetY = 0.0f;
+    };
+
+    std::mutex mutex;
+    std::array<AnimationClip, AnimationConfig::MAX_CLIPS> clips{};
+    std::array<ClipKey, AnimationConfig::MAX_CLIPS> keys{};
+    std::atomic<std::size_t> clipCount{0};
+};
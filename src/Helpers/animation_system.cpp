@@ -0,0 +1,51 @@
+#include "animation_system.h"
+#include <cmath>
+#include "texture_manager.h"
+
+AnimationHandle AnimationSystem::Create(AnimationClipId clip) {
+    playbacks.push_back({clip, clock});
+    return static_cast<AnimationHandle>(playbacks.size() - 1);
+}
+
+Vector2 AnimationSystem::GetFrameSize(AnimationHandle handle) const noexcept {
+    const AnimationClipId clipId = playbacks[handle].clip;
+    if (clipId == NO_ANIMATION_CLIP) return {0.0f, 0.0f};
+    const AnimationClip& clip = AnimationClipLibrary::Instance().Get(clipId);
+    return {clip.frameWidth, clip.frameHeight};
+}
+
+int AnimationSystem::FrameAt(double elapsed, float frameDuration, int frameCount) noexcept {
+    if (frameCount <= 1 || frameDuration <= 0.0f || elapsed <= 0.0) return 0;
+    const double frames = std::floor(elapsed / frameDuration);
+    return static_cast<int>(std::fmod(frames, static_cast<double>(frameCount)));
+}
+
+int AnimationSystem::GetFrame(AnimationHandle handle) const noexcept {
+    const AnimationPlayback& playback = playbacks[handle];
+    if (playback.clip == NO_ANIMATION_CLIP) return 0;
+    const AnimationClip& clip = AnimationClipLibrary::Instance().Get(playback.clip);
+    return FrameAt(clock - playback.startTime, clip.frameDuration, clip.frameCount);
+}
+
+/**
+ * @brief Evaluate the current frame and compute its source/destination rectangles.
+ */
+bool AnimationSystem::GetSprite(AnimationHandle handle, Vector2 position, bool flipped, Color tint,
+                                SpriteDraw& out) const noexcept {
+    const AnimationPlayback& playback = playbacks[handle];
+    if (playback.clip == NO_ANIMATION_CLIP) return false;
+    const AnimationClip& clip = AnimationClipLibrary::Instance().Get(playback.clip);
+    const int frame = FrameAt(clock - playback.startTime, clip.frameDuration, clip.frameCount);
+
+    /* Apply visual draw offset before computing destination rectangle */
+    const Vector2 adjusted{position.x + (flipped ? -clip.drawOffset.x : clip.drawOffset.x),
+                           position.y + clip.drawOffset.y};
+    // start from the right edge of the frame and use negative width to flip
+    Rectangle source{clip.frameWidth * frame, 0.0f, clip.frameWidth, clip.frameHeight};
+    if (flipped) {
+        source.x += clip.frameWidth;
+        source.width = -clip.frameWidth;
+    }
+    out = {clip.texture->Get(), source, {adjusted.x, adjusted.y, clip.frameWidth, clip.frameHeight}, tint};
+    return true;
+}
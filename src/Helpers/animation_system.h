@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "raylib.h"
+#include "animation_clip.h"
+#include "sprite_draw.h"
+
+/// Index of a playback record in a world's AnimationSystem.
+using AnimationHandle = std::uint32_t;
+
+/**
+ * @brief Per-actor animation playback state: which clip and when it was started.
+ */
+struct AnimationPlayback {
+    AnimationClipId clip = NO_ANIMATION_CLIP;
+    double startTime = 0.0; /**< World animation clock when the clip was (re)started. */
+};
+
+/**
+ * @brief Playback records of all actors of one world, kept in one contiguous array.
+ *
+ * Each actor owns a record (created at spawn, alive as long as the world) and switches
+ * clips with `Play`. Records hold no running timers: the current frame is evaluated on
+ * demand from the world's animation clock and the record's start time,
+ * `frame = floor((now - start) / frameDuration) mod frameCount`. Advancing the world is a
+ * single clock increment, so actors that are not drawn cost nothing for animation.
+ *
+ * Switching to a different clip starts it from its first frame.
+ */
+class AnimationSystem {
+public:
+    AnimationSystem() = default;
+    AnimationSystem(const AnimationSystem&) = delete;
+    AnimationSystem& operator=(const AnimationSystem&) = delete;
+
+    /**
+     * @brief Create a playback record starting the given clip.
+     */
+    AnimationHandle Create(AnimationClipId clip);
+
+    /**
+     * @brief Switch a record to a clip; restarts only when the clip changes.
+     */
+    void Play(AnimationHandle handle, AnimationClipId clip) noexcept {
+        AnimationPlayback& playback = playbacks[handle];
+        if (playback.clip != clip) {
+            playback = {clip, clock};
+        }
+    }
+
+    /**
+     * @brief Rewind a record to the first frame of its clip.
+     */
+    void Restart(AnimationHandle handle) noexcept { playbacks[handle].startTime = clock; }
+
+    /**
+     * @brief Clip currently played by a record.
+     */
+    AnimationClipId GetClip(AnimationHandle handle) const noexcept { return playbacks[handle].clip; }
+
+    /**
+     * @brief Playback state of a record.
+     */
+    const AnimationPlayback& GetPlayback(AnimationHandle handle) const noexcept { return playbacks[handle]; }
+
+    /**
+     * @brief Frame size of the record's current clip (zero when it has none).
+     */
+    Vector2 GetFrameSize(AnimationHandle handle) const noexcept;
+
+    /**
+     * @brief Frame of the record's current clip at the current clock time.
+     */
+    int GetFrame(AnimationHandle handle) const noexcept;
+
+    /**
+     * @brief Advance the animation clock by delta seconds; every record follows implicitly.
+     */
+    void Update(float delta) noexcept { clock += delta; }
+
+    /** Seconds of animation time elapsed in this world. */
+    double GetTime() const noexcept { return clock; }
+
+    /**
+     * @brief Frame index reached after elapsed seconds of a looping sequence.
+     *
+     * Shared by clip playback and other time-derived cycles (e.g. the player's damage blink).
+     */
+    static int FrameAt(double elapsed, float frameDuration, int frameCount) noexcept;
+
+    /**
+     * @brief Describe the current frame of a record drawn at position.
+     *
+     * @return false when the record plays no clip.
+     */
+    bool GetSprite(AnimationHandle handle, Vector2 position, bool flipped, Color tint, SpriteDraw& out) const noexcept;
+
+    /** Number of playback records. */
+    std::size_t GetCount() const noexcept { return playbacks.size(); }
+
+private:
+    std::vector<AnimationPlayback> playbacks;
+    double clock = 0.0; /**< Accumulated in double so long sessions keep frame precision. */
+};
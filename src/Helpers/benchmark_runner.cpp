@@ -0,0 +1,244 @@
+#include "benchmark_runner.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <vector>
+#include "autoplay_input.h"
+#include "config.hpp"
+#include "gamelevel.h"
+#include "profiler.h"
+#include "raylib.h"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+/// Per-tick wall times of the measured ticks in milliseconds.
+struct Timings {
+    std::vector<double> update;
+    std::vector<double> collision;
+    std::vector<double> render;
+    std::vector<double> frame;
+};
+
+/// Result of measuring one level.
+struct Measurement {
+    Timings timings;
+    std::size_t actors = 0;    /**< Actors and players when the measurement started. */
+    std::uint32_t restarts = 0;
+    double seconds = 0.0;      /**< Wall time including warm-up. */
+};
+
+double Millis(Clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+/* Warm up, then time `ticks` autoplayed fixed steps of the level (and their rendering) */
+Measurement Measure(GameLevel& level, AutoplayInput& autoplay, std::uint64_t ticks, bool render) {
+    Measurement result;
+    result.actors = level.GetActors().size() + level.GetPlayerCount();
+    for (std::vector<double>* phase :
+         {&result.timings.update, &result.timings.collision, &result.timings.render, &result.timings.frame}) {
+        phase->reserve(static_cast<std::size_t>(ticks));
+    }
+
+    const auto start = Clock::now();
+    for (std::uint64_t tick = 0; tick < BenchmarkConfig::WARMUP_TICKS + ticks; ++tick) {
+        PROFILE_BEGIN_FRAME();
+        autoplay.BeginTick();
+        const auto stepStart = Clock::now();
+        level.Step(DeterminismConfig::FIXED_TIME_STEP);
+        const auto stepEnd = Clock::now();
+        if (render) {
+            level.Render();
+        }
+        const auto renderEnd = Clock::now();
+        PROFILE_END_FRAME();
+
+        // a game over or completed level restarts the scene, so long runs keep the same load
+        if (level.IsFinished()) {
+            level.Restart();
+            ++result.restarts;
+        }
+        if (tick < BenchmarkConfig::WARMUP_TICKS) continue;
+        const double collision = level.GetCollisionMillis();
+        const double step = Millis(stepEnd - stepStart);
+        result.timings.update.push_back(std::max(0.0, step - collision));
+        result.timings.collision.push_back(collision);
+        result.timings.render.push_back(Millis(renderEnd - stepEnd));
+        result.timings.frame.push_back(Millis(renderEnd - stepStart));
+    }
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return result;
+}
+
+BenchmarkRunner::Stats Summarize(std::vector<double>& values) {
+    BenchmarkRunner::Stats stats;
+    if (values.empty()) return stats;
+    const std::size_t count = values.size();
+    double sum = 0.0;
+    for (const double value : values) {
+        sum += value;
+    }
+    stats.mean = sum / static_cast<double>(count);
+    // nearest-rank percentile
+    auto percentile = [&](double p) {
+        const std::size_t rank = static_cast<std::size_t>(std::ceil(p * static_cast<double>(count)));
+        const auto nth = values.begin() + static_cast<std::ptrdiff_t>(std::clamp<std::size_t>(rank, 1, count) - 1);
+        std::nth_element(values.begin(), nth, values.end());
+        return *nth;
+    };
+    stats.p50 = percentile(0.50);
+    stats.p90 = percentile(0.90);
+    stats.p95 = percentile(0.95);
+    stats.p99 = percentile(0.99);
+    stats.max = *std::max_element(values.begin(), values.end());
+    return stats;
+}
+
+void WriteStats(std::FILE* file, const char* name, const BenchmarkRunner::Stats& stats, bool last) {
+    std::fprintf(file,
+                 "    \"%s\": {\"mean\": %.4f, \"p50\": %.4f, \"p90\": %.4f, \"p95\": %.4f, \"p99\": %.4f, "
+                 "\"max\": %.4f}%s\n",
+                 name, stats.mean, stats.p50, stats.p90, stats.p95, stats.p99, stats.max, last ? "" : ",");
+}
+
+/* Level of a scene with autoplay input on the first player's port; nullptr when the map is missing */
+std::unique_ptr<GameLevel> CreateLevel(std::size_t levelIndex, const BenchmarkRunner::Settings& settings,
+                                       AutoplayInput& autoplay) {
+    auto level = std::make_unique<GameLevel>(GameConfig::LEVELS[levelIndex], settings.seed, std::size_t{1});
+    if (!level->IsLoaded()) {
+        TraceLog(LOG_ERROR, "Benchmark: cannot load %s", GameConfig::LEVELS[levelIndex].data());
+        return nullptr;
+    }
+    if (settings.hasIntegrationPath) {
+        level->SetIntegrationPath(settings.integrationPath);
+    }
+    level->GetContext().input.SetSource(&autoplay);
+    return level;
+}
+
+const char* BuildType() {
+#if defined(NDEBUG)
+    return "release";
+#else
+    return "debug";
+#endif
+}
+
+bool RunScene(const BenchmarkConfig::Scene& scene, const BenchmarkRunner::Settings& settings) {
+    const std::uint64_t ticks = settings.ticks > 0 ? settings.ticks : BenchmarkConfig::DEFAULT_TICKS;
+    AutoplayInput autoplay{settings.seed};
+    const std::unique_ptr<GameLevel> level = CreateLevel(scene.levelIndex, settings, autoplay);
+    if (!level) return false;
+    const std::size_t spawned = level->SpawnExtraZombies(scene.extraZombies);
+    if (spawned < scene.extraZombies) {
+        TraceLog(LOG_WARNING, "Benchmark: %s has no walkable spans, no extra zombies", scene.name.data());
+    }
+
+    TraceLog(LOG_INFO, "Benchmark: %s, %llu ticks after %llu warm-up ticks", scene.name.data(),
+             static_cast<unsigned long long>(ticks), static_cast<unsigned long long>(BenchmarkConfig::WARMUP_TICKS));
+    Measurement measurement = Measure(*level, autoplay, ticks, settings.render);
+    const BenchmarkRunner::Stats update = Summarize(measurement.timings.update);
+    const BenchmarkRunner::Stats collision = Summarize(measurement.timings.collision);
+    const BenchmarkRunner::Stats render = Summarize(measurement.timings.render);
+    const BenchmarkRunner::Stats frame = Summarize(measurement.timings.frame);
+
+    const std::filesystem::path path = settings.outputPath.empty()
+                                           ? std::filesystem::path{"benchmark_" + std::string{scene.name} + ".json"}
+                                           : settings.outputPath;
+    std::FILE* file = std::fopen(path.string().c_str(), "w");
+    if (file == nullptr) {
+        TraceLog(LOG_ERROR, "Benchmark: cannot write %s", path.string().c_str());
+        return false;
+    }
+    std::fprintf(file, "{\n");
+    std::fprintf(file, "  \"scene\": \"%s\",\n", scene.name.data());
+    std::fprintf(file, "  \"map\": \"%s\",\n", GameConfig::LEVELS[scene.levelIndex].data());
+    std::fprintf(file, "  \"actors\": %zu,\n", measurement.actors);
+    std::fprintf(file, "  \"ticks\": %llu,\n", static_cast<unsigned long long>(ticks));
+    std::fprintf(file, "  \"warmup_ticks\": %llu,\n", static_cast<unsigned long long>(BenchmarkConfig::WARMUP_TICKS));
+    std::fprintf(file, "  \"seed\": %u,\n", static_cast<unsigned>(settings.seed));
+    std::fprintf(file, "  \"restarts\": %u,\n", static_cast<unsigned>(measurement.restarts));
+    std::fprintf(file, "  \"rendered\": %s,\n", settings.render ? "true" : "false");
+    std::fprintf(file, "  \"integrator\": \"%s\",\n", BodyIntegrator::GetPathName(level->GetIntegrationPath()));
+    std::fprintf(file, "  \"fixed_point\": %s,\n", MoveConfig::FIXED_POINT_PHYSICS ? "true" : "false");
+    std::fprintf(file, "  \"build\": \"%s\",\n", BuildType());
+    std::fprintf(file, "  \"wall_seconds\": %.3f,\n", measurement.seconds);
+    std::fprintf(file, "  \"ms_per_frame\": {\n");
+    WriteStats(file, "update", update, false);
+    WriteStats(file, "collision", collision, false);
+    WriteStats(file, "render", render, false);
+    WriteStats(file, "frame", frame, true);
+    std::fprintf(file, "  }\n}\n");
+    std::fclose(file);
+
+    TraceLog(LOG_INFO, "Benchmark: %s, %zu actors: update p50 %.3f / p99 %.3f ms, collision p50 %.3f / p99 %.3f ms, "
+             "render p50 %.3f / p99 %.3f ms, frame p50 %.3f / p99 %.3f ms -> %s", scene.name.data(),
+             measurement.actors, update.p50, update.p99, collision.p50, collision.p99, render.p50, render.p99,
+             frame.p50, frame.p99, path.string().c_str());
+    return true;
+}
+
+/* One level, restarted with more zombies for every point of the curve */
+bool RunSweep(const BenchmarkRunner::Settings& settings) {
+    const std::uint64_t ticks = settings.ticks > 0 ? settings.ticks : BenchmarkConfig::SWEEP_TICKS;
+    AutoplayInput autoplay{settings.seed};
+    const std::unique_ptr<GameLevel> level = CreateLevel(BenchmarkConfig::SWEEP_LEVEL, settings, autoplay);
+    if (!level) return false;
+
+    const std::filesystem::path path =
+        settings.outputPath.empty() ? std::filesystem::path{"benchmark_sweep.csv"} : settings.outputPath;
+    std::FILE* file = std::fopen(path.string().c_str(), "w");
+    if (file == nullptr) {
+        TraceLog(LOG_ERROR, "Benchmark: cannot write %s", path.string().c_str());
+        return false;
+    }
+    std::fprintf(file, "extra_zombies,actors,ticks,restarts,update_p50,update_p95,update_p99,collision_p50,"
+                       "collision_p95,collision_p99,render_p50,render_p95,render_p99,frame_mean,frame_p50,frame_p95,"
+                       "frame_p99,frame_max\n");
+    std::size_t spawned = 0;
+    for (const std::size_t zombies : BenchmarkConfig::SWEEP_ZOMBIES) {
+        // every point starts from the initial state, with the zombies of the previous points kept
+        level->Restart();
+        spawned += level->SpawnExtraZombies(zombies - std::min(zombies, spawned));
+        Measurement measurement = Measure(*level, autoplay, ticks, settings.render);
+        const BenchmarkRunner::Stats update = Summarize(measurement.timings.update);
+        const BenchmarkRunner::Stats collision = Summarize(measurement.timings.collision);
+        const BenchmarkRunner::Stats render = Summarize(measurement.timings.render);
+        const BenchmarkRunner::Stats frame = Summarize(measurement.timings.frame);
+        std::fprintf(file, "%zu,%zu,%llu,%u,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f\n",
+                     spawned, measurement.actors, static_cast<unsigned long long>(ticks),
+                     static_cast<unsigned>(measurement.restarts), update.p50, update.p95, update.p99, collision.p50,
+                     collision.p95, collision.p99, render.p50, render.p95, render.p99, frame.mean, frame.p50,
+                     frame.p95, frame.p99, frame.max);
+        std::fflush(file);
+        TraceLog(LOG_INFO, "Benchmark sweep: %zu actors, frame p50 %.3f ms, p99 %.3f ms", measurement.actors,
+                 frame.p50, frame.p99);
+    }
+    std::fclose(file);
+    TraceLog(LOG_INFO, "Benchmark sweep written to %s", path.string().c_str());
+    return true;
+}
+}  // namespace
+
+bool BenchmarkRunner::Run(const Settings& settings) {
+    // every frame of a large scene would count as a hitch
+    Profiler::Instance().SetHitchBudget(BenchmarkConfig::HITCH_BUDGET_MS);
+    if (settings.scene == BenchmarkConfig::SWEEP_NAME) {
+        return RunSweep(settings);
+    }
+    const auto scene = std::find_if(BenchmarkConfig::SCENES.begin(), BenchmarkConfig::SCENES.end(),
+                                    [&](const BenchmarkConfig::Scene& s) { return s.name == settings.scene; });
+    if (scene == BenchmarkConfig::SCENES.end()) {
+        std::string names;
+        for (const BenchmarkConfig::Scene& s : BenchmarkConfig::SCENES) {
+            names += std::string{s.name} + ", ";
+        }
+        TraceLog(LOG_ERROR, "Benchmark: unknown scene '%s' (scenes: %s%s)", settings.scene.c_str(), names.c_str(),
+                 BenchmarkConfig::SWEEP_NAME.data());
+        return false;
+    }
+    return RunScene(*scene, settings);
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include "body_integrator.h"
+
+/**
+ * @brief Whole-frame benchmarks of named scenes (--benchmark).
+ *
+ * A scene (BenchmarkConfig::SCENES) is a level with optionally thousands of extra
+ * zombies. The player is driven by AutoplayInput with a fixed seed on the fixed time
+ * step, and the camera follows it, so every run of a scene simulates and draws the same
+ * frames. After BenchmarkConfig::WARMUP_TICKS the wall time of every tick is measured
+ * separately for the update (actions, actors, players), the collision pass and the
+ * render, and the percentiles of each phase are written as JSON.
+ *
+ * The sweep (BenchmarkConfig::SWEEP_NAME) measures one level with a rising number of
+ * zombies (BenchmarkConfig::SWEEP_ZOMBIES) and writes one CSV line per actor count.
+ */
+class BenchmarkRunner {
+public:
+    /// Benchmark parameters.
+    struct Settings {
+        std::string scene;                /**< Scene name or BenchmarkConfig::SWEEP_NAME. */
+        std::filesystem::path outputPath; /**< Empty = benchmark_<scene>.json / benchmark_sweep.csv. */
+        std::uint64_t ticks = 0;          /**< Measured ticks per scene or sweep point; 0 = default. */
+        std::uint32_t seed = 0;           /**< Level and autoplay seed. */
+        bool render = true;               /**< Draw every tick (false with --headless: no render timings). */
+        bool hasIntegrationPath = false;
+        BodyIntegrator::Path integrationPath = BodyIntegrator::Path::Scalar;
+    };
+
+    /// Wall time percentiles of one phase in milliseconds (nearest rank).
+    struct Stats {
+        double mean = 0.0;
+        double p50 = 0.0;
+        double p90 = 0.0;
+        double p95 = 0.0;
+        double p99 = 0.0;
+        double max = 0.0;
+    };
+
+    /**
+     * @brief Run the scene or sweep and write its report. Needs an open window (GL context).
+     *
+     * @return false for an unknown scene or when the report could not be written.
+     */
+    static bool Run(const Settings& settings);
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Counter-based random stream: the n-th value is a hash of (stream key, n).
+ *
+ * The whole state is the key and a counter (8 bytes), there is no warm-up, and the
+ * stream can be saved and restored by storing the counter alone. Streams with
+ * different keys (see GameLevel::NextActorSeed) are independent, so actors never
+ * share or consume each other's numbers, whatever order they are updated in.
+ */
+class CounterRng {
+public:
+    CounterRng() = default;
+    explicit CounterRng(std::uint32_t key) noexcept : key(key) {}
+
+    /**
+     * @brief Value `index` of stream `key` (SplitMix64 finalizer over key and index).
+     */
+    static constexpr std::uint32_t At(std::uint32_t key, std::uint32_t index) noexcept {
+        std::uint64_t x = (static_cast<std::uint64_t>(key) << 32) | index;
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        x ^= x >> 31;
+        return static_cast<std::uint32_t>(x >> 32);
+    }
+
+    /** Next 32-bit value of the stream. */
+    std::uint32_t Next() noexcept { return At(key, counter++); }
+
+    /** Next value in [0, bound) (multiply-shift; bound must be > 0). */
+    std::uint32_t NextBelow(std::uint32_t bound) noexcept {
+        return static_cast<std::uint32_t>((static_cast<std::uint64_t>(Next()) * bound) >> 32);
+    }
+
+    /** Next value in [0, 1) with 24 bits of precision. */
+    float NextFloat() noexcept { return static_cast<float>(Next() >> 8) * (1.0f / 16777216.0f); }
+
+    std::uint32_t GetKey() const noexcept { return key; }
+    std::uint32_t GetCounter() const noexcept { return counter; }
+    void SetCounter(std::uint32_t value) noexcept { counter = value; }
+
+private:
+    std::uint32_t key = 0;
+    std::uint32_t counter = 0;
+};
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include "raylib.h"
+
+/**
+ * @brief Signed 16.16 fixed-point number (pixels, pixels per second, seconds).
+ *
+ * Addition and subtraction wrap like the SIMD integer lanes; multiplication rounds towards
+ * negative infinity (a 64-bit product shifted right by 16, which C++20 defines as an
+ * arithmetic shift). The results depend only on the integer inputs, so every compiler,
+ * optimisation level and SIMD path computes the same bits. Conversions from float round
+ * to the nearest step and are meant for constants and inputs; conversions to float are
+ * for the render boundary and for code that still reads float state.
+ *
+ * The range is +-32768 with a resolution of 1/65536.
+ */
+struct Fixed {
+    static constexpr int FRACTION_BITS = 16;
+    static constexpr std::int32_t ONE = 1 << FRACTION_BITS;
+    /** Largest whole number that converts without wrapping. */
+    static constexpr int MAX_INT = (1 << (31 - FRACTION_BITS)) - 1;
+
+    std::int32_t raw = 0;
+
+    static constexpr Fixed FromRaw(std::int32_t value) noexcept { return Fixed{value}; }
+    static constexpr Fixed FromInt(int value) noexcept {
+        return Fixed{static_cast<std::int32_t>(static_cast<std::uint32_t>(value) << FRACTION_BITS)};
+    }
+    /** Nearest fixed-point value (halves round away from zero). */
+    static constexpr Fixed FromFloat(float value) noexcept {
+        const double scaled = static_cast<double>(value) * ONE;
+        return Fixed{static_cast<std::int32_t>(scaled < 0.0 ? scaled - 0.5 : scaled + 0.5)};
+    }
+    constexpr float ToFloat() const noexcept { return static_cast<float>(raw) * (1.0f / ONE); }
+
+    friend constexpr Fixed operator+(Fixed a, Fixed b) noexcept {
+        return Fixed{static_cast<std::int32_t>(static_cast<std::uint32_t>(a.raw) + static_cast<std::uint32_t>(b.raw))};
+    }
+    friend constexpr Fixed operator-(Fixed a, Fixed b) noexcept {
+        return Fixed{static_cast<std::int32_t>(static_cast<std::uint32_t>(a.raw) - static_cast<std::uint32_t>(b.raw))};
+    }
+    friend constexpr Fixed operator-(Fixed a) noexcept { return Fixed{} - a; }
+    friend constexpr Fixed operator*(Fixed a, Fixed b) noexcept {
+        return Fixed{static_cast<std::int32_t>((static_cast<std::int64_t>(a.raw) * b.raw) >> FRACTION_BITS)};
+    }
+    friend constexpr bool operator==(Fixed a, Fixed b) noexcept = default;
+    friend constexpr auto operator<=>(Fixed a, Fixed b) noexcept = default;
+};
+
+/**
+ * @brief Fixed-point 2D vector (positions and displacements).
+ */
+struct FixedVec2 {
+    Fixed x;
+    Fixed y;
+
+    static constexpr FixedVec2 FromVector2(Vector2 v) noexcept { return {Fixed::FromFloat(v.x), Fixed::FromFloat(v.y)}; }
+    constexpr Vector2 ToVector2() const noexcept { return {x.ToFloat(), y.ToFloat()}; }
+
+    friend constexpr FixedVec2 operator+(FixedVec2 a, FixedVec2 b) noexcept { return {a.x + b.x, a.y + b.y}; }
+    friend constexpr FixedVec2 operator-(FixedVec2 a, FixedVec2 b) noexcept { return {a.x - b.x, a.y - b.y}; }
+    friend constexpr bool operator==(FixedVec2 a, FixedVec2 b) noexcept = default;
+};
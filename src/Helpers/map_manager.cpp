@@ -0,0 +1,51 @@
+// raytmx is header-only: the map loader owns its implementation
+#define RAYTMX_IMPLEMENTATION
+#include "raytmx.h"
+#include "map_manager.h"
+#include "asset_manager.h"
+#include "profiler.h"
+
+MapManager& MapManager::Instance() {
+    static MapManager instance;
+    return instance;
+}
+
+TmxMap* MapManager::GetMap(std::string_view fileName) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = cache.find(fileName);
+    if (it != cache.end()) {
+        return it->second;
+    }
+    if (std::this_thread::get_id() != windowThread || !IsWindowReady()) {
+        TraceLog(LOG_ERROR, "MapManager: %.*s was not preloaded on the window thread",
+                 static_cast<int>(fileName.size()), fileName.data());
+        return nullptr;
+    }
+
+    PROFILE_ZONE("MapLoad");
+    PROFILE_EVENT("MapLoad", fileName);
+    auto fullPath = AssetManager::GetAssetPath(std::string(fileName));
+    TmxMap* map = LoadTMX(fullPath.string().c_str());
+    if (map == nullptr) {
+        // failures are not cached so a later request logs again
+        TraceLog(LOG_ERROR, "MapManager: Failed to load TMX map: %s", fullPath.string().c_str());
+        return nullptr;
+    }
+    cache.emplace(std::string(fileName), map);
+    return map;
+}
+
+void MapManager::UnloadAll() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& kv : cache) {
+        UnloadTMX(kv.second);
+    }
+    cache.clear();
+}
+
+MapManager::~MapManager() {
+    // Same fallback as TextureManager: prefer an explicit UnloadAll() while the window is open
+    if (!cache.empty()) {
+        UnloadAll();
+    }
+}
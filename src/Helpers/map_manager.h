@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include "raytmx.h"
+
+/**
+ * @brief Process-wide cache of loaded TMX maps shared by all worlds, keyed by file name.
+ *
+ * LoadTMX also loads the tilesets' textures, which needs the GL context, so maps are
+ * only loaded on the thread that created the manager (the window thread). Any other
+ * thread (e.g. a headless world) gets the cached map, which must have been preloaded
+ * with GetMap() on the window thread. The simulation only reads a map; the animated
+ * tiles are advanced when the window thread draws it.
+ *
+ * Returned pointers stay valid until UnloadAll(), which should be called once at
+ * shutdown, before TextureManager::UnloadAll() and CloseWindow().
+ */
+class MapManager {
+public:
+    static MapManager& Instance();
+
+    /**
+     * @brief Get a map for the given file (relative asset path or name).
+     * On the window thread it is loaded and cached if not loaded yet.
+     *
+     * @param fileName File name/path identifying the map (used as key).
+     * @return TmxMap* Non-owning pointer to the cached map, or nullptr when it could not
+     *         be loaded or another thread asked for a map that was not preloaded.
+     */
+    TmxMap* GetMap(std::string_view fileName);
+
+    /**
+     * @brief Unload and clear all cached maps. Call before CloseWindow().
+     */
+    void UnloadAll();
+
+private:
+    MapManager() = default;
+    ~MapManager();
+    MapManager(const MapManager&) = delete;
+    MapManager& operator=(const MapManager&) = delete;
+
+    // Transparent hash so lookups by string_view do not build a temporary std::string
+    struct FileNameHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view name) const noexcept { return std::hash<std::string_view>{}(name); }
+    };
+
+    std::mutex mutex;
+    std::thread::id windowThread = std::this_thread::get_id();
+    std::unordered_map<std::string, TmxMap*, FileNameHash, std::equal_to<>> cache;  // keyed by file name
+};
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Resident set size of the current process in bytes (0 when the platform does not report it).
+ *
+ * Covers everything the process keeps in memory: the heap, raylib's and the driver's
+ * allocations and loaded images, so it also shows leaks the allocation tracker cannot see.
+ */
+std::uint64_t GetResidentMemoryBytes();
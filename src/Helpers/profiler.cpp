@@ -0,0 +1,396 @@
+#include "profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cinttypes>
+#include <cstdio>
+#include <string>
+#include "raylib.h"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+// All timestamps are taken relative to this point so they fit trace viewers comfortably
+const Clock::time_point PROFILER_EPOCH = Clock::now();
+
+constexpr float NANOS_PER_MILLI = 1.0e6f;
+constexpr double NANOS_PER_MICRO = 1.0e3;
+constexpr const char* FRAME_ZONE_NAME = "Frame";
+
+// Overlay layout (screen pixels)
+constexpr int OVERLAY_X = 10;
+constexpr int OVERLAY_Y = 34;  // below DrawFPS
+constexpr int ROW_HEIGHT = 12;
+constexpr int FONT_SIZE = 10;
+constexpr int NAME_COLUMN = 130;
+constexpr int VALUE_COLUMN = 60;
+constexpr int ALLOC_COLUMN = 60;
+constexpr int INDENT = 8;
+constexpr int PADDING = 4;
+}  // namespace
+
+Profiler& Profiler::Instance() {
+    static Profiler instance;
+    return instance;
+}
+
+Profiler::Profiler() {
+    ownerThread = true;
+    frameZones.reserve(64);
+    openZones.reserve(16);
+    frameEventList.reserve(16);
+    // zones first seen mid-game (e.g. a level reset) must not grow the history while strict alloc checks run
+    zones.reserve(64);
+    for (auto& record : recentFrames) {
+        record.zones.reserve(64);
+        record.events.reserve(16);
+    }
+}
+
+std::int64_t Profiler::Now() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - PROFILER_EPOCH).count();
+}
+
+void Profiler::BeginFrame() {
+    frameZones.clear();
+    openZones.clear();
+    frameEventList.clear();
+    counters.fill(0);
+    frameStartAllocs = AllocTracker::GetTotals();
+    frameStart = Now();
+}
+
+void Profiler::BeginZone(const char* name) {
+    if (!ownerThread) return;
+    const AllocCounts allocs = AllocTracker::GetThreadTotals();
+    openZones.push_back(frameZones.size());
+    frameZones.push_back(
+        {name, Now(), 0, static_cast<std::uint32_t>(openZones.size() - 1), allocs.allocations, allocs.bytes});
+}
+
+void Profiler::EndZone() {
+    if (!ownerThread || openZones.empty()) return;
+    ZoneEvent& zone = frameZones[openZones.back()];
+    zone.end = Now();
+    CloseZoneAllocations(zone);
+    openZones.pop_back();
+}
+
+void Profiler::CloseZoneAllocations(ZoneEvent& zone) {
+    const AllocCounts allocs = AllocTracker::GetThreadTotals();
+    zone.allocations = allocs.allocations - zone.allocations;
+    zone.allocatedBytes = allocs.bytes - zone.allocatedBytes;
+}
+
+void Profiler::AddEvent(const char* name, std::string_view detail) {
+    if (!ownerThread) return;
+    FrameEvent& event = frameEventList.emplace_back();
+    event.name = name;
+    event.time = Now();
+    const std::size_t length = std::min(detail.size(), event.detail.size() - 1);
+    detail.copy(event.detail.data(), length);
+    event.detail[length] = '\0';
+    // details end up in JSON strings; keep them free of characters that would need escaping
+    std::replace_if(
+        event.detail.begin(), event.detail.begin() + static_cast<std::ptrdiff_t>(length),
+        [](char c) { return c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20; }, '/');
+}
+
+Profiler::ZoneHistory& Profiler::HistoryFor(const ZoneEvent& event) {
+    for (auto& zone : zones) {
+        if (zone.name == event.name) return zone;
+    }
+    ZoneHistory& zone = zones.emplace_back();
+    zone.name = event.name;
+    zone.depth = event.depth;
+    return zone;
+}
+
+void Profiler::EndFrame() {
+    const std::int64_t frameEnd = Now();
+    // zones left open (e.g. frame ended from inside a scope) are clipped to the frame end
+    for (std::size_t index : openZones) {
+        frameZones[index].end = frameEnd;
+        CloseZoneAllocations(frameZones[index]);
+    }
+    openZones.clear();
+
+    historyCursor = (historyCursor + 1) % ProfilerConfig::HISTORY_FRAMES;
+    frameMillis[historyCursor] = static_cast<float>(frameEnd - frameStart) / NANOS_PER_MILLI;
+    for (auto& zone : zones) {
+        zone.millis[historyCursor] = 0.0f;
+        zone.allocations = 0;
+    }
+    // A zone entered several times per frame (e.g. per texture load) accumulates
+    for (const ZoneEvent& event : frameZones) {
+        ZoneHistory& zone = HistoryFor(event);
+        zone.millis[historyCursor] += static_cast<float>(event.end - event.start) / NANOS_PER_MILLI;
+        zone.allocations += event.allocations;
+    }
+    const AllocCounts frameEndAllocs = AllocTracker::GetTotals();
+    counters[static_cast<std::size_t>(ProfileCounter::Allocations)] =
+        static_cast<std::int64_t>(frameEndAllocs.allocations - frameStartAllocs.allocations);
+    counters[static_cast<std::size_t>(ProfileCounter::AllocatedBytes)] =
+        static_cast<std::int64_t>(frameEndAllocs.bytes - frameStartAllocs.bytes);
+    lastCounters = counters;
+
+    // Rolling frame-time window for the percentiles
+    const float frameDuration = frameMillis[historyCursor];
+    statsMillis[statsCursor] = frameDuration;
+    statsCursor = (statsCursor + 1) % statsMillis.size();
+    statsCount = std::min(statsCount + 1, statsMillis.size());
+
+    // Keep the frame for hitch reports; vectors are reused so this does not allocate once warm
+    FrameRecord& record = recentFrames[frameIndex % recentFrames.size()];
+    record.index = frameIndex;
+    record.start = frameStart;
+    record.end = frameEnd;
+    record.zones.assign(frameZones.begin(), frameZones.end());
+    record.events.assign(frameEventList.begin(), frameEventList.end());
+    record.counters = counters;
+
+    if (frameDuration > hitchBudgetMillis) {
+        ++hitchCount;
+        // one report per context window: a burst of slow frames ends up in the same file
+        const bool reportDue = hitchReportsWritten == 0 || frameIndex - lastReportedFrame >= recentFrames.size();
+        if (reportDue && hitchReportsWritten < ProfilerConfig::MAX_HITCH_REPORTS) {
+            WriteHitchReport(record);
+        } else {
+            TraceLog(LOG_WARNING, "Profiler: hitch in frame %llu: %.2f ms (budget %.2f ms)",
+                     static_cast<unsigned long long>(frameIndex), frameDuration, hitchBudgetMillis);
+        }
+    }
+
+    if (traceFramesLeft > 0) {
+        traceEvents.push_back({FRAME_ZONE_NAME, frameStart, frameEnd, 0,
+                               frameEndAllocs.allocations - frameStartAllocs.allocations,
+                               frameEndAllocs.bytes - frameStartAllocs.bytes});
+        for (ZoneEvent event : frameZones) {
+            ++event.depth;
+            traceEvents.push_back(event);
+        }
+        traceMarkers.insert(traceMarkers.end(), frameEventList.begin(), frameEventList.end());
+        traceCounters.push_back({frameEnd, counters});
+        if (--traceFramesLeft == 0) {
+            WriteTrace();
+        }
+    }
+    ++frameIndex;
+}
+
+FrameTimeStats Profiler::GetFrameTimeStats() const {
+    FrameTimeStats stats;
+    stats.frames = statsCount;
+    if (statsCount == 0) return stats;
+
+    std::array<float, ProfilerConfig::STATS_FRAMES> sorted;
+    std::copy_n(statsMillis.begin(), statsCount, sorted.begin());
+    const auto begin = sorted.begin();
+    const auto end = sorted.begin() + static_cast<std::ptrdiff_t>(statsCount);
+    // nearest-rank percentile
+    auto percentile = [&](float p) {
+        const std::size_t rank = static_cast<std::size_t>(std::ceil(p * static_cast<float>(statsCount)));
+        const auto nth = begin + static_cast<std::ptrdiff_t>(std::clamp<std::size_t>(rank, 1, statsCount) - 1);
+        std::nth_element(begin, nth, end);
+        return *nth;
+    };
+    stats.p50 = percentile(0.50f);
+    stats.p95 = percentile(0.95f);
+    stats.p99 = percentile(0.99f);
+    stats.max = *std::max_element(begin, end);
+    return stats;
+}
+
+void Profiler::LogFrameTimeStats() const {
+    const FrameTimeStats stats = GetFrameTimeStats();
+    TraceLog(LOG_INFO, "Profiler: last %zu frames p50 %.2f ms, p95 %.2f ms, p99 %.2f ms, max %.2f ms; %llu hitches",
+             stats.frames, stats.p50, stats.p95, stats.p99, stats.max, static_cast<unsigned long long>(hitchCount));
+}
+
+void Profiler::WriteHitchReport(const FrameRecord& hitch) {
+    AllocTracker::AllowScope allowAllocations;
+    const std::string fileName =
+        std::string(ProfilerConfig::HITCH_REPORT_PREFIX) + std::to_string(hitch.index) + ".txt";
+    const float hitchMillis = static_cast<float>(hitch.end - hitch.start) / NANOS_PER_MILLI;
+    std::FILE* file = std::fopen(fileName.c_str(), "w");
+    if (file == nullptr) {
+        TraceLog(LOG_ERROR, "Profiler: cannot write hitch report %s", fileName.c_str());
+        return;
+    }
+    ++hitchReportsWritten;
+    lastReportedFrame = hitch.index;
+
+    const FrameTimeStats stats = GetFrameTimeStats();
+    std::fprintf(file, "Hitch in frame %llu: %.2f ms (budget %.2f ms)\n", static_cast<unsigned long long>(hitch.index),
+                 hitchMillis, hitchBudgetMillis);
+    std::fprintf(file, "Last %zu frames: p50 %.2f ms, p95 %.2f ms, p99 %.2f ms, max %.2f ms\n\n", stats.frames,
+                 stats.p50, stats.p95, stats.p99, stats.max);
+
+    // Oldest frame first; times inside a frame are relative to its start
+    const std::size_t available = std::min<std::size_t>(hitch.index + 1, recentFrames.size());
+    for (std::size_t back = available; back-- > 0;) {
+        const FrameRecord& frame = recentFrames[(hitch.index - back) % recentFrames.size()];
+        std::fprintf(file, "--- frame %llu: %.2f ms%s\n", static_cast<unsigned long long>(frame.index),
+                     static_cast<float>(frame.end - frame.start) / NANOS_PER_MILLI,
+                     frame.index == hitch.index ? "  <-- HITCH" : "");
+        std::fputs("  counters:", file);
+        for (std::size_t i = 0; i < frame.counters.size(); ++i) {
+            std::fprintf(file, " %s=%" PRId64, GetCounterName(static_cast<ProfileCounter>(i)), frame.counters[i]);
+        }
+        std::fputc('\n', file);
+        for (const FrameEvent& event : frame.events) {
+            std::fprintf(file, "  event @%.3f ms: %s %s\n", static_cast<float>(event.time - frame.start) / NANOS_PER_MILLI,
+                         event.name, event.detail.data());
+        }
+        for (const ZoneEvent& zone : frame.zones) {
+            std::fprintf(file, "  %*s%-16s %8.3f ms (@%.3f) %llu allocs, %llu bytes\n", static_cast<int>(zone.depth) * 2,
+                         "", zone.name, static_cast<float>(zone.end - zone.start) / NANOS_PER_MILLI,
+                         static_cast<float>(zone.start - frame.start) / NANOS_PER_MILLI,
+                         static_cast<unsigned long long>(zone.allocations),
+                         static_cast<unsigned long long>(zone.allocatedBytes));
+        }
+    }
+    std::fclose(file);
+
+    TraceLog(LOG_WARNING, "Profiler: hitch in frame %llu: %.2f ms (budget %.2f ms), report written to %s",
+             static_cast<unsigned long long>(hitch.index), hitchMillis, hitchBudgetMillis, fileName.c_str());
+}
+
+void Profiler::StartTraceCapture(const std::filesystem::path& path, std::size_t frameCount) {
+    if (frameCount == 0 || IsCapturingTrace()) return;
+    AllocTracker::AllowScope allowAllocations;
+    tracePath = path;
+    traceFramesLeft = frameCount;
+    traceEvents.clear();
+    traceCounters.clear();
+    traceMarkers.clear();
+    // reserve up front so capturing does not reallocate while frames are measured
+    traceEvents.reserve(frameCount * (frameZones.capacity() + 1));
+    traceCounters.reserve(frameCount);
+    TraceLog(LOG_INFO, "Profiler: capturing %zu frames to %s", frameCount, path.string().c_str());
+}
+
+void Profiler::WriteTrace() {
+    AllocTracker::AllowScope allowAllocations;
+    std::FILE* file = std::fopen(tracePath.string().c_str(), "w");
+    if (file == nullptr) {
+        TraceLog(LOG_ERROR, "Profiler: cannot write trace %s", tracePath.string().c_str());
+        return;
+    }
+
+    // Chrome trace_event format: complete events ("X") for zones, counter events ("C") per frame
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", file);
+    bool first = true;
+    for (const ZoneEvent& event : traceEvents) {
+        std::fprintf(file,
+                     "%s{\"name\":\"%s\",\"cat\":\"game\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":1,"
+                     "\"args\":{\"allocs\":%llu,\"allocBytes\":%llu}}",
+                     first ? "" : ",\n", event.name, event.start / NANOS_PER_MICRO,
+                     (event.end - event.start) / NANOS_PER_MICRO, static_cast<unsigned long long>(event.allocations),
+                     static_cast<unsigned long long>(event.allocatedBytes));
+        first = false;
+    }
+    for (const FrameEvent& marker : traceMarkers) {
+        std::fprintf(file,
+                     "%s{\"name\":\"%s\",\"cat\":\"event\",\"ph\":\"i\",\"s\":\"g\",\"ts\":%.3f,\"pid\":1,\"tid\":1,"
+                     "\"args\":{\"detail\":\"%s\"}}",
+                     first ? "" : ",\n", marker.name, marker.time / NANOS_PER_MICRO, marker.detail.data());
+        first = false;
+    }
+    for (const TraceCounterSample& sample : traceCounters) {
+        std::fprintf(file, "%s{\"name\":\"Counters\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":1,\"args\":{", first ? "" : ",\n",
+                     sample.timestamp / NANOS_PER_MICRO);
+        for (std::size_t i = 0; i < sample.values.size(); ++i) {
+            std::fprintf(file, "%s\"%s\":%" PRId64, i == 0 ? "" : ",", GetCounterName(static_cast<ProfileCounter>(i)),
+                         sample.values[i]);
+        }
+        std::fputs("}}", file);
+        first = false;
+    }
+    std::fputs("\n]}\n", file);
+    std::fclose(file);
+
+    TraceLog(LOG_INFO, "Profiler: wrote %zu zone events to %s", traceEvents.size(), tracePath.string().c_str());
+    traceEvents.clear();
+    traceCounters.clear();
+    traceMarkers.clear();
+}
+
+const char* Profiler::GetCounterName(ProfileCounter counter) {
+    switch (counter) {
+        case ProfileCounter::Actors:
+            return "Actors";
+        case ProfileCounter::Actions:
+            return "Actions";
+        case ProfileCounter::CollisionPairs:
+            return "CollisionPairs";
+        case ProfileCounter::DrawCalls:
+            return "DrawCalls";
+        case ProfileCounter::Allocations:
+            return "Allocations";
+        case ProfileCounter::AllocatedBytes:
+            return "AllocatedBytes";
+        case ProfileCounter::TickSensors:
+            return "TickSensors";
+        case ProfileCounter::TickAnimation:
+            return "TickAnimation";
+        case ProfileCounter::TickAI:
+            return "TickAI";
+        case ProfileCounter::RollbackTicks:
+            return "RollbackTicks";
+        case ProfileCounter::Events:
+            return "Events";
+        case ProfileCounter::Count:
+            break;
+    }
+    return "?";
+}
+
+void Profiler::DrawOverlay() const {
+    if (!overlayVisible) return;
+
+    constexpr int graphWidth = static_cast<int>(ProfilerConfig::HISTORY_FRAMES);
+    const float budgetMillis = 1000.0f / Config::TARGET_FPS;
+    const int rows = 2 + static_cast<int>(zones.size()) + static_cast<int>(ProfileCounter::Count);
+    DrawRectangle(OVERLAY_X, OVERLAY_Y, NAME_COLUMN + VALUE_COLUMN + graphWidth + ALLOC_COLUMN + 2 * PADDING,
+                  rows * ROW_HEIGHT + 2 * PADDING, Fade(BLACK, 0.7f));
+
+    // One row: name, last value and a bar graph of the history scaled to the frame budget
+    auto drawRow = [&](int row, const char* name, std::uint32_t depth,
+                       const std::array<float, ProfilerConfig::HISTORY_FRAMES>& history, std::uint64_t allocations) {
+        const int y = OVERLAY_Y + PADDING + row * ROW_HEIGHT;
+        const int x = OVERLAY_X + PADDING;
+        DrawText(name, x + static_cast<int>(depth) * INDENT, y, FONT_SIZE, RAYWHITE);
+        DrawText(TextFormat("%6.2f ms", history[historyCursor]), x + NAME_COLUMN, y, FONT_SIZE, RAYWHITE);
+        const int graphX = x + NAME_COLUMN + VALUE_COLUMN;
+        for (int i = 0; i < graphWidth; ++i) {
+            // oldest sample on the left
+            const float value = history[(historyCursor + 1 + i) % ProfilerConfig::HISTORY_FRAMES];
+            const int height = static_cast<int>(std::min(value / budgetMillis, 1.0f) * (ROW_HEIGHT - 2));
+            if (height > 0) {
+                DrawLine(graphX + i, y + ROW_HEIGHT - 1, graphX + i, y + ROW_HEIGHT - 1 - height,
+                         value > budgetMillis ? RED : GREEN);
+            }
+        }
+        if (allocations > 0) {
+            DrawText(TextFormat("%llu alloc", static_cast<unsigned long long>(allocations)), graphX + graphWidth + PADDING,
+                     y, FONT_SIZE, RED);
+        }
+    };
+
+    int row = 0;
+    drawRow(row++, FRAME_ZONE_NAME, 0, frameMillis,
+            static_cast<std::uint64_t>(lastCounters[static_cast<std::size_t>(ProfileCounter::Allocations)]));
+    for (const auto& zone : zones) {
+        drawRow(row++, zone.name, zone.depth + 1, zone.millis, zone.allocations);
+    }
+    const FrameTimeStats stats = GetFrameTimeStats();
+    DrawText(TextFormat("p50 %.2f  p95 %.2f  p99 %.2f  max %.2f ms", stats.p50, stats.p95, stats.p99, stats.max),
+             OVERLAY_X + PADDING, OVERLAY_Y + PADDING + row++ * ROW_HEIGHT, FONT_SIZE, SKYBLUE);
+    for (std::size_t i = 0; i < lastCounters.size(); ++i) {
+        const int y = OVERLAY_Y + PADDING + row++ * ROW_HEIGHT;
+        DrawText(TextFormat("%s: %lld", GetCounterName(static_cast<ProfileCounter>(i)),
+                            static_cast<long long>(lastCounters[i])),
+                 OVERLAY_X + PADDING, y, FONT_SIZE, YELLOW);
+    }
+}
@@ -0,0 +1,271 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+#include "config.hpp"
+#include "alloc_tracker.h"
+
+/**
+ * @brief Per-frame counters shown by the profiler overlay and written to traces.
+ */
+enum class ProfileCounter : std::uint8_t {
+    Actors,         /**< Actors updated this frame (including the players). */
+    Actions,        /**< Actions performed this frame. */
+    CollisionPairs, /**< Actor pairs tested by the collision system. */
+    DrawCalls,      /**< Sprite / tilemap / HUD draw submissions. */
+    Allocations,    /**< Heap allocations (all threads; needs GAME_ALLOC_TRACKING). */
+    AllocatedBytes, /**< Bytes requested by those allocations. */
+    TickSensors,    /**< Actors that ran the Sensors tick group this frame. */
+    TickAnimation,  /**< Actors that ran the Animation tick group this frame. */
+    TickAI,         /**< Actors that ran the AI tick group this frame. */
+    RollbackTicks,  /**< Ticks resimulated by netplay rollback this frame. */
+    Events,         /**< Events dispatched by the world's event bus. */
+    Count
+};
+
+/**
+ * @brief Rolling frame-time percentiles in milliseconds.
+ */
+struct FrameTimeStats {
+    float p50 = 0.0f;
+    float p95 = 0.0f;
+    float p99 = 0.0f;
+    float max = 0.0f;
+    std::size_t frames = 0; /**< Number of frames the statistics cover. */
+};
+
+/**
+ * @brief Lightweight scoped frame profiler.
+ *
+ * Zones are recorded with `PROFILE_ZONE("Name")` (RAII, nestable) and grouped per
+ * frame between `BeginFrame` and `EndFrame`. Zone names must be string literals:
+ * they are identified by pointer and never copied. The profiler keeps a rolling
+ * history of per-zone milliseconds for the in-game overlay and can capture a number
+ * of frames into a Chrome `trace_event` JSON file (open with chrome://tracing or
+ * Perfetto).
+ *
+ * Frame times also feed rolling percentiles and a hitch detector: when a frame
+ * exceeds the hitch budget, the zones, counters and events (`PROFILE_EVENT`: spawns,
+ * resets, texture loads, ...) of the last `HITCH_CONTEXT_FRAMES` frames are written
+ * to a text report so the hitch can be diagnosed after the fact.
+ *
+ * Only the thread that created the profiler (the main thread) records; zones, counters
+ * and events from other threads (job workers, the pipelined simulation thread) are
+ * ignored.
+ *
+ * When the build does not define `GAME_PROFILER` all PROFILE_* macros expand to
+ * nothing, so instrumented code carries no cost.
+ */
+class Profiler {
+public:
+    static Profiler& Instance();
+
+    /**
+     * @brief Start a new frame; resets the per-frame counters.
+     */
+    void BeginFrame();
+
+    /**
+     * @brief Finish the frame: aggregate zones into the history and feed an active trace capture.
+     */
+    void EndFrame();
+
+    /**
+     * @brief Open a zone; must be balanced by EndZone (use ProfileZone / PROFILE_ZONE).
+     *
+     * @param name String literal naming the zone.
+     */
+    void BeginZone(const char* name);
+
+    /**
+     * @brief Close the most recently opened zone.
+     */
+    void EndZone();
+
+    /**
+     * @brief Add to a per-frame counter.
+     */
+    void AddCount(ProfileCounter counter, std::int64_t amount = 1) {
+        if (ownerThread) counters[static_cast<std::size_t>(counter)] += amount;
+    }
+
+    /**
+     * @brief Set a per-frame counter to an absolute value.
+     */
+    void SetCount(ProfileCounter counter, std::int64_t value) {
+        if (ownerThread) counters[static_cast<std::size_t>(counter)] = value;
+    }
+
+    /**
+     * @brief Record a notable event in the current frame.
+     *
+     * @param name String literal naming the event.
+     * @param detail Optional detail (file name, actor type, ...); copied and truncated.
+     */
+    void AddEvent(const char* name, std::string_view detail = {});
+
+    /**
+     * @brief Percentiles over the last `STATS_FRAMES` completed frames.
+     */
+    FrameTimeStats GetFrameTimeStats() const;
+
+    /**
+     * @brief Log the current frame-time percentiles and the number of hitches seen.
+     */
+    void LogFrameTimeStats() const;
+
+    /**
+     * @brief Frame duration above which a hitch report is written.
+     */
+    void SetHitchBudget(float millis) noexcept { hitchBudgetMillis = millis; }
+
+    float GetHitchBudget() const noexcept { return hitchBudgetMillis; }
+
+    /**
+     * @brief Show or hide the overlay.
+     */
+    void ToggleOverlay() noexcept { overlayVisible = !overlayVisible; }
+
+    bool IsOverlayVisible() const noexcept { return overlayVisible; }
+
+    /**
+     * @brief Draw per-zone timings, counters and rolling graphs of the last completed frames.
+     *
+     * Must be called between BeginDrawing and EndDrawing; does nothing while hidden.
+     */
+    void DrawOverlay() const;
+
+    /**
+     * @brief Record the next frames and write them as Chrome trace JSON when done.
+     *
+     * @param path Output file.
+     * @param frameCount Number of frames to capture.
+     */
+    void StartTraceCapture(const std::filesystem::path& path, std::size_t frameCount);
+
+    bool IsCapturingTrace() const noexcept { return traceFramesLeft > 0; }
+
+    /**
+     * @brief Name of a counter as shown in the overlay and trace.
+     */
+    static const char* GetCounterName(ProfileCounter counter);
+
+private:
+    Profiler();
+
+    /* Closed zone of the current frame; times are nanoseconds since profiler start. Allocation
+       fields hold the thread's totals while the zone is open and the zone's own counts after. */
+    struct ZoneEvent {
+        const char* name;
+        std::int64_t start;
+        std::int64_t end;
+        std::uint32_t depth;
+        std::uint64_t allocations;
+        std::uint64_t allocatedBytes;
+    };
+
+    /* Rolling per-zone statistics (one entry per distinct zone name) */
+    struct ZoneHistory {
+        const char* name = nullptr;
+        std::uint32_t depth = 0;  // nesting depth of the first occurrence, used for indentation
+        std::array<float, ProfilerConfig::HISTORY_FRAMES> millis{};
+        std::uint64_t allocations = 0; /**< Allocations inside the zone during the last frame. */
+    };
+
+    /* Notable event of a frame; detail is stored inline so recording never allocates */
+    struct FrameEvent {
+        const char* name;
+        std::int64_t time;
+        std::array<char, 48> detail;
+    };
+
+    /* Everything recorded for one completed frame, kept for hitch reports */
+    struct FrameRecord {
+        std::uint64_t index = 0;
+        std::int64_t start = 0;
+        std::int64_t end = 0;
+        std::vector<ZoneEvent> zones;
+        std::vector<FrameEvent> events;
+        std::array<std::int64_t, static_cast<std::size_t>(ProfileCounter::Count)> counters{};
+    };
+
+    struct TraceCounterSample {
+        std::int64_t timestamp;
+        std::array<std::int64_t, static_cast<std::size_t>(ProfileCounter::Count)> values;
+    };
+
+    std::int64_t Now() const;
+    // Turn the totals stored in an open zone into the zone's own allocation counts
+    static void CloseZoneAllocations(ZoneEvent& zone);
+    ZoneHistory& HistoryFor(const ZoneEvent& event);
+    void WriteTrace();
+    void WriteHitchReport(const FrameRecord& hitch);
+
+    static inline thread_local bool ownerThread = false; /**< Set on the thread that created the profiler. */
+
+    std::int64_t frameStart = 0;
+    AllocCounts frameStartAllocs; /**< Process allocation totals at BeginFrame. */
+    std::vector<ZoneEvent> frameZones;   /**< Zones closed during the current frame. */
+    std::vector<std::size_t> openZones;   /**< Indices into frameZones of still open zones. */
+    std::array<std::int64_t, static_cast<std::size_t>(ProfileCounter::Count)> counters{};
+    std::array<std::int64_t, static_cast<std::size_t>(ProfileCounter::Count)> lastCounters{};
+
+    std::vector<FrameEvent> frameEventList; /**< Events recorded during the current frame. */
+    std::uint64_t frameIndex = 0;
+
+    std::vector<ZoneHistory> zones;                               /**< Ordered by first appearance. */
+    std::array<float, ProfilerConfig::HISTORY_FRAMES> frameMillis{}; /**< Whole-frame duration history. */
+    std::size_t historyCursor = 0; /**< Slot of the most recently completed frame. */
+
+    std::array<float, ProfilerConfig::STATS_FRAMES> statsMillis{}; /**< Frame times for percentiles. */
+    std::size_t statsCount = 0;
+    std::size_t statsCursor = 0;
+
+    std::array<FrameRecord, ProfilerConfig::HITCH_CONTEXT_FRAMES> recentFrames; /**< Ring of completed frames. */
+    float hitchBudgetMillis = ProfilerConfig::HITCH_BUDGET_MS;
+    std::uint64_t hitchCount = 0;
+    std::size_t hitchReportsWritten = 0;
+    std::uint64_t lastReportedFrame = 0;
+
+    bool overlayVisible = false;
+
+    std::filesystem::path tracePath;
+    std::size_t traceFramesLeft = 0;
+    std::vector<ZoneEvent> traceEvents;
+    std::vector<FrameEvent> traceMarkers;
+    std::vector<TraceCounterSample> traceCounters;
+};
+
+/**
+ * @brief RAII helper opening a profiler zone for the enclosing scope.
+ */
+class ProfileZone {
+public:
+    explicit ProfileZone(const char* name) { Profiler::Instance().BeginZone(name); }
+    ~ProfileZone() { Profiler::Instance().EndZone(); }
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+};
+
+#if defined(GAME_PROFILER)
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(name) ProfileZone PROFILE_CONCAT(profileZone, __LINE__){name}
+#define PROFILE_COUNT(counter, amount) Profiler::Instance().AddCount(ProfileCounter::counter, (amount))
+#define PROFILE_SET_COUNT(counter, value) Profiler::Instance().SetCount(ProfileCounter::counter, (value))
+#define PROFILE_BEGIN_FRAME() Profiler::Instance().BeginFrame()
+#define PROFILE_END_FRAME() Profiler::Instance().EndFrame()
+#define PROFILE_DRAW_OVERLAY() Profiler::Instance().DrawOverlay()
+#define PROFILE_EVENT(...) Profiler::Instance().AddEvent(__VA_ARGS__)
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#define PROFILE_COUNT(counter, amount) ((void)0)
+#define PROFILE_SET_COUNT(counter, value) ((void)0)
+#define PROFILE_BEGIN_FRAME() ((void)0)
+#define PROFILE_END_FRAME() ((void)0)
+#define PROFILE_DRAW_OVERLAY() ((void)0)
+#define PROFILE_EVENT(...) ((void)0)
+#endif
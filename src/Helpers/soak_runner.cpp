@@ -0,0 +1,223 @@
+#include "soak_runner.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <system_error>
+#include <thread>
+#include "config.hpp"
+#include "raylib.h"
+#if !defined(_WIN32)
+#include <sys/wait.h>
+#endif
+
+namespace {
+/// How a metric is read from a sample and judged.
+struct Metric {
+    const char* name;
+    const char* unit;
+    double scale; /**< Sample value to display units. */
+    double absoluteLimit;
+    double ratioLimit;
+    double (*read)(const SoakSample&);
+};
+
+constexpr double MEGABYTE = 1024.0 * 1024.0;
+
+constexpr Metric METRICS[] = {
+    {"frame time", " ms", 1.0, SoakConfig::FRAME_TIME_GROWTH_MS, SoakConfig::FRAME_TIME_GROWTH_RATIO,
+     [](const SoakSample& s) { return s.meanFrameMs; }},
+    {"resident memory", " MB", 1.0 / MEGABYTE, SoakConfig::RSS_GROWTH_BYTES / MEGABYTE, SoakConfig::RSS_GROWTH_RATIO,
+     [](const SoakSample& s) { return static_cast<double>(s.residentBytes); }},
+    {"actions", "", 1.0, SoakConfig::ACTION_GROWTH, SoakConfig::ACTION_GROWTH_RATIO,
+     [](const SoakSample& s) { return static_cast<double>(s.actions); }},
+    {"collision listeners", "", 1.0, SoakConfig::LISTENER_GROWTH, 0.0,
+     [](const SoakSample& s) { return static_cast<double>(s.collisionListeners); }},
+    {"event handlers", "", 1.0, SoakConfig::LISTENER_GROWTH, 0.0,
+     [](const SoakSample& s) { return static_cast<double>(s.eventHandlers); }},
+    {"cached textures", "", 1.0, SoakConfig::LISTENER_GROWTH, 0.0,
+     [](const SoakSample& s) { return static_cast<double>(s.textures); }},
+};
+
+std::string Quote(const std::string& argument) {
+#if defined(_WIN32)
+    return '"' + argument + '"';
+#else
+    std::string quoted = "'";
+    for (const char c : argument) {
+        quoted += (c == '\'') ? std::string("'\\''") : std::string(1, c);
+    }
+    return quoted + "'";
+#endif
+}
+
+/* Exit code of a process started with std::system */
+int ExitCode(int status) {
+#if defined(_WIN32)
+    return status;
+#else
+    return (status != -1 && WIFEXITED(status)) ? WEXITSTATUS(status) : -1;
+#endif
+}
+
+std::filesystem::path RunFile(const std::filesystem::path& dir, std::size_t run, const char* extension) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "run_%03zu.%s", run, extension);
+    return dir / name;
+}
+
+std::string BuildCommand(const SoakRunner::Settings& settings, std::size_t run, std::size_t jobThreads) {
+    std::vector<std::string> arguments{
+        "--headless",
+        "--ticks=" + std::to_string(settings.ticks),
+        "--soak-report=" + RunFile(settings.outputDir, run, "csv").string(),
+        "--job-threads=" + std::to_string(jobThreads),
+    };
+    if (!settings.replayPath.empty()) {
+        arguments.push_back("--replay=" + settings.replayPath.string());
+    } else {
+        arguments.push_back("--deterministic");
+        arguments.push_back("--autoplay");
+        arguments.push_back("--seed=" + std::to_string(settings.baseSeed + static_cast<std::uint32_t>(run)));
+    }
+    arguments.insert(arguments.end(), settings.extraArguments.begin(), settings.extraArguments.end());
+
+    std::string command = Quote(settings.executable.string());
+    for (const std::string& argument : arguments) {
+        command += ' ' + Quote(argument);
+    }
+    command += " > " + Quote(RunFile(settings.outputDir, run, "log").string()) + " 2>&1";
+#if defined(_WIN32)
+    // cmd.exe strips the outer quotes of a command line that starts with a quote
+    command = '"' + command + '"';
+#endif
+    return command;
+}
+}  // namespace
+
+std::vector<SoakRunner::Trend> SoakRunner::AnalyzeTrends(const std::vector<SoakSample>& samples) {
+    std::vector<Trend> trends;
+    if (samples.size() < SoakConfig::WARMUP_SAMPLES + SoakConfig::MIN_TREND_SAMPLES) {
+        return trends;
+    }
+    const auto first = samples.begin() + static_cast<std::ptrdiff_t>(SoakConfig::WARMUP_SAMPLES);
+    const double count = static_cast<double>(samples.end() - first);
+    double meanTick = 0.0;
+    for (auto it = first; it != samples.end(); ++it) {
+        meanTick += static_cast<double>(it->tick);
+    }
+    meanTick /= count;
+    const double firstTick = static_cast<double>(first->tick);
+    const double lastTick = static_cast<double>(samples.back().tick);
+
+    for (const Metric& metric : METRICS) {
+        // least-squares line through (tick, value)
+        double meanValue = 0.0;
+        for (auto it = first; it != samples.end(); ++it) {
+            meanValue += metric.read(*it);
+        }
+        meanValue /= count;
+        double covariance = 0.0;
+        double variance = 0.0;
+        for (auto it = first; it != samples.end(); ++it) {
+            const double dx = static_cast<double>(it->tick) - meanTick;
+            covariance += dx * (metric.read(*it) - meanValue);
+            variance += dx * dx;
+        }
+        const double slope = variance > 0.0 ? covariance / variance : 0.0;
+
+        Trend& trend = trends.emplace_back();
+        trend.metric = metric.name;
+        trend.unit = metric.unit;
+        trend.start = (meanValue + slope * (firstTick - meanTick)) * metric.scale;
+        trend.growth = slope * (lastTick - firstTick) * metric.scale;
+        trend.limit = std::max(metric.absoluteLimit, metric.ratioLimit * std::abs(trend.start));
+        trend.rising = trend.growth > trend.limit;
+    }
+    return trends;
+}
+
+bool SoakRunner::Run(const Settings& settings) {
+    std::error_code error;
+    std::filesystem::create_directories(settings.outputDir, error);
+    if (error) {
+        TraceLog(LOG_ERROR, "Soak: cannot create %s", settings.outputDir.string().c_str());
+        return false;
+    }
+    const std::size_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t jobs = std::clamp<std::size_t>(settings.jobs != 0 ? settings.jobs : hardwareThreads, 1,
+                                                     std::max<std::size_t>(settings.runs, 1));
+    // the runs share the cores instead of each starting a job thread per core
+    const std::size_t jobThreads = settings.jobThreads != 0 ? settings.jobThreads
+                                                            : std::max<std::size_t>(hardwareThreads / jobs, 1);
+    TraceLog(LOG_INFO, "Soak: %zu runs of %llu ticks, %zu at a time with %zu job threads each, output in %s",
+             settings.runs, static_cast<unsigned long long>(settings.ticks), jobs, jobThreads,
+             settings.outputDir.string().c_str());
+
+    // Each worker thread starts one process at a time and waits for it
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<int> exitCodes(settings.runs, 0);
+    std::atomic<std::size_t> nextRun{0};
+    std::vector<std::thread> workers;
+    for (std::size_t job = 0; job < jobs; ++job) {
+        workers.emplace_back([&] {
+            for (std::size_t run = nextRun++; run < settings.runs; run = nextRun++) {
+                exitCodes[run] = ExitCode(std::system(BuildCommand(settings, run, jobThreads).c_str()));
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    TraceLog(LOG_INFO, "Soak: all runs finished in %.1f s", seconds);
+
+    std::ofstream summary(settings.outputDir / "summary.csv", std::ios::out | std::ios::trunc);
+    summary << "run,exit_code,ticks,mean_frame_ms,resident_mb,actions,collision_listeners,event_handlers,textures,"
+               "restarts,rising\n";
+    bool passed = true;
+    std::size_t failedRuns = 0;
+    std::size_t risingRuns = 0;
+    std::vector<SoakSample> samples;
+    for (std::size_t run = 0; run < settings.runs; ++run) {
+        const std::filesystem::path samplePath = RunFile(settings.outputDir, run, "csv");
+        if (exitCodes[run] != 0 || !SoakMonitor::ReadSamples(samplePath, samples) || samples.empty()) {
+            TraceLog(LOG_ERROR, "Soak: run %zu failed (exit code %d), see %s", run, exitCodes[run],
+                     RunFile(settings.outputDir, run, "log").string().c_str());
+            summary << run << ',' << exitCodes[run] << ",,,,,,,,,\n";
+            ++failedRuns;
+            passed = false;
+            continue;
+        }
+
+        const SoakSample& last = samples.back();
+        std::string rising;
+        for (const Trend& trend : AnalyzeTrends(samples)) {
+            if (!trend.rising) continue;
+            TraceLog(LOG_WARNING, "Soak: run %zu: %s +%.2f%s over the run (fitted start %.2f%s, limit %.2f%s)", run,
+                     trend.metric, trend.growth, trend.unit, trend.start, trend.unit, trend.limit, trend.unit);
+            rising += rising.empty() ? trend.metric : std::string(";") + trend.metric;
+        }
+        TraceLog(LOG_INFO, "Soak: run %zu: %llu ticks, %.3f ms/frame, %.1f MB, %u actions, %u listeners, %u handlers, "
+                 "%u textures, %u restarts: %s", run, static_cast<unsigned long long>(last.tick), last.meanFrameMs,
+                 static_cast<double>(last.residentBytes) / MEGABYTE, last.actions, last.collisionListeners,
+                 last.eventHandlers, last.textures, last.restarts,
+                 samples.size() < SoakConfig::WARMUP_SAMPLES + SoakConfig::MIN_TREND_SAMPLES ? "too short to judge"
+                 : rising.empty()                                                             ? "steady"
+                                                                                              : "RISING");
+        summary << run << ',' << exitCodes[run] << ',' << last.tick << ',' << last.meanFrameMs << ','
+                << static_cast<double>(last.residentBytes) / MEGABYTE << ',' << last.actions << ','
+                << last.collisionListeners << ',' << last.eventHandlers << ',' << last.textures << ','
+                << last.restarts << ',' << rising << '\n';
+        if (!rising.empty()) {
+            ++risingRuns;
+            passed = false;
+        }
+    }
+    TraceLog(passed ? LOG_INFO : LOG_WARNING, "Soak: %zu of %zu runs steady, %zu failed, %zu trending upward",
+             settings.runs - failedRuns - risingRuns, settings.runs, failedRuns, risingRuns);
+    return passed;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "soak_monitor.h"
+
+/**
+ * @brief Runs many long headless sessions in parallel and flags resource growth (--soak).
+ *
+ * Every run is a separate process of the game executable (so memory is measured per
+ * run and a crash only loses that run), started with --headless and a --soak-report
+ * file. Runs are driven by --autoplay input with consecutive seeds, or all by the same
+ * recording. Up to `jobs` processes run at a time. When all have finished, the samples
+ * of every run are fitted with a straight line per metric; a metric whose fitted growth
+ * exceeds the SoakConfig limits is reported as trending upward.
+ */
+class SoakRunner {
+public:
+    /// Soak test parameters.
+    struct Settings {
+        std::filesystem::path executable;     /**< Game executable started for each run. */
+        std::size_t runs = 0;
+        std::size_t jobs = 0;                 /**< Parallel processes; 0 = one per hardware thread. */
+        std::size_t jobThreads = 0;           /**< Job threads of each run; 0 = hardware threads / jobs. */
+        std::uint64_t ticks = 0;              /**< Ticks per run. */
+        std::uint32_t baseSeed = 0;           /**< Run i uses level seed baseSeed + i (autoplay). */
+        std::filesystem::path replayPath;     /**< Drive every run by this recording instead of autoplay. */
+        std::filesystem::path outputDir;      /**< Sample files, run logs and the summary. */
+        std::vector<std::string> extraArguments; /**< Passed on to every run (e.g. --integrator). */
+    };
+
+    /// Fitted trend of one metric over a run.
+    struct Trend {
+        const char* metric = "";
+        const char* unit = "";
+        double start = 0.0;  /**< Fitted value at the first judged sample (display units). */
+        double growth = 0.0; /**< Fitted growth until the last sample (display units). */
+        double limit = 0.0;  /**< Growth above which the metric counts as rising. */
+        bool rising = false;
+    };
+
+    /**
+     * @brief Launch all runs, wait for them and report their trends.
+     *
+     * @return true when every run finished and no metric of any run trends upward.
+     */
+    static bool Run(const Settings& settings);
+
+    /**
+     * @brief Fit each metric of a run's samples (after SoakConfig::WARMUP_SAMPLES).
+     *
+     * @return One trend per metric; empty when the run has fewer than SoakConfig::MIN_TREND_SAMPLES samples.
+     */
+    static std::vector<Trend> AnalyzeTrends(const std::vector<SoakSample>& samples);
+};
@@ -0,0 +1,11 @@
+#include "sprite_draw.h"
+#include "profiler.h"
+
+/**
+ * @brief Draw a sprite using raylib's DrawTexturePro.
+ */
+void DrawSprite(const SpriteDraw& sprite) {
+    Vector2 origin = {0.0f, 0.0f};
+    DrawTexturePro(sprite.texture, sprite.source, sprite.dest, origin, 0.0f, sprite.tint);
+    PROFILE_COUNT(DrawCalls, 1);
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "raylib.h"
+
+/**
+ * @brief One textured quad ready for submission.
+ *
+ * Plain data (the texture handle is copied), so sprites can be produced by the
+ * simulation and drawn later, possibly on another thread.
+ */
+struct SpriteDraw {
+    Texture2D texture{};
+    Rectangle source{}; /**< Source rectangle; negative width flips horizontally. */
+    Rectangle dest{};   /**< Destination rectangle in world units. */
+    Color tint = WHITE;
+};
+
+/**
+ * @brief Submit a sprite with raylib (must run on the GL thread, between BeginDrawing/EndDrawing).
+ */
+void DrawSprite(const SpriteDraw& sprite);
@@ -1,37 +1,94 @@
 #include "texture_manager.h"
 #include "asset_manager.h"
 #include <utility>
+#include "profiler.h"
 
 TextureManager& TextureManager::Instance() {
     static TextureManager instance;
     return instance;
 }
 
-Texture2D& TextureManager::GetTexture(std::string_view fileName) {
-    auto it = cache.find(std::string(fileName));
-    if (it != cache.end()) return it->second;
+const CachedTexture& TextureManager::GetTexture(std::string_view fileName) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const bool canUpload = std::this_thread::get_id() == windowThread && IsWindowReady();
+    auto it = cache.find(fileName);
+    if (it != cache.end()) {
+        if (canUpload && it->second.pendingImage.data != nullptr) {
+            Upload(it->second, fileName);
+        }
+        return it->second;
+    }
 
-    // Resolve asset path and load
+    PROFILE_ZONE("TextureLoad");
+    PROFILE_EVENT("TextureLoad", fileName);
+    // Resolve asset path and load the image; the size is known even before the upload
     auto fullPath = AssetManager::GetAssetPath(std::string(fileName));
-    Texture2D tex = LoadTexture(fullPath.string().c_str());
-    // Optional: log errors (raylib returns id=0 on failure)
-    if (tex.id == 0) {
+    // built in place: map nodes never move, so the reference stays valid
+    CachedTexture& entry = cache.try_emplace(std::string(fileName)).first->second;
+    entry.pendingImage = LoadImage(fullPath.string().c_str());
+    if (entry.pendingImage.data == nullptr) {
         TraceLog(LOG_ERROR, "TextureManager: Failed to load texture: %s", fullPath.string().c_str());
+    }
+    entry.image.width = entry.pendingImage.width;
+    entry.image.height = entry.pendingImage.height;
+    entry.image.mipmaps = entry.pendingImage.mipmaps;
+    entry.image.format = entry.pendingImage.format;
+
+    if (entry.pendingImage.data != nullptr) {
+        pendingCount.fetch_add(1, std::memory_order_relaxed);
+        if (canUpload) {
+            Upload(entry, fileName);
+        }
+    }
+    return entry;
+}
+
+void TextureManager::UploadPending() {
+    if (pendingCount.load(std::memory_order_relaxed) == 0) return;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (std::this_thread::get_id() != windowThread || !IsWindowReady()) return;
+    for (auto& kv : cache) {
+        if (kv.second.pendingImage.data != nullptr) {
+            Upload(kv.second, kv.first);
+        }
+    }
+}
+
+void TextureManager::Upload(CachedTexture& entry, std::string_view fileName) {
+    const Texture2D uploaded = LoadTextureFromImage(entry.pendingImage);
+    UnloadImage(entry.pendingImage);
+    entry.pendingImage = Image{};
+    pendingCount.fetch_sub(1, std::memory_order_relaxed);
+    // readers on other threads only see the id once the texture is complete
+    entry.id.store(uploaded.id, std::memory_order_release);
+    if (uploaded.id == 0) {
+        TraceLog(LOG_ERROR, "TextureManager: Failed to upload texture: %.*s", static_cast<int>(fileName.size()),
+                 fileName.data());
     } else {
-        TraceLog(LOG_INFO, "TextureManager: Loaded texture: %s (id=%u)", fullPath.string().c_str(), tex.id);
+        TraceLog(LOG_INFO, "TextureManager: Loaded texture: %.*s (id=%u)", static_cast<int>(fileName.size()),
+                 fileName.data(), uploaded.id);
     }
-    auto [insIt, _] = cache.emplace(std::string(fileName), tex);
-    return insIt->second;
+}
+
+std::size_t TextureManager::GetCachedCount() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return cache.size();
 }
 
 void TextureManager::UnloadAll() {
+    std::lock_guard<std::mutex> lock(mutex);
     if (cache.empty()) return;  // cache empty, nothing to unload
     for (auto& kv : cache) {
-        if (kv.second.id != 0) {
-            UnloadTexture(kv.second);
+        const Texture2D texture = kv.second.Get();
+        if (texture.id != 0) {
+            UnloadTexture(texture);
+        }
+        if (kv.second.pendingImage.data != nullptr) {
+            UnloadImage(kv.second.pendingImage);
         }
     }
     cache.clear();
+    pendingCount.store(0, std::memory_order_relaxed);
 }
 
 TextureManager::~TextureManager() {
@@ -1,16 +1,56 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <unordered_map>
 #include "raylib.h"
 
 /**
- * @brief Global texture manager that loads and caches textures by file name.
+ * @brief A texture in the TextureManager cache.
  *
- * Use GetTexture() to retrieve a Texture2D. If it is not loaded yet, it will be
- * loaded, cached and then returned. Returned references are non-owning; call
- * UnloadAll() once at shutdown to free all textures.
+ * The size is set when the image is loaded and never changes. The GL id is published
+ * once the upload has finished, so any thread may read the texture while the window
+ * thread uploads it; until then Get() returns id 0 and the texture draws as nothing.
+ */
+class CachedTexture {
+public:
+    /**
+     * @brief The texture as uploaded so far.
+     */
+    Texture2D Get() const noexcept {
+        Texture2D texture = image;
+        texture.id = id.load(std::memory_order_acquire);
+        return texture;
+    }
+
+    int GetWidth() const noexcept { return image.width; }
+    int GetHeight() const noexcept { return image.height; }
+
+private:
+    friend class TextureManager;
+
+    Texture2D image{}; /**< Size and format of the image; its id is unused. */
+    std::atomic<unsigned int> id{0};
+    Image pendingImage{}; /**< Image waiting for upload (window thread, manager lock held). */
+};
+
+/**
+ * @brief Process-wide texture cache shared by all worlds, keyed by file name.
+ *
+ * Use GetTexture() to retrieve a texture. If it is not loaded yet, it will be
+ * loaded, cached and then returned. Returned references are non-owning and stay
+ * valid until UnloadAll(), which should be called once at shutdown.
+ *
+ * The cache is thread-safe. GPU uploads need the GL context, so they only happen on
+ * the thread that created the manager (the window thread). A request from any other
+ * thread (e.g. a headless world) loads just the image, which gives the texture its
+ * size; the upload follows when the window thread asks for the same texture or
+ * calls UploadPending().
  */
 class TextureManager {
 public:
@@ -21,20 +61,44 @@ public:
      * If not loaded yet, it will be loaded and cached.
      *
      * @param fileName File name/path identifying the texture (used as key).
-     * @return Texture2D& Non-owning reference to the cached texture.
+     * @return const CachedTexture& Non-owning reference to the cached texture.
+     */
+    const CachedTexture& GetTexture(std::string_view fileName);
+
+    /**
+     * @brief Upload the images loaded by other threads. Call on the window thread before drawing.
+     *
+     * Returns at once when nothing is pending.
      */
-    Texture2D& GetTexture(std::string_view fileName);
+    void UploadPending();
 
     /**
      * @brief Unload and clear all cached textures. Call before CloseWindow().
      */
     void UnloadAll();
 
+    /**
+     * @brief Number of cached textures.
+     */
+    std::size_t GetCachedCount();
+
 private:
     TextureManager() = default;
     ~TextureManager();
     TextureManager(const TextureManager&) = delete;
     TextureManager& operator=(const TextureManager&) = delete;
 
-    std::unordered_map<std::string, Texture2D> cache;  // keyed by file name
+    // Transparent hash so lookups by string_view do not build a temporary std::string
+    struct FileNameHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view name) const noexcept { return std::hash<std::string_view>{}(name); }
+    };
+
+    // Upload a pending image and publish its id (window thread, lock held)
+    void Upload(CachedTexture& entry, std::string_view fileName);
+
+    std::mutex mutex;
+    std::thread::id windowThread = std::this_thread::get_id();
+    std::atomic<std::size_t> pendingCount{0}; /**< Images waiting for upload. */
+    std::unordered_map<std::string, CachedTexture, FileNameHash, std::equal_to<>> cache;  // keyed by file name
 };
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Lock-free single-producer / single-consumer triple buffer.
+ *
+ * The producer fills `WriteBuffer()` and calls `Publish()`; the consumer calls
+ * `Acquire()` and reads `ReadBuffer()`. The third slot sits between them, so neither
+ * side ever waits: the producer may publish faster than the consumer reads (older
+ * unread values are overwritten) and the consumer keeps reading its slot until a newer
+ * one is available. Slots are reused, so values with internal storage (vectors) stop
+ * allocating once every slot has been filled once.
+ *
+ * @tparam T Value type; must be default constructible.
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    /**
+     * @brief Slot owned by the producer (producer thread only).
+     */
+    T& WriteBuffer() noexcept { return slots[writeIndex]; }
+
+    /**
+     * @brief Make the write slot the newest value and continue writing into a free slot.
+     */
+    void Publish() noexcept {
+        const std::uint8_t previous = shared.exchange(writeIndex | FRESH, std::memory_order_acq_rel);
+        writeIndex = previous & INDEX_MASK;
+    }
+
+    /**
+     * @brief Switch the read slot to the newest published value (consumer thread only).
+     *
+     * @return true when a value newer than the current read slot was taken.
+     */
+    bool Acquire() noexcept {
+        if ((shared.load(std::memory_order_relaxed) & FRESH) == 0) return false;
+        const std::uint8_t previous = shared.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previous & INDEX_MASK;
+        return true;
+    }
+
+    /**
+     * @brief Slot owned by the consumer (consumer thread only).
+     */
+    const T& ReadBuffer() const noexcept { return slots[readIndex]; }
+
+private:
+    static constexpr std::uint8_t INDEX_MASK = 0x3;
+    static constexpr std::uint8_t FRESH = 0x4; /**< Set while the shared slot holds an unread value. */
+
+    std::array<T, 3> slots{};
+    alignas(64) std::uint8_t writeIndex = 0;
+    alignas(64) std::atomic<std::uint8_t> shared{1};
+    alignas(64) std::uint8_t readIndex = 2;
+};
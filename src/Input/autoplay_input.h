@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include "config.hpp"
+#include "counter_rng.h"
+#include "net_input_source.h"
+
+/**
+ * @brief Scripted random player input for unattended sessions (soak tests, netplay tests).
+ *
+ * Holds a random combination of the player's buttons for a random number of ticks
+ * (AutoplayConfig), then picks the next one. The sequence depends only on the seed, so
+ * an autoplayed run is as reproducible as a recorded one.
+ */
+class AutoplayInput : public NetInputSource {
+public:
+    explicit AutoplayInput(std::uint32_t seed) noexcept : rng(seed) {}
+
+    /**
+     * @brief Advance to the next tick.
+     *
+     * @return Buttons held during the new tick (NetInputSource::Buttons).
+     */
+    std::uint8_t BeginTick() noexcept {
+        const std::uint8_t previous = buttons;
+        if (holdTicks == 0) {
+            buttons = static_cast<std::uint8_t>(rng.NextBelow((BUTTON_LEFT | BUTTON_RIGHT | BUTTON_JUMP) + 1));
+            holdTicks = AutoplayConfig::MIN_HOLD_TICKS + rng.NextBelow(AutoplayConfig::HOLD_RANGE_TICKS);
+        }
+        --holdTicks;
+        SetTick(previous, buttons);
+        return buttons;
+    }
+
+private:
+    CounterRng rng;
+    std::uint8_t buttons = 0;
+    std::uint32_t holdTicks = 0;
+};
@@ -1,29 +1,53 @@
 #include "input_manager.h"
-#include <algorithm>
 #include "raylib.h"
+#include "profiler.h"
 
-InputManager& InputManager::Instance() {
-    static InputManager inst;
-    return inst;
+namespace {
+// For simplicity, only left, right and space keys are polled
+constexpr int KEYS_TO_CHECK[] = {KEY_LEFT, KEY_RIGHT, KEY_SPACE};
+}  // namespace
+
+void InputManager::PublishKey(int key, bool pressed, std::size_t port) {
+    if (recorder && port == 0) recorder->RecordKeyEvent(key, pressed);
+    events.Publish(KeyEvent{key, static_cast<std::uint8_t>(port), pressed});
 }
 
-void InputManager::RegisterListener(KeyboardListener* listener) {
-    listeners.push_back(listener);
+bool InputManager::PollPressed(int key, std::size_t port) {
+    IInputSource* source = sources[port];
+    return source ? source->IsKeyPressed(key) : (port == 0 && IsKeyPressed(key));
 }
 
-void InputManager::UnregisterListener(KeyboardListener* listener) {
-    listeners.erase(std::remove(listeners.begin(), listeners.end(), listener), listeners.end());
+bool InputManager::PollReleased(int key, std::size_t port) {
+    IInputSource* source = sources[port];
+    return source ? source->IsKeyReleased(key) : (port == 0 && IsKeyReleased(key));
 }
 
 void InputManager::Update() {
-    // For simplicity, check left, right and space keys for press/release and notify listeners
-    const int keysToCheck[] = {KEY_LEFT, KEY_RIGHT, KEY_SPACE};
-    for (int k : keysToCheck) {
-        if (IsKeyPressed(k)) {
-            for (auto l : listeners) l->OnKeyPressed(k);
+    PROFILE_ZONE("Input");
+    // Check polled keys for press/release and publish them
+    for (std::size_t port = 0; port < PORT_COUNT; ++port) {
+        for (int k : KEYS_TO_CHECK) {
+            if (PollPressed(k, port)) {
+                PublishKey(k, true, port);
+            }
+            if (PollReleased(k, port)) {
+                PublishKey(k, false, port);
+            }
         }
-        if (IsKeyReleased(k)) {
-            for (auto l : listeners) l->OnKeyReleased(k);
+    }
+}
+
+bool InputManager::IsKeyDown(int key, std::size_t port) {
+    IInputSource* source = sources[port];
+    return source ? source->IsKeyDown(key) : (port == 0 && ::IsKeyDown(key));
+}
+
+void InputManager::SyncReleasedKeys() {
+    for (std::size_t port = 0; port < PORT_COUNT; ++port) {
+        for (int k : KEYS_TO_CHECK) {
+            if (!IsKeyDown(k, port)) {
+                PublishKey(k, false, port);
+            }
         }
     }
 }
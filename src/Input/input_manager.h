@@ -1,51 +1,76 @@
 #pragma once
 
-#include "keyboard_listener.h"
-#include <vector>
+#include "event_bus.h"
+#include "input_source.h"
+#include "input_recorder.h"
+#include "config.hpp"
+#include <array>
+#include <cstddef>
 
 /**
- * @brief Singleton input manager that polls keyboard and dispatches press/release events.
+ * @brief Input manager of one world that polls keyboard and publishes press/release events.
  *
- * The `InputManager` centralizes keyboard polling and notifies registered
- * [`KeyboardListener`](src/Input/keyboard_listener.h) instances. Listeners are stored
- * as raw pointers (non-owning); listeners must unregister themselves before destruction.
+ * The `InputManager` centralizes keyboard polling and appends a KeyEvent to the world's
+ * EventBus for every press and release; handlers receive them when the level dispatches
+ * the key events after polling.
+ *
+ * Every player has its own input port, and each event carries the port it came from.
+ * Port 0 falls back to raylib's keyboard when no source is installed; the other ports
+ * are silent until a source (e.g. a networked player's input) is installed for them.
  */
 class InputManager {
 public:
+    explicit InputManager(EventBus& events) : events(events) {}
+    InputManager(const InputManager&) = delete;
+    InputManager& operator=(const InputManager&) = delete;
+
+    /// Number of input ports (one per player slot).
+    static constexpr std::size_t PORT_COUNT = PlayerConfig::MAX_PLAYERS;
+
     /**
-     * @brief Get the singleton instance of InputManager.
+     * @brief Poll keys and publish events; call once per tick.
      *
-     * @return InputManager& Reference to the global instance.
+     * This method translates raw key state changes of every port into KeyEvents.
      */
-    static InputManager& Instance();
+    void Update();
 
     /**
-     * @brief Register a keyboard listener.
-     *
-     * The manager stores the pointer as non-owning. Duplicate registrations are not checked.
+     * @brief Publish a release event for every polled key that is currently up.
      *
-     * @param listener Pointer to a [`KeyboardListener`](src/Input/keyboard_listener.h).
+     * Used after the simulation state was replaced (e.g. by rewinding time) so that
+     * movement restored from a snapshot does not outlive a key released meanwhile. The
+     * events are handled together with those of the next tick, ahead of them.
      */
-    void RegisterListener(KeyboardListener* listener);
+    void SyncReleasedKeys();
 
     /**
-     * @brief Unregister a keyboard listener.
-     *
-     * Safe to call even if the listener was not registered.
+     * @brief Held state of a key as seen by the simulation (the installed source, or raylib).
+     */
+    bool IsKeyDown(int key, std::size_t port = 0);
+
+    /**
+     * @brief Substitute the keyboard state source of a port (e.g. an InputReplay).
      *
-     * @param listener Pointer to the listener to remove.
+     * @param newSource Non-owning source pointer; nullptr restores raylib polling (port 0) or silence.
+     * @param port Input port to feed.
      */
-    void UnregisterListener(KeyboardListener* listener);
+    void SetSource(IInputSource* newSource, std::size_t port = 0) { sources[port] = newSource; }
 
     /**
-     * @brief Poll keys and dispatch events; call each frame from main loop.
+     * @brief Attach a recorder that receives every key event published on port 0.
      *
-     * This method translates raw raylib key events into `OnKeyPressed` / `OnKeyReleased`
-     * calls on each registered listener.
+     * @param newRecorder Non-owning recorder pointer; nullptr stops recording.
      */
-    void Update();
+    void SetRecorder(InputRecorder* newRecorder) { recorder = newRecorder; }
 
 private:
-    InputManager() = default;
-    std::vector<KeyboardListener*> listeners;
+    // Publish a key event of a port (and record it for port 0)
+    void PublishKey(int key, bool pressed, std::size_t port);
+    // Poll a port's source; port 0 without a source polls raylib, other ports report nothing
+    bool PollPressed(int key, std::size_t port);
+    bool PollReleased(int key, std::size_t port);
+
+    EventBus& events;
+    std::array<IInputSource*, PORT_COUNT> sources{}; // non-owning
+    InputRecorder* recorder = nullptr;               // non-owning; receives published port 0 events
 };
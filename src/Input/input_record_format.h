@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Binary layout of input recordings written by InputRecorder and read by InputReplay.
+ *
+ * A file is a FileHeader followed by one record per simulated tick and a trailing
+ * Footer. Each tick record is the tick's time step (float seconds), an event count
+ * (uint8) and that many KeyEvent entries. All values are little-endian as written
+ * by the host; recordings are meant to be replayed on the same platform.
+ */
+namespace InputRecordFormat {
+inline constexpr std::uint32_t MAGIC = 0x4E494754u;  // "TGIN"
+inline constexpr std::uint16_t VERSION = 1;
+inline constexpr std::uint32_t FOOTER_MARKER = 0xFFFFFFFFu;
+
+struct FileHeader {
+    std::uint32_t magic;
+    std::uint16_t version;
+    std::uint16_t levelIndex; /**< Index into GameConfig::LEVELS. */
+    std::uint32_t seed;       /**< Level seed the session was played with. */
+};
+
+enum EventFlags : std::uint8_t { KEY_PRESSED = 1, KEY_RELEASED = 2 };
+
+#pragma pack(push, 1)
+struct KeyEvent {
+    std::uint16_t key;
+    std::uint8_t flags; /**< EventFlags */
+};
+
+/* Footer is introduced by FOOTER_MARKER in place of a tick's time step */
+struct Footer {
+    std::uint32_t marker;
+    std::uint64_t tickCount;
+    std::uint64_t finalStateHash; /**< HashWorldState of the level after the last tick. */
+};
+#pragma pack(pop)
+}  // namespace InputRecordFormat
@@ -0,0 +1,64 @@
+#include "input_recorder.h"
+#include <limits>
+#include "raylib.h"
+
+InputRecorder::~InputRecorder() {
+    // Unfinished recordings keep their ticks but have no footer (replay reports no verdict)
+    if (IsOpen()) {
+        FlushTick();
+        file.close();
+    }
+}
+
+bool InputRecorder::Open(const std::filesystem::path& path, std::uint16_t levelIndex, std::uint32_t seed) {
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        TraceLog(LOG_ERROR, "InputRecorder: cannot open %s for writing", path.string().c_str());
+        return false;
+    }
+    const InputRecordFormat::FileHeader header{InputRecordFormat::MAGIC, InputRecordFormat::VERSION, levelIndex,
+                                               seed};
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    tickEvents.reserve(16);
+    tickOpen = false;
+    tickCount = 0;
+    return true;
+}
+
+void InputRecorder::BeginTick(float delta) {
+    if (!IsOpen()) return;
+    FlushTick();
+    tickDelta = delta;
+    tickOpen = true;
+}
+
+void InputRecorder::RecordKeyEvent(int key, bool pressed) {
+    if (!IsOpen() || !tickOpen) return;
+    // the tick record stores the event count in one byte
+    if (tickEvents.size() == std::numeric_limits<std::uint8_t>::max()) return;
+    tickEvents.push_back({static_cast<std::uint16_t>(key),
+                          pressed ? InputRecordFormat::KEY_PRESSED : InputRecordFormat::KEY_RELEASED});
+}
+
+void InputRecorder::FlushTick() {
+    if (!tickOpen) return;
+    const auto eventCount = static_cast<std::uint8_t>(tickEvents.size());
+    file.write(reinterpret_cast<const char*>(&tickDelta), sizeof(tickDelta));
+    file.write(reinterpret_cast<const char*>(&eventCount), sizeof(eventCount));
+    if (eventCount > 0) {
+        file.write(reinterpret_cast<const char*>(tickEvents.data()),
+                   static_cast<std::streamsize>(tickEvents.size() * sizeof(InputRecordFormat::KeyEvent)));
+    }
+    tickEvents.clear();
+    tickOpen = false;
+    ++tickCount;
+}
+
+void InputRecorder::Finish(std::uint64_t finalStateHash) {
+    if (!IsOpen()) return;
+    FlushTick();
+    const InputRecordFormat::Footer footer{InputRecordFormat::FOOTER_MARKER, tickCount, finalStateHash};
+    file.write(reinterpret_cast<const char*>(&footer), sizeof(footer));
+    file.close();
+    TraceLog(LOG_INFO, "InputRecorder: recorded %llu ticks", static_cast<unsigned long long>(tickCount));
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+#include "input_record_format.h"
+
+/**
+ * @brief Writes timestamped per-tick keyboard events to a compact binary file.
+ *
+ * The InputManager reports every dispatched key event to the active recorder;
+ * the main loop opens a tick with its time step via BeginTick. Finish appends the
+ * tick count and a hash of the final world state so a replay can verify it
+ * reproduced the session. See InputRecordFormat for the file layout.
+ */
+class InputRecorder {
+public:
+    InputRecorder() = default;
+    ~InputRecorder();
+    InputRecorder(const InputRecorder&) = delete;
+    InputRecorder& operator=(const InputRecorder&) = delete;
+
+    /**
+     * @brief Create the recording file and write its header.
+     *
+     * @param path Output file path.
+     * @param levelIndex Index of the played level in GameConfig::LEVELS.
+     * @param seed Level seed (GameLevel::GetSeed).
+     * @return true when the file was opened.
+     */
+    bool Open(const std::filesystem::path& path, std::uint16_t levelIndex, std::uint32_t seed);
+
+    /** @brief True while a recording file is open. */
+    bool IsOpen() const { return file.is_open(); }
+
+    /**
+     * @brief Start a new tick; the previous tick (if any) is written out.
+     *
+     * @param delta Simulation time step of the tick in seconds.
+     */
+    void BeginTick(float delta);
+
+    /**
+     * @brief Record a key event dispatched during the current tick.
+     *
+     * @param key Raylib key code.
+     * @param pressed True for a press, false for a release.
+     */
+    void RecordKeyEvent(int key, bool pressed);
+
+    /**
+     * @brief Write the pending tick and the footer, then close the file.
+     *
+     * @param finalStateHash HashWorldState of the level after the last tick.
+     */
+    void Finish(std::uint64_t finalStateHash);
+
+private:
+    void FlushTick();
+
+    std::ofstream file;
+    std::vector<InputRecordFormat::KeyEvent> tickEvents;
+    float tickDelta = 0.0f;
+    bool tickOpen = false;
+    std::uint64_t tickCount = 0;
+};
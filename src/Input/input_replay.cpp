@@ -0,0 +1,75 @@
+#include "input_replay.h"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include "raylib.h"
+
+bool InputReplay::Load(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        TraceLog(LOG_ERROR, "InputReplay: cannot open %s", path.string().c_str());
+        return false;
+    }
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+    if (data.size() < sizeof(header)) {
+        TraceLog(LOG_ERROR, "InputReplay: %s is too short", path.string().c_str());
+        return false;
+    }
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (header.magic != InputRecordFormat::MAGIC || header.version != InputRecordFormat::VERSION) {
+        TraceLog(LOG_ERROR, "InputReplay: %s is not a supported input recording", path.string().c_str());
+        return false;
+    }
+    cursor = sizeof(header);
+    hasFooter = false;
+    replayedTicks = 0;
+    keysDown.reset();
+    tickEvents.clear();
+    tickEvents.reserve(16);
+    return true;
+}
+
+bool InputReplay::BeginTick(float& delta) {
+    tickEvents.clear();
+    if (cursor + sizeof(std::uint32_t) > data.size()) return false;
+
+    std::uint32_t marker = 0;
+    std::memcpy(&marker, data.data() + cursor, sizeof(marker));
+    if (marker == InputRecordFormat::FOOTER_MARKER) {
+        if (cursor + sizeof(footer) <= data.size()) {
+            std::memcpy(&footer, data.data() + cursor, sizeof(footer));
+            hasFooter = true;
+        }
+        cursor = data.size();
+        return false;
+    }
+
+    std::uint8_t eventCount = 0;
+    if (cursor + sizeof(delta) + sizeof(eventCount) > data.size()) return false;
+    std::memcpy(&delta, data.data() + cursor, sizeof(delta));
+    cursor += sizeof(delta);
+    eventCount = data[cursor++];
+
+    const std::size_t eventBytes = eventCount * sizeof(InputRecordFormat::KeyEvent);
+    if (cursor + eventBytes > data.size()) return false;
+    tickEvents.resize(eventCount);
+    std::memcpy(tickEvents.data(), data.data() + cursor, eventBytes);
+    cursor += eventBytes;
+
+    // track held keys in event order
+    for (const auto& event : tickEvents) {
+        if (event.key >= MAX_KEYS) continue;
+        if (event.flags & InputRecordFormat::KEY_PRESSED) keysDown.set(event.key);
+        if (event.flags & InputRecordFormat::KEY_RELEASED) keysDown.reset(event.key);
+    }
+    ++replayedTicks;
+    return true;
+}
+
+bool InputReplay::HasEvent(int key, std::uint8_t flag) const noexcept {
+    for (const auto& event : tickEvents) {
+        if (event.key == key && (event.flags & flag)) return true;
+    }
+    return false;
+}
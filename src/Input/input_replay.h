@@ -0,0 +1,64 @@
+#pragma once
+
+#include <bitset>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+#include "input_record_format.h"
+#include "input_source.h"
+
+/**
+ * @brief Input source that plays back a recording made by InputRecorder.
+ *
+ * Install it with `InputManager::SetSource` and call BeginTick once per simulated
+ * tick to obtain the recorded time step and make that tick's key events visible.
+ * Replays do not depend on wall-clock time and can run uncapped and headless.
+ */
+class InputReplay : public IInputSource {
+public:
+    /**
+     * @brief Load a recording into memory and validate its header.
+     *
+     * @param path Recording file path.
+     * @return true when the file was read and the header is valid.
+     */
+    bool Load(const std::filesystem::path& path);
+
+    /** @brief Header of the loaded recording (level index and seed). */
+    const InputRecordFormat::FileHeader& GetHeader() const noexcept { return header; }
+
+    /**
+     * @brief Advance to the next recorded tick.
+     *
+     * @param delta Receives the recorded time step in seconds.
+     * @return false when the recording is exhausted.
+     */
+    bool BeginTick(float& delta);
+
+    /** @brief True when the recording ended with a footer (tick count and final hash). */
+    bool HasFooter() const noexcept { return hasFooter; }
+
+    /** @brief Final state hash stored in the footer. */
+    std::uint64_t GetExpectedHash() const noexcept { return footer.finalStateHash; }
+
+    /** @brief Number of ticks replayed so far. */
+    std::uint64_t GetReplayedTicks() const noexcept { return replayedTicks; }
+
+    bool IsKeyPressed(int key) override { return HasEvent(key, InputRecordFormat::KEY_PRESSED); }
+    bool IsKeyReleased(int key) override { return HasEvent(key, InputRecordFormat::KEY_RELEASED); }
+    bool IsKeyDown(int key) override { return key >= 0 && key < MAX_KEYS && keysDown.test(key); }
+
+private:
+    static constexpr int MAX_KEYS = 512;
+
+    bool HasEvent(int key, std::uint8_t flag) const noexcept;
+
+    std::vector<std::uint8_t> data;
+    std::size_t cursor = 0;
+    InputRecordFormat::FileHeader header{};
+    InputRecordFormat::Footer footer{};
+    bool hasFooter = false;
+    std::vector<InputRecordFormat::KeyEvent> tickEvents;
+    std::bitset<MAX_KEYS> keysDown;
+    std::uint64_t replayedTicks = 0;
+};
@@ -0,0 +1,22 @@
+#pragma once
+
+/**
+ * @brief Source of keyboard state polled by the InputManager.
+ *
+ * The default source is raylib's live keyboard state. Alternative sources (e.g. an
+ * [`InputReplay`](src/Input/input_replay.h)) substitute recorded input so that a play
+ * session can be reproduced without a keyboard.
+ */
+class IInputSource {
+public:
+    virtual ~IInputSource() = default;
+
+    /** @brief True if the key went down during the current tick. */
+    virtual bool IsKeyPressed(int key) = 0;
+
+    /** @brief True if the key went up during the current tick. */
+    virtual bool IsKeyReleased(int key) = 0;
+
+    /** @brief True while the key is held. */
+    virtual bool IsKeyDown(int key) = 0;
+};
@@ -0,0 +1,20 @@
+#include "latched_input.h"
+#include "raylib.h"
+
+void LatchedInput::Latch() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (int key = 0; key < MAX_KEYS; ++key) {
+        if (::IsKeyPressed(key)) pendingPressed.set(key);
+        if (::IsKeyReleased(key)) pendingReleased.set(key);
+        latchedDown.set(key, ::IsKeyDown(key));
+    }
+}
+
+void LatchedInput::BeginTick() {
+    std::lock_guard<std::mutex> lock(mutex);
+    tickPressed = pendingPressed;
+    tickReleased = pendingReleased;
+    tickDown = latchedDown;
+    pendingPressed.reset();
+    pendingReleased.reset();
+}
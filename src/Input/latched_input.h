@@ -0,0 +1,45 @@
+#pragma once
+
+#include <bitset>
+#include <mutex>
+#include "input_source.h"
+
+/**
+ * @brief Input source handing raylib key state from the window thread to a simulation thread.
+ *
+ * raylib polls input on the thread that owns the window (inside EndDrawing). The window
+ * thread calls `Latch` once per rendered frame; key presses and releases accumulate
+ * until the simulation thread calls `BeginTick`, so no event is lost or repeated when
+ * the two threads run at different rates.
+ */
+class LatchedInput : public IInputSource {
+public:
+    /**
+     * @brief Accumulate the key events raylib polled for the current frame (window thread).
+     */
+    void Latch();
+
+    /**
+     * @brief Make all events latched since the previous tick visible to the tick (simulation thread).
+     */
+    void BeginTick();
+
+    bool IsKeyPressed(int key) override { return IsValid(key) && tickPressed.test(key); }
+    bool IsKeyReleased(int key) override { return IsValid(key) && tickReleased.test(key); }
+    bool IsKeyDown(int key) override { return IsValid(key) && tickDown.test(key); }
+
+private:
+    static constexpr int MAX_KEYS = 512;
+
+    static bool IsValid(int key) noexcept { return key >= 0 && key < MAX_KEYS; }
+
+    std::mutex mutex;
+    // written by Latch, taken by BeginTick (guarded by mutex)
+    std::bitset<MAX_KEYS> pendingPressed;
+    std::bitset<MAX_KEYS> pendingReleased;
+    std::bitset<MAX_KEYS> latchedDown;
+    // state of the current tick (simulation thread only)
+    std::bitset<MAX_KEYS> tickPressed;
+    std::bitset<MAX_KEYS> tickReleased;
+    std::bitset<MAX_KEYS> tickDown;
+};
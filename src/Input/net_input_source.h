@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include "input_source.h"
+#include "raylib.h"
+
+/**
+ * @brief Input source replaying the button state of one player tick by tick (netplay).
+ *
+ * A player's input for a tick is a small bit set of held buttons, which is what peers
+ * exchange. The rollback session sets the held state of the tick about to be simulated
+ * and of the tick before it; presses and releases are derived from the difference, so
+ * the same input history always dispatches the same key events, whether a tick is
+ * simulated for the first time or resimulated after a rollback.
+ */
+class NetInputSource : public IInputSource {
+public:
+    /// Button bits of a player input.
+    enum Buttons : std::uint8_t { BUTTON_LEFT = 1, BUTTON_RIGHT = 2, BUTTON_JUMP = 4 };
+
+    /**
+     * @brief Held buttons of the local keyboard (window thread).
+     */
+    static std::uint8_t SampleKeyboard() {
+        return static_cast<std::uint8_t>((::IsKeyDown(KEY_LEFT) ? BUTTON_LEFT : 0) |
+                                         (::IsKeyDown(KEY_RIGHT) ? BUTTON_RIGHT : 0) |
+                                         (::IsKeyDown(KEY_SPACE) ? BUTTON_JUMP : 0));
+    }
+
+    /**
+     * @brief Set the held buttons of the previous and of the current tick.
+     */
+    void SetTick(std::uint8_t previousButtons, std::uint8_t currentButtons) noexcept {
+        previous = previousButtons;
+        current = currentButtons;
+    }
+
+    bool IsKeyPressed(int key) override { return (current & ~previous & ButtonOf(key)) != 0; }
+    bool IsKeyReleased(int key) override { return (previous & ~current & ButtonOf(key)) != 0; }
+    bool IsKeyDown(int key) override { return (current & ButtonOf(key)) != 0; }
+
+private:
+    static std::uint8_t ButtonOf(int key) noexcept {
+        switch (key) {
+            case KEY_LEFT:
+                return BUTTON_LEFT;
+            case KEY_RIGHT:
+                return BUTTON_RIGHT;
+            case KEY_SPACE:
+                return BUTTON_JUMP;
+            default:
+                return 0;
+        }
+    }
+
+    std::uint8_t previous = 0;
+    std::uint8_t current = 0;
+};
@@ -0,0 +1,247 @@
+#include "body_integrator.h"
+#include <algorithm>
+#include "config.hpp"
+
+/* x86 SIMD support: SSE2 is part of the x86-64 baseline, AVX2 is compiled for its own
+   functions only and selected after a CPU check. Other architectures use the scalar kernel. */
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define BODY_INTEGRATOR_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define BODY_INTEGRATOR_AVX2_TARGET
+#else
+#define BODY_INTEGRATOR_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BODY_INTEGRATOR_SSE2 1
+#endif
+#endif
+
+namespace {
+#if defined(BODY_INTEGRATOR_X86)
+bool CpuSupportsAvx2() noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    // the OS must save the YMM registers on context switches
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+}  // namespace
+
+BodyIntegrator::BodyIntegrator() {
+    SetPath(MoveConfig::SIMD_INTEGRATION ? GetBestSupportedPath() : Path::Scalar);
+}
+
+void BodyIntegrator::Resize(std::size_t count) {
+    if (velocities.size() < count) {
+        velocities.resize(count);
+        displacements.resize(count);
+        gravityMasks.resize(count);
+        fixedVelocities.resize(count);
+        fixedDisplacements.resize(count);
+    }
+}
+
+void BodyIntegrator::SetPath(Path requested) noexcept {
+    const Path best = GetBestSupportedPath();
+    path = static_cast<std::uint8_t>(requested) <= static_cast<std::uint8_t>(best) ? requested : best;
+}
+
+BodyIntegrator::Path BodyIntegrator::GetBestSupportedPath() noexcept {
+#if defined(BODY_INTEGRATOR_X86)
+    static const bool avx2 = CpuSupportsAvx2();
+    if (avx2) return Path::AVX2;
+#endif
+#if defined(BODY_INTEGRATOR_SSE2)
+    return Path::SSE2;
+#else
+    return Path::Scalar;
+#endif
+}
+
+const char* BodyIntegrator::GetPathName(Path path) noexcept {
+    switch (path) {
+        case Path::SSE2:
+            return "SSE2";
+        case Path::AVX2:
+            return "AVX2";
+        case Path::Scalar:
+            break;
+    }
+    return "scalar";
+}
+
+void BodyIntegrator::Integrate(std::size_t begin, std::size_t end, float delta) noexcept {
+    if (begin >= end) return;
+    float* velocityY = velocities.data() + begin;
+    float* displacementY = displacements.data() + begin;
+    const std::uint32_t* gravityMask = gravityMasks.data() + begin;
+    const std::size_t count = end - begin;
+    switch (path) {
+        case Path::AVX2:
+            IntegrateAVX2(velocityY, displacementY, gravityMask, count, delta);
+            break;
+        case Path::SSE2:
+            IntegrateSSE2(velocityY, displacementY, gravityMask, count, delta);
+            break;
+        case Path::Scalar:
+            IntegrateScalar(velocityY, displacementY, gravityMask, count, delta);
+            break;
+    }
+}
+
+void BodyIntegrator::IntegrateFixed(std::size_t begin, std::size_t end, Fixed delta) noexcept {
+    if (begin >= end) return;
+    std::int32_t* velocityY = fixedVelocities.data() + begin;
+    std::int32_t* displacementY = fixedDisplacements.data() + begin;
+    const std::uint32_t* gravityMask = gravityMasks.data() + begin;
+    const std::size_t count = end - begin;
+    const Fixed step = Fixed::FromRaw(std::clamp(delta.raw, 0, MAX_FIXED_STEP.raw));
+    switch (path) {
+        case Path::AVX2:
+            IntegrateFixedAVX2(velocityY, displacementY, gravityMask, count, step);
+            break;
+        case Path::SSE2:
+            IntegrateFixedSSE2(velocityY, displacementY, gravityMask, count, step);
+            break;
+        case Path::Scalar:
+            IntegrateFixedScalar(velocityY, displacementY, gravityMask, count, step);
+            break;
+    }
+}
+
+/**
+ * @brief Reference kernel; the SIMD kernels compute exactly these operations lane by lane.
+ */
+void BodyIntegrator::IntegrateScalar(float* velocityY, float* displacementY, const std::uint32_t* gravityMask,
+                                     std::size_t count, float delta) noexcept {
+    const float gravityStep = MoveConfig::GRAVITY_CONSTANT * delta;
+    for (std::size_t i = 0; i < count; ++i) {
+        const bool falling = gravityMask[i] != 0;
+        const float velocity = falling ? velocityY[i] + gravityStep : 0.0f;
+        velocityY[i] = velocity;
+        displacementY[i] = falling ? velocity * delta : 0.0f;
+    }
+}
+
+void BodyIntegrator::IntegrateSSE2(float* velocityY, float* displacementY, const std::uint32_t* gravityMask,
+                                   std::size_t count, float delta) noexcept {
+    std::size_t i = 0;
+#if defined(BODY_INTEGRATOR_SSE2)
+    const __m128 gravityStep = _mm_set1_ps(MoveConfig::GRAVITY_CONSTANT * delta);
+    const __m128 step = _mm_set1_ps(delta);
+    for (; i + 4 <= count; i += 4) {
+        // masks are all ones or all zeros, so AND selects the value or +0.0f like the scalar kernel
+        const __m128 mask = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(gravityMask + i)));
+        const __m128 velocity = _mm_and_ps(mask, _mm_add_ps(_mm_loadu_ps(velocityY + i), gravityStep));
+        _mm_storeu_ps(velocityY + i, velocity);
+        _mm_storeu_ps(displacementY + i, _mm_and_ps(mask, _mm_mul_ps(velocity, step)));
+    }
+#endif
+    IntegrateScalar(velocityY + i, displacementY + i, gravityMask + i, count - i, delta);
+}
+
+#if defined(BODY_INTEGRATOR_X86)
+BODY_INTEGRATOR_AVX2_TARGET
+void BodyIntegrator::IntegrateAVX2(float* velocityY, float* displacementY, const std::uint32_t* gravityMask,
+                                   std::size_t count, float delta) noexcept {
+    const __m256 gravityStep = _mm256_set1_ps(MoveConfig::GRAVITY_CONSTANT * delta);
+    const __m256 step = _mm256_set1_ps(delta);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256 mask =
+            _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(gravityMask + i)));
+        const __m256 velocity = _mm256_and_ps(mask, _mm256_add_ps(_mm256_loadu_ps(velocityY + i), gravityStep));
+        _mm256_storeu_ps(velocityY + i, velocity);
+        _mm256_storeu_ps(displacementY + i, _mm256_and_ps(mask, _mm256_mul_ps(velocity, step)));
+    }
+    IntegrateSSE2(velocityY + i, displacementY + i, gravityMask + i, count - i, delta);
+}
+#else
+void BodyIntegrator::IntegrateAVX2(float* velocityY, float* displacementY, const std::uint32_t* gravityMask,
+                                   std::size_t count, float delta) noexcept {
+    IntegrateScalar(velocityY, displacementY, gravityMask, count, delta);
+}
+#endif
+
+/**
+ * @brief Reference fixed-point kernel.
+ *
+ * The SIMD kernels have no signed 32x32->64 bit multiply to work with, so they split the
+ * velocity into its signed high and unsigned low 16 bits: `(v * s) >> 16` equals
+ * `(v >> 16) * s + (((v & 0xFFFF) * s) >> 16)` exactly, and with s < 2^15 neither partial
+ * product overflows 32 bits.
+ */
+void BodyIntegrator::IntegrateFixedScalar(std::int32_t* velocityY, std::int32_t* displacementY,
+                                          const std::uint32_t* gravityMask, std::size_t count, Fixed step) noexcept {
+    const Fixed gravityStep = Fixed::FromFloat(MoveConfig::GRAVITY_CONSTANT) * step;
+    for (std::size_t i = 0; i < count; ++i) {
+        const bool falling = gravityMask[i] != 0;
+        const Fixed velocity = falling ? Fixed::FromRaw(velocityY[i]) + gravityStep : Fixed{};
+        velocityY[i] = velocity.raw;
+        displacementY[i] = (velocity * step).raw;
+    }
+}
+
+void BodyIntegrator::IntegrateFixedSSE2(std::int32_t* velocityY, std::int32_t* displacementY,
+                                        const std::uint32_t* gravityMask, std::size_t count, Fixed step) noexcept {
+    std::size_t i = 0;
+#if defined(BODY_INTEGRATOR_SSE2)
+    const __m128i gravityStep = _mm_set1_epi32((Fixed::FromFloat(MoveConfig::GRAVITY_CONSTANT) * step).raw);
+    // step < 2^15: as 16-bit pairs every lane reads (step, 0), which _mm_madd_epi16 needs
+    const __m128i stepLanes = _mm_set1_epi32(step.raw);
+    const __m128i lowBits = _mm_set1_epi32(0xFFFF);
+    for (; i + 4 <= count; i += 4) {
+        const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(gravityMask + i));
+        const __m128i velocity = _mm_and_si128(
+            mask, _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(velocityY + i)), gravityStep));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(velocityY + i), velocity);
+        // high part: v >> 16 always fits a signed 16-bit value; the pair's upper half is zero
+        const __m128i high = _mm_madd_epi16(_mm_and_si128(_mm_srai_epi32(velocity, 16), lowBits), stepLanes);
+        // low part: unsigned products of lanes 0/2 and 1/3, each below 2^31, shifted and interleaved back
+        const __m128i low = _mm_and_si128(velocity, lowBits);
+        const __m128i lowEven = _mm_srli_epi64(_mm_mul_epu32(low, stepLanes), 16);
+        const __m128i lowOdd = _mm_srli_epi64(_mm_mul_epu32(_mm_srli_epi64(low, 32), stepLanes), 16);
+        const __m128i lowProduct = _mm_or_si128(lowEven, _mm_slli_epi64(lowOdd, 32));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(displacementY + i), _mm_add_epi32(high, lowProduct));
+    }
+#endif
+    IntegrateFixedScalar(velocityY + i, displacementY + i, gravityMask + i, count - i, step);
+}
+
+#if defined(BODY_INTEGRATOR_X86)
+BODY_INTEGRATOR_AVX2_TARGET
+void BodyIntegrator::IntegrateFixedAVX2(std::int32_t* velocityY, std::int32_t* displacementY,
+                                        const std::uint32_t* gravityMask, std::size_t count, Fixed step) noexcept {
+    const __m256i gravityStep = _mm256_set1_epi32((Fixed::FromFloat(MoveConfig::GRAVITY_CONSTANT) * step).raw);
+    const __m256i stepLanes = _mm256_set1_epi32(step.raw);
+    const __m256i lowBits = _mm256_set1_epi32(0xFFFF);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i mask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(gravityMask + i));
+        const __m256i velocity = _mm256_and_si256(
+            mask, _mm256_add_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(velocityY + i)), gravityStep));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(velocityY + i), velocity);
+        const __m256i high = _mm256_mullo_epi32(_mm256_srai_epi32(velocity, 16), stepLanes);
+        const __m256i low = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_and_si256(velocity, lowBits), stepLanes), 16);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(displacementY + i), _mm256_add_epi32(high, low));
+    }
+    IntegrateFixedSSE2(velocityY + i, displacementY + i, gravityMask + i, count - i, step);
+}
+#else
+void BodyIntegrator::IntegrateFixedAVX2(std::int32_t* velocityY, std::int32_t* displacementY,
+                                        const std::uint32_t* gravityMask, std::size_t count, Fixed step) noexcept {
+    IntegrateFixedScalar(velocityY, displacementY, gravityMask, count, step);
+}
+#endif
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "fixed_point.h"
+
+/**
+ * @brief Batched gravity/velocity integration of Movable bodies in structure-of-arrays form.
+ *
+ * The level gathers the vertical velocity and a gravity mask of every body into
+ * contiguous arrays, integrates a range of them with one kernel call and hands the
+ * resulting velocity and displacement back to each body, which resolves the
+ * displacement against the tile grid (Movable::FinishIntegration).
+ *
+ * Kernels exist for SSE2 and AVX2 with a scalar fallback. All of them perform the same
+ * IEEE operations in the same order (no fused multiply-add), so every path produces
+ * bit-identical results; the serial Movable::Integrate runs the scalar kernel on a
+ * single body. The fastest path supported by the CPU is picked at runtime.
+ *
+ * With MoveConfig::FIXED_POINT_PHYSICS the bodies are integrated in 16.16 fixed point
+ * instead (SetBodyFixed / IntegrateFixed). Those kernels only use integer adds,
+ * multiplies and shifts, so their results do not depend on floating-point code
+ * generation at all.
+ */
+class BodyIntegrator {
+public:
+    /// Kernel implementation used by Integrate.
+    enum class Path : std::uint8_t { Scalar, SSE2, AVX2 };
+
+    /// Gravity mask value of a body that falls this step (all bits set, usable as a SIMD lane mask).
+    static constexpr std::uint32_t GRAVITY_ON = 0xFFFFFFFFu;
+
+    /**
+     * @brief Create an empty batch using the best supported path (scalar when disabled in MoveConfig).
+     */
+    BodyIntegrator();
+
+    /**
+     * @brief Make room for count bodies; storage is only ever grown.
+     */
+    void Resize(std::size_t count);
+
+    /**
+     * @brief Load the state of body i before integration.
+     *
+     * @param velocityY Vertical velocity in pixels per second.
+     * @param gravityMask GRAVITY_ON when gravity applies, 0 when the body rests on the ground.
+     */
+    void SetBody(std::size_t i, float velocityY, std::uint32_t gravityMask) noexcept {
+        velocities[i] = velocityY;
+        gravityMasks[i] = gravityMask;
+    }
+
+    /**
+     * @brief Load the fixed-point state of body i before IntegrateFixed.
+     */
+    void SetBodyFixed(std::size_t i, Fixed velocityY, std::uint32_t gravityMask) noexcept {
+        fixedVelocities[i] = velocityY.raw;
+        gravityMasks[i] = gravityMask;
+    }
+
+    /** Vertical velocity of body i after integration. */
+    float GetVelocityY(std::size_t i) const noexcept { return velocities[i]; }
+
+    /** Vertical displacement of body i computed by the last integration. */
+    float GetDisplacementY(std::size_t i) const noexcept { return displacements[i]; }
+
+    /** Fixed-point vertical velocity of body i after IntegrateFixed. */
+    Fixed GetFixedVelocityY(std::size_t i) const noexcept { return Fixed::FromRaw(fixedVelocities[i]); }
+
+    /** Fixed-point vertical displacement of body i computed by the last IntegrateFixed. */
+    Fixed GetFixedDisplacementY(std::size_t i) const noexcept { return Fixed::FromRaw(fixedDisplacements[i]); }
+
+    /**
+     * @brief Integrate bodies [begin, end) with the selected path.
+     *
+     * Ranges of different callers must not overlap; disjoint ranges may run in parallel.
+     */
+    void Integrate(std::size_t begin, std::size_t end, float delta) noexcept;
+
+    /**
+     * @brief Fixed-point counterpart of Integrate for bodies loaded with SetBodyFixed.
+     */
+    void IntegrateFixed(std::size_t begin, std::size_t end, Fixed delta) noexcept;
+
+    /** Kernel used by Integrate. */
+    Path GetPath() const noexcept { return path; }
+
+    /**
+     * @brief Select a kernel; paths the CPU does not support fall back to the best supported one.
+     */
+    void SetPath(Path requested) noexcept;
+
+    /**
+     * @brief Fastest path the running CPU supports.
+     */
+    static Path GetBestSupportedPath() noexcept;
+
+    /** Name of a path for logs. */
+    static const char* GetPathName(Path path) noexcept;
+
+    /**
+     * @brief Integrate count bodies: grounded ones get zero velocity and displacement, falling
+     *        ones `v += g * delta; dy = v * delta`.
+     *
+     * The kernels are public so callers can integrate a single body or compare the paths.
+     */
+    static void IntegrateScalar(float* velocityY, float* displacementY, const std::uint32_t* gravityMask,
+                                std::size_t count, float delta) noexcept;
+    static void IntegrateSSE2(float* velocityY, float* displacementY, const std::uint32_t* gravityMask,
+                              std::size_t count, float delta) noexcept;
+    static void IntegrateAVX2(float* velocityY, float* displacementY, const std::uint32_t* gravityMask,
+                              std::size_t count, float delta) noexcept;
+
+    /** Longest time step the fixed-point kernels accept (the step must fit a signed 16-bit lane). */
+    static constexpr Fixed MAX_FIXED_STEP = Fixed::FromRaw(0x7FFF);
+
+    /**
+     * @brief Fixed-point kernels: grounded bodies get zero velocity and displacement, falling
+     *        ones `v += g * step; dy = v * step` with products rounded towards negative infinity.
+     *
+     * Velocities are raw 16.16 values (wrapping beyond +-32768 pixels per second) and
+     * `step` must lie in [0, MAX_FIXED_STEP]. All paths return identical bits.
+     */
+    static void IntegrateFixedScalar(std::int32_t* velocityY, std::int32_t* displacementY,
+                                     const std::uint32_t* gravityMask, std::size_t count, Fixed step) noexcept;
+    static void IntegrateFixedSSE2(std::int32_t* velocityY, std::int32_t* displacementY,
+                                   const std::uint32_t* gravityMask, std::size_t count, Fixed step) noexcept;
+    static void IntegrateFixedAVX2(std::int32_t* velocityY, std::int32_t* displacementY,
+                                   const std::uint32_t* gravityMask, std::size_t count, Fixed step) noexcept;
+
+private:
+    std::vector<float> velocities;
+    std::vector<float> displacements;
+    std::vector<std::int32_t> fixedVelocities;    /**< Raw 16.16 values. */
+    std::vector<std::int32_t> fixedDisplacements; /**< Raw 16.16 values. */
+    std::vector<std::uint32_t> gravityMasks;
+    Path path = Path::Scalar;
+};
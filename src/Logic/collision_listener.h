@@ -1,14 +1,13 @@
 #pragma once
 
-#include "raylib.h"
 class Actor;
 
 /**
- * @brief Interface for objects that wish to receive collision notifications.
+ * @brief Interface for objects whose actor is tested for collisions.
  *
- * Implementors must return a reference to the underlying `Actor` that
- * provides the collision bounds and will be reported as `self` during
- * notifications.
+ * The collision system tests the actor of every registered listener against all other
+ * actors and publishes a CollisionEvent to the world's EventBus for each overlap; the
+ * listener handles those events (as an IEventHandler<CollisionEvent>) after the pass.
  */
 class ICollisionListener {
 public:
@@ -18,12 +17,4 @@ public:
      * @brief Return the underlying actor used for collision bounds.
      */
     virtual Actor& GetCollisionActor() = 0;
-
-    /**
-     * @brief Called when this listener's actor collides with another actor.
-     * @param self Reference to the listener actor (same as GetCollisionActor()).
-     * @param other Reference to the other actor involved in the collision.
-     * @param overlap Overlapping rectangle (intersection of AABBs).
-     */
-    virtual void OnCollision(Actor& self, Actor& other, const Rectangle& overlap) = 0;
 };
@@ -1,10 +1,14 @@
 #include "collision_system.h"
 #include <algorithm>
+#include "profiler.h"
+#include "job_system.h"
+#include "config.hpp"
 
-CollisionSystem& CollisionSystem::Instance() {
-    static CollisionSystem inst;
-    return inst;
+namespace {
+std::uint64_t ContactKey(const Actor& self, const Actor& other) {
+    return (static_cast<std::uint64_t>(self.GetSpawnSlot()) << 32) | other.GetSpawnSlot();
 }
+}  // namespace
 
 void CollisionSystem::RegisterListener(ICollisionListener* listener) {
     if (!listener) return;
@@ -15,37 +19,118 @@ void CollisionSystem::RegisterListener(ICollisionListener* listener) {
 
 void CollisionSystem::UnregisterListener(ICollisionListener* listener) {
     listeners.erase(std::remove(listeners.begin(), listeners.end(), listener), listeners.end());
+    // no Exit events: the listener is gone
+    const Actor* self = listener ? &listener->GetCollisionActor() : nullptr;
+    std::erase_if(contacts, [self](const Contact& contact) { return contact.self == self; });
 }
 
-void CollisionSystem::Update(const std::vector<std::unique_ptr<Actor>>& actors, Actor* player) {
-    // Gather all actors into a single list for collision checks
-    std::vector<Actor*> all;
-    all.reserve(actors.size() + (player ? 1 : 0));
+void CollisionSystem::Detect(const std::vector<std::unique_ptr<Actor>>& actors, std::span<Actor* const> players) {
+    current.clear();
+    // Only actors on a layer some listener tests are candidates (storage reused between frames)
+    std::uint32_t testedLayers = 0;
+    for (ICollisionListener* listener : listeners) {
+        if (listener) testedLayers |= listener->GetCollisionActor().GetCollisionMask();
+    }
+    if (testedLayers == 0) return;
+    std::vector<Candidate>& all = candidates;
+    all.clear();
+    all.reserve(actors.size() + players.size());
+    auto gather = [&](Actor* actor) {
+        if (actor && actor->IsAlive() && (actor->GetCollisionLayer() & testedLayers) != 0) {
+            all.push_back({actor, actor->GetCollisionLayer()});
+        }
+    };
     for (auto& a : actors)
-        if (a) all.push_back(a.get());
-    if (player) all.push_back(player);
+        gather(a.get());
+    for (Actor* player : players)
+        gather(player);
 
     for (ICollisionListener* listener : listeners) {
         if (!listener) continue;
         Actor& selfActor = listener->GetCollisionActor();
         // skip if self actor is not alive
         if (!selfActor.IsAlive()) continue;
+        const std::uint32_t mask = selfActor.GetCollisionMask();
+        if (mask == 0) continue;
 
-        // check collision against all other actors
-        Rectangle selfRect = selfActor.GetRect();
-        for (Actor* other : all) {
-            if (other == &selfActor) continue;
-            if (!other->IsAlive()) continue;
-            Rectangle otherRect = other->GetRect();
-            if (CheckCollisionRecs(selfRect, otherRect)) {
-                // compute overlap rectangle and notify listener
-                float left = std::max(selfRect.x, otherRect.x);
-                float top = std::max(selfRect.y, otherRect.y);
-                float right = std::min(selfRect.x + selfRect.width, otherRect.x + otherRect.width);
-                float bottom = std::min(selfRect.y + selfRect.height, otherRect.y + otherRect.height);
-                Rectangle overlap{left, top, right - left, bottom - top};
-                listener->OnCollision(selfActor, *other, overlap);
+        // check collision against all other actors, one chunk of candidates per job
+        const Rectangle selfRect = selfActor.GetRect();
+        const std::size_t chunkSize = JobConfig::COLLISION_CHUNK_SIZE;
+        const std::size_t chunks = JobSystem::ChunkCount(all.size(), chunkSize);
+        if (chunkHits.size() < chunks) {
+            chunkHits.resize(chunks);
+        }
+        JobSystem::Instance().ParallelFor(all.size(), chunkSize, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+            ChunkHits& result = chunkHits[chunk];
+            result.hits.clear();
+            result.pairs = 0;
+            for (std::size_t i = begin; i < end; ++i) {
+                // pairs outside the mask are rejected before the actor is read
+                if ((all[i].layer & mask) == 0) continue;
+                Actor* other = all[i].actor;
+                if (other == &selfActor) continue;
+                ++result.pairs;
+                Rectangle otherRect = other->GetRect();
+                if (CheckCollisionRecs(selfRect, otherRect)) {
+                    // compute overlap rectangle
+                    float left = std::max(selfRect.x, otherRect.x);
+                    float top = std::max(selfRect.y, otherRect.y);
+                    float right = std::min(selfRect.x + selfRect.width, otherRect.x + otherRect.width);
+                    float bottom = std::min(selfRect.y + selfRect.height, otherRect.y + otherRect.height);
+                    result.hits.push_back({ContactKey(selfActor, *other), &selfActor, other,
+                                           Rectangle{left, top, right - left, bottom - top}, false});
+                }
             }
+        });
+
+        // keep the hits in actor order (profiler counters are main-thread only)
+        for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+            PROFILE_COUNT(CollisionPairs, static_cast<std::int64_t>(chunkHits[chunk].pairs));
+            current.insert(current.end(), chunkHits[chunk].hits.begin(), chunkHits[chunk].hits.end());
         }
     }
 }
+
+void CollisionSystem::Update(const std::vector<std::unique_ptr<Actor>>& actors, std::span<Actor* const> players,
+                             EventBus& events) {
+    PROFILE_ZONE("Collision");
+    Detect(actors, players);
+
+    // Enter and Stay in detection order; the previous contacts are sorted by key for the lookup
+    auto byKey = [](const Contact& lhs, const Contact& rhs) { return lhs.key < rhs.key; };
+    for (const Contact& contact : current) {
+        const auto previous = std::lower_bound(contacts.begin(), contacts.end(), contact, byKey);
+        const bool stayed = previous != contacts.end() && previous->key == contact.key;
+        if (stayed) previous->seen = true;
+        events.Publish(CollisionEvent{contact.self, contact.other, contact.overlap,
+                                      stayed ? ContactPhase::Stay : ContactPhase::Enter});
+    }
+    // Exit for the previous contacts not found again, in key order
+    for (const Contact& contact : contacts) {
+        if (!contact.seen) {
+            events.Publish(CollisionEvent{contact.self, contact.other, contact.overlap, ContactPhase::Exit});
+        }
+    }
+
+    // the current contacts become the cache
+    std::swap(contacts, current);
+    std::sort(contacts.begin(), contacts.end(), byKey);
+}
+
+void CollisionSystem::SaveContacts(std::vector<std::uint64_t>& keys) const {
+    keys.clear();
+    for (const Contact& contact : contacts) {
+        keys.push_back(contact.key);
+    }
+}
+
+void CollisionSystem::RestoreContact(Actor& self, Actor& other) {
+    // the overlap is only reported again by an Exit; the current one is as good as any
+    const Rectangle a = self.GetRect();
+    const Rectangle b = other.GetRect();
+    const float left = std::max(a.x, b.x);
+    const float top = std::max(a.y, b.y);
+    const Rectangle overlap{left, top, std::max(0.0f, std::min(a.x + a.width, b.x + b.width) - left),
+                            std::max(0.0f, std::min(a.y + a.height, b.y + b.height) - top)};
+    contacts.push_back({ContactKey(self, other), &self, &other, overlap, false});
+}
@@ -1,23 +1,39 @@
 #pragma once
 
+#include <span>
 #include <vector>
 #include <unordered_set>
 #include <utility>
 #include "collision_listener.h"
+#include "event_bus.h"
 #include "actor.h"
 
 /**
- * @brief Basic axis-aligned bounding box (AABB) collision system.
+ * @brief Basic axis-aligned bounding box (AABB) collision system with layer filtering.
  *
- * The system tests all registered collision listener actors against the
- * complete set of actors in the current level (including the player). On
- * overlap, it invokes `OnCollision` providing both actors and the overlap
- * rectangle. It performs a naive O(N*M) broad-phase suitable for the small
- * actor counts typical in early prototypes.
+ * The system tests the actor of every registered collision listener against the living
+ * actors of the level (including the players) whose collision layer is in the listener
+ * actor's mask. Actors on other layers are dropped while gathering the candidates or
+ * rejected by a bit test on the gathered layer, before any collider is read; enemies do
+ * not mask each other, so crowds add no enemy-versus-enemy pairs. The AABB tests are a
+ * naive O(N*M) broad-phase suitable for the small listener counts of the game.
+ *
+ * Contacts persist between passes in a pair cache keyed by the spawn slots of both
+ * actors, and every pass publishes a CollisionEvent per contact phase: Enter for new
+ * overlaps, Stay for continued ones and Exit for pairs that separated or whose actor
+ * died. The cache is part of the world state (SaveContacts / RestoreContact), so a
+ * restored world reports the same phases as the original run.
+ *
+ * For each listener the overlap tests run in parallel chunks on the job system; hits
+ * are collected per chunk and published afterwards in actor order. No listener code
+ * runs during the pass: the events are handled when the level dispatches them, so
+ * every test sees the actor states from before the collisions of this tick.
  */
 class CollisionSystem {
 public:
-    static CollisionSystem& Instance();
+    CollisionSystem() = default;
+    CollisionSystem(const CollisionSystem&) = delete;
+    CollisionSystem& operator=(const CollisionSystem&) = delete;
 
     /**
      * @brief Register a collision listener (no ownership transfer).
@@ -25,15 +41,72 @@ public:
     void RegisterListener(ICollisionListener* listener);
 
     /**
-     * @brief Unregister a previously registered listener.
+     * @brief Unregister a previously registered listener; its cached contacts are dropped.
      */
     void UnregisterListener(ICollisionListener* listener);
 
+    /**
+     * @brief Number of registered listeners.
+     */
+    std::size_t GetListenerCount() const noexcept { return listeners.size(); }
+
+    /**
+     * @brief Number of contacts found by the last pass.
+     */
+    std::size_t GetContactCount() const noexcept { return contacts.size(); }
+
     /**
      * @brief Run collision detection between registered listeners and all actors in level.
+     *
+     * @param events Bus that receives a CollisionEvent per contact and phase.
      */
-    void Update(const std::vector<std::unique_ptr<Actor>>& actors, Actor* player);
+    void Update(const std::vector<std::unique_ptr<Actor>>& actors, std::span<Actor* const> players,
+                EventBus& events);
+
+    /**
+     * @brief Write the keys of the cached contacts, (self spawn slot << 32) | other spawn slot, in ascending order.
+     */
+    void SaveContacts(std::vector<std::uint64_t>& keys) const;
+
+    /**
+     * @brief Empty the pair cache (before restoring a world state).
+     */
+    void ClearContacts() noexcept { contacts.clear(); }
+
+    /**
+     * @brief Add a contact to the pair cache; restore contacts in ascending key order.
+     */
+    void RestoreContact(Actor& self, Actor& other);
 
 private:
+    // An actor gathered for testing with its layer, so masked out actors are rejected without touching them
+    struct Candidate {
+        Actor* actor;
+        std::uint32_t layer;
+    };
+    // A pair of overlapping actors; key is (self spawn slot << 32) | other spawn slot
+    struct Contact {
+        std::uint64_t key;
+        Actor* self;
+        Actor* other;
+        Rectangle overlap;
+        bool seen; /**< Still overlapping in the current pass (previous contacts only). */
+    };
+    // hits and tested pair count of one chunk of candidates
+    struct ChunkHits {
+        std::vector<Contact> hits;
+        std::size_t pairs = 0;
+    };
+
+    // Test all listeners and collect their overlaps in listener and actor order into current
+    void Detect(const std::vector<std::unique_ptr<Actor>>& actors, std::span<Actor* const> players);
+
     std::vector<ICollisionListener*> listeners;
+    // scratch list of actors tested in Update; kept to avoid a per-frame allocation
+    std::vector<Candidate> candidates;
+    // per-chunk results of the current listener; kept to avoid per-frame allocations
+    std::vector<ChunkHits> chunkHits;
+    // pair cache: contacts of the last pass sorted by key, and of the current pass in detection order
+    std::vector<Contact> contacts;
+    std::vector<Contact> current;
 };
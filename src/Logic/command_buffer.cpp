@@ -0,0 +1,48 @@
+#include "command_buffer.h"
+#include <cassert>
+#include "gamelogic.h"
+
+namespace {
+thread_local CommandBuffer* activeBuffer = nullptr;
+}
+
+CommandBuffer::~CommandBuffer() {
+    // actions registered but never applied still belong to the buffer
+    for (const Command& command : commands) {
+        if (command.kind == Command::Kind::Register) {
+            delete command.action;
+        }
+    }
+}
+
+CommandBuffer* CommandBuffer::Active() noexcept {
+    return activeBuffer;
+}
+
+CommandBuffer::Scope::Scope(CommandBuffer& buffer) noexcept : previous(activeBuffer) {
+    activeBuffer = &buffer;
+}
+
+CommandBuffer::Scope::~Scope() {
+    activeBuffer = previous;
+}
+
+void CommandBuffer::RegisterAction(std::unique_ptr<Action> action) {
+    commands.push_back({Command::Kind::Register, action.release()});
+}
+
+void CommandBuffer::DeregisterAction(Action* action) {
+    commands.push_back({Command::Kind::Deregister, action});
+}
+
+void CommandBuffer::Apply(GameLogic& logic) {
+    assert(activeBuffer == nullptr);
+    for (Command& command : commands) {
+        if (command.kind == Command::Kind::Register) {
+            logic.RegisterAction(std::unique_ptr<Action>(command.action));
+        } else {
+            logic.DeregisterAction(command.action);
+        }
+    }
+    commands.clear();
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "action.h"
+
+class GameLogic;
+
+/**
+ * @brief Structural changes recorded by a parallel update job and applied later on the main thread.
+ *
+ * While a buffer is bound to a thread (see `Scope`), `GameLogic::RegisterAction` and
+ * `GameLogic::DeregisterAction` called on that thread are recorded instead of touching the
+ * shared action list. `Apply` replays the commands in recording order; applying the
+ * buffers of all chunks in chunk order reproduces the order of a serial update.
+ *
+ * Storage is kept between frames, so recording does not allocate once warm.
+ */
+class CommandBuffer {
+public:
+    CommandBuffer() = default;
+    ~CommandBuffer();
+    CommandBuffer(const CommandBuffer&) = delete;
+    CommandBuffer& operator=(const CommandBuffer&) = delete;
+    // movable for std::vector growth; assignment would drop the pending actions of the destination
+    CommandBuffer(CommandBuffer&& other) noexcept = default;
+    CommandBuffer& operator=(CommandBuffer&& other) = delete;
+
+    /**
+     * @brief Buffer bound to the calling thread, or nullptr when changes apply immediately.
+     */
+    static CommandBuffer* Active() noexcept;
+
+    /**
+     * @brief Binds a buffer to the calling thread for the lifetime of the scope.
+     */
+    class Scope {
+    public:
+        explicit Scope(CommandBuffer& buffer) noexcept;
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        CommandBuffer* previous;
+    };
+
+    /**
+     * @brief Record registration of an action; the buffer owns it until applied.
+     */
+    void RegisterAction(std::unique_ptr<Action> action);
+
+    /**
+     * @brief Record deregistration of an action.
+     */
+    void DeregisterAction(Action* action);
+
+    /**
+     * @brief Apply recorded commands to a world's GameLogic in order and clear the buffer.
+     *
+     * Must be called with no buffer bound to the calling thread.
+     */
+    void Apply(GameLogic& logic);
+
+    bool IsEmpty() const noexcept { return commands.empty(); }
+
+private:
+    struct Command {
+        enum class Kind { Register, Deregister } kind;
+        Action* action; /**< Owned by the buffer for Register commands. */
+    };
+
+    std::vector<Command> commands;
+};
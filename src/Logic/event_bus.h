@@ -0,0 +1,136 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "event_handler.h"
+#include "game_events.h"
+#include "profiler.h"
+
+/**
+ * @brief Typed, batched event queues of one world.
+ *
+ * Producers append events to the array of their type during a phase of the tick
+ * (input polling, collision detection, the dead sweep) instead of calling consumers
+ * directly. The owner of the tick then dispatches each type at a fixed point, and every
+ * subscribed handler receives the whole batch at once. Consumers therefore never run in
+ * the middle of a producer's loop (a player taking damage cannot register actions while
+ * the collision system still iterates), and the events of a phase are one contiguous
+ * array that can be read in parallel (see Pending).
+ *
+ * Events published while a type is being dispatched (including events of the same type)
+ * wait for the next dispatch of their type. The arrays keep their capacity, so a warm
+ * bus does not allocate.
+ */
+template <typename... Events>
+class BasicEventBus {
+    static_assert((std::is_trivially_copyable_v<Events> && ...), "events must be plain data");
+
+public:
+    BasicEventBus() = default;
+    BasicEventBus(const BasicEventBus&) = delete;
+    BasicEventBus& operator=(const BasicEventBus&) = delete;
+
+    /**
+     * @brief Append an event for the next dispatch of its type.
+     */
+    template <typename Event>
+    void Publish(const Event& event) {
+        GetChannel<Event>().pending.push_back(event);
+    }
+
+    /**
+     * @brief Append several events of one type (e.g. the results of a parallel pass) in order.
+     */
+    template <typename Event>
+    void Publish(std::span<const Event> events) {
+        std::vector<Event>& pending = GetChannel<Event>().pending;
+        pending.insert(pending.end(), events.begin(), events.end());
+    }
+
+    /**
+     * @brief Events of a type published since its last dispatch.
+     */
+    template <typename Event>
+    std::span<const Event> Pending() const noexcept {
+        return std::get<Channel<Event>>(channels).pending;
+    }
+
+    /**
+     * @brief Hand the pending events of a type to every handler in subscription order, then drop them.
+     *
+     * @return Number of events dispatched.
+     */
+    template <typename Event>
+    std::size_t Dispatch() {
+        Channel<Event>& channel = GetChannel<Event>();
+        if (channel.pending.empty()) return 0;
+        // handlers may publish while the batch is delivered; those events go to the next dispatch
+        std::swap(channel.pending, channel.delivering);
+        const std::span<const Event> batch{channel.delivering};
+        for (std::size_t i = 0; i < channel.handlers.size(); ++i) {
+            channel.handlers[i]->OnEvents(batch);
+        }
+        const std::size_t count = channel.delivering.size();
+        channel.delivering.clear();
+        PROFILE_COUNT(Events, static_cast<std::int64_t>(count));
+        return count;
+    }
+
+    /**
+     * @brief Subscribe a handler (no ownership transfer). Duplicate subscriptions are ignored.
+     */
+    template <typename Event>
+    void Subscribe(IEventHandler<Event>* handler) {
+        std::vector<IEventHandler<Event>*>& handlers = GetChannel<Event>().handlers;
+        if (handler && std::find(handlers.begin(), handlers.end(), handler) == handlers.end()) {
+            handlers.push_back(handler);
+        }
+    }
+
+    /**
+     * @brief Unsubscribe a handler; safe to call even if it was not subscribed.
+     */
+    template <typename Event>
+    void Unsubscribe(IEventHandler<Event>* handler) {
+        std::erase(GetChannel<Event>().handlers, handler);
+    }
+
+    /**
+     * @brief Drop the pending events of every type (the world state they refer to was replaced).
+     */
+    void Clear() noexcept {
+        std::apply([](auto&... channel) { (channel.pending.clear(), ...); }, channels);
+    }
+
+    /**
+     * @brief Number of subscribed handlers (all types).
+     */
+    std::size_t GetHandlerCount() const noexcept {
+        return std::apply([](const auto&... channel) { return (channel.handlers.size() + ... + std::size_t{0}); },
+                          channels);
+    }
+
+private:
+    template <typename Event>
+    struct Channel {
+        std::vector<Event> pending;
+        std::vector<Event> delivering;  // batch being dispatched; keeps its capacity between dispatches
+        std::vector<IEventHandler<Event>*> handlers;  // non-owning
+    };
+
+    template <typename Event>
+    Channel<Event>& GetChannel() noexcept {
+        return std::get<Channel<Event>>(channels);
+    }
+
+    std::tuple<Channel<Events>...> channels;
+};
+
+/// Event bus of a world (see WorldContext).
+using EventBus = BasicEventBus<KeyEvent, CollisionEvent, TriggerEvent, DamageEvent, ActorRemovedEvent>;
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <span>
+
+/**
+ * @brief Interface for objects that handle events of one type from an EventBus.
+ *
+ * Handlers receive all events published since the last dispatch in a single call, in
+ * publish order. Implementations must subscribe themselves to the bus and unsubscribe
+ * before destruction to avoid dangling pointers.
+ */
+template <typename Event>
+class IEventHandler {
+public:
+    virtual ~IEventHandler() = default;
+
+    /**
+     * @brief Handle a batch of events.
+     *
+     * @param events Events of this dispatch; valid only during the call.
+     */
+    virtual void OnEvents(std::span<const Event> events) = 0;
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include "raylib.h"
+
+class Actor;
+
+/*
+ * Events of one world, published during a phase of the tick and handled in bulk
+ * afterwards (see EventBus). They are plain data: actors are referenced by pointer and
+ * stay valid until the events are dispatched, because dead actors are only retired
+ * (not destroyed) during a tick.
+ */
+
+/**
+ * @brief A key of an input port was pressed or released (published by InputManager).
+ */
+struct KeyEvent {
+    int key = 0;            /**< Raylib key code (KEY_LEFT, KEY_RIGHT, KEY_SPACE). */
+    std::uint8_t port = 0;  /**< Input port, which is also the player slot. */
+    bool pressed = false;   /**< false for a release. */
+};
+
+/// Phase of a contact between two actors.
+enum class ContactPhase : std::uint8_t {
+    Enter, /**< The actors started to overlap this tick. */
+    Stay,  /**< They overlapped in the previous tick already. */
+    Exit,  /**< They overlapped in the previous tick but no longer do (or one of them died). */
+};
+
+/**
+ * @brief A contact of a collision listener's actor with another actor (published by CollisionSystem).
+ */
+struct CollisionEvent {
+    Actor* self = nullptr;   /**< The listener's actor. */
+    Actor* other = nullptr;  /**< The actor it overlaps. */
+    Rectangle overlap{};     /**< Intersection of both colliders (the last one for Exit). */
+    ContactPhase phase = ContactPhase::Enter;
+};
+
+/// Kind of a trigger volume, from the class of its TMX object (see TriggerConfig).
+enum class TriggerKind : std::uint8_t {
+    Custom,     /**< Any other class; handlers read the volume's properties. */
+    Exit,       /**< Completes the level when a player enters it. */
+    Damage,     /**< Hurts the actors inside it. */
+    Checkpoint, /**< Players respawn here once one of them entered it. */
+};
+
+/**
+ * @brief An actor is inside a trigger volume (published by TriggerSystem).
+ */
+struct TriggerEvent {
+    Actor* actor = nullptr;
+    std::uint32_t trigger = 0; /**< Index of the volume in the level's TriggerSystem. */
+    TriggerKind kind = TriggerKind::Custom;
+    ContactPhase phase = ContactPhase::Enter;
+};
+
+/**
+ * @brief An actor is hit by something that hurts it.
+ */
+struct DamageEvent {
+    Actor* target = nullptr;
+    const Actor* source = nullptr;
+};
+
+/**
+ * @brief A dead actor was removed from the active actor list (published by the dead sweep).
+ */
+struct ActorRemovedEvent {
+    const Actor* actor = nullptr;
+    std::uint32_t spawnSlot = 0;
+};
@@ -1,29 +1,59 @@
 #include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <span>
 #include "gamelevel.h"
 #include "gamelogic.h"
 #include "config.hpp"
-#include "asset_manager.h"
 #include "enemy.h"
 #include "texture_manager.h"
+#include "map_manager.h"
 #include "collision_system.h"
+#include "profiler.h"
+#include "job_system.h"
+#include "counter_rng.h"
 
 /**
  * @brief Construct and initialize a GameLevel from a TMX map file.
  *
- * Loads the map and caches commonly used layers such as the ground layer.
+ * Takes the map from the MapManager and caches commonly used layers such as the ground layer.
  */
-GameLevel::GameLevel(std::string_view mapFileName) {
-    // Load the TMX map from the specified file
-    map = LoadTMX(AssetManager::GetAssetPath(mapFileName).string().c_str());
-    if (map == nullptr) {
-        TraceLog(LOG_ERROR, "Failed to load TMX map: %s", mapFileName);
+GameLevel::GameLevel(std::string_view mapFileName, std::uint32_t seed, std::size_t playerCount)
+    : spawnPlayerCount(std::clamp<std::size_t>(playerCount, 1, PlayerConfig::MAX_PLAYERS)), seed(seed) {
+    // The map is shared by every world on it; off the window thread it must be preloaded
+    map = MapManager::Instance().GetMap(mapFileName);
+    if constexpr (MoveConfig::FIXED_POINT_PHYSICS) {
+        // positions, the map bounds and fall-outs below the map must stay within the 16.16 range
+        const long long mapWidth = map ? static_cast<long long>(map->width) * map->tileWidth : 0;
+        const long long mapHeight = map ? static_cast<long long>(map->height) * map->tileHeight : 0;
+        if (mapWidth > Fixed::MAX_INT || mapHeight + MoveConfig::DEATH_FALL_MARGIN > Fixed::MAX_INT) {
+            TraceLog(LOG_ERROR, "%.*s is %lldx%lld px, too large for fixed-point physics (max %d px)",
+                     static_cast<int>(mapFileName.size()), mapFileName.data(), mapWidth, mapHeight,
+                     Fixed::MAX_INT);
+            map = nullptr;  // refused: the level stays empty, like a map that failed to load
+        }
     }
 
     // Cache the ground layer pointer to avoid repeated name lookups
     groundLayer = FindLayerByName(GameConfig::GROUND_LAYER_NAME.data());
+    collisionGrid.Build(map, groundLayer);
+    // bake routes for the enemies' movement abilities
+    NavGraph::Agent agent;
+    agent.jumpStrength = EnemyConfig::JUMP_STRENGTH;
+    agent.gravity = MoveConfig::GRAVITY_CONSTANT;
+    agent.runSpeed = EnemyConfig::CHASE_SPEED;
+    if (collisionGrid.GetTileHeight() > 0.0f) {
+        agent.clearanceCells = static_cast<int>(std::ceil(EnemyConfig::COLLIDER_HEIGHT / collisionGrid.GetTileHeight()));
+    }
+    navGraph.Build(collisionGrid, agent);
+    triggers.Build(map, FindLayerByName(TriggerConfig::LAYER_NAME.data()));
+    context.events.Subscribe<TriggerEvent>(this);
+    TraceLog(LOG_DEBUG, "Body integration kernel: %s (%s)", BodyIntegrator::GetPathName(bodies.GetPath()),
+             MoveConfig::FIXED_POINT_PHYSICS ? "16.16 fixed point" : "float");
 
-    // Spawn actors defined in TMX
+    // Spawn actors defined in TMX and remember their initial state for fast restarts
     SpawnActorsFromMap(true);
+    CaptureInitialSnapshot();
 
     // initialize the camera
     camera.zoom = 2.0f;
@@ -31,54 +61,225 @@ GameLevel::GameLevel(std::string_view mapFileName) {
     camera.rotation = 0.0f;
 }
 
+GameLevel::~GameLevel() {
+    // Move actions reset their actor's velocity when destroyed
+    context.logic.Cleanup();
+}
+
 /**
  * @brief Update all actors in the level and perform cleanup of dead actors.
  */
-void GameLevel::UpdateAll() {
-    // Get delta time for this frame
-    float delta = GetFrameTime();
+void GameLevel::UpdateAll(float delta) {
+    PROFILE_ZONE("UpdateAll");
+    // animation frames are derived from this clock when sprites are drawn; no per-actor pass
+    context.animations.Update(delta);
+    {
+        PROFILE_ZONE("ActorUpdate");
+        PROFILE_COUNT(Actors, static_cast<std::int64_t>(actors.size() + GetPlayerCount()));
+        // chasing enemies share one flow field towards the nearest span a living player stands on
+        std::array<std::uint32_t, PlayerConfig::MAX_PLAYERS> playerSpans{};
+        std::size_t spanCount = 0;
+        for (const auto& player : players) {
+            if (!player || !player->IsAlive() || !player->IsGrounded()) continue;
+            const Rectangle body = player->GetRect();
+            const std::int32_t span = navGraph.FindSpan({body.x + body.width * 0.5f, body.y + body.height});
+            if (span != NAV_NONE) {
+                playerSpans[spanCount++] = static_cast<std::uint32_t>(span);
+            }
+        }
+        if (spanCount > 0) {
+            PROFILE_ZONE("FlowField");
+            navGraph.BuildFlowField(std::span<const std::uint32_t>(playerSpans.data(), spanCount));
+        }
+        UpdateActorsParallel(delta);
 
-    // Update all non-player actors in the level
-    for (auto& actor : actors) {
-        if (actor->IsAlive()) {
-            actor->Update(delta);
+        // Update players separately in slot order, keep updating even if dead for respawn logic.
+        // Runs on the main thread: it reads other actors and may reset the whole level.
+        for (const auto& slot : players) {
+            if (slot) {
+                slot->Update(delta);
+            }
         }
     }
 
-    // Update player separately if present, keep updating even if dead for respawn logic
-    if (player) {
-        player->Update(delta);
+    /* Cleanup dead actors and publish their removal. Dead actors are compacted out of the
+       active list (keeping the order of the living ones) and parked in retiredActors so a
+       level reset can restore them in place. */
+    {
+        PROFILE_ZONE("DeadSweep");
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < actors.size(); ++i) {
+            if (actors[i]->IsAlive()) {
+                if (kept != i) {
+                    actors[kept] = std::move(actors[i]);
+                }
+                ++kept;
+                continue;
+            }
+            context.events.Publish(ActorRemovedEvent{actors[i].get(), actors[i]->GetSpawnSlot()});
+            retiredActors.push_back(std::move(actors[i]));
+        }
+        actors.erase(actors.begin() + static_cast<std::ptrdiff_t>(kept), actors.end());
     }
+    // do not remove players - keep for respawn
 
-    // Cleanup dead actors and noify removal listeners
-    auto iterator = std::remove_if(actors.begin(), actors.end(), [&](const std::unique_ptr<Actor>& actor) {
-        // Check if the actor is not alive (destroyed)
-        if (!actor->IsAlive()) {
-            // Notify all removal listeners
-            for (const auto& listener : removalListeners) {
-                listener(*actor);
-            }
-            return true;  // Remove this actor
+    // Run collision detection after all movement/animation updates
+    std::array<Actor*, PlayerConfig::MAX_PLAYERS> playerActors{};
+    std::size_t playerActorCount = 0;
+    for (const auto& slot : players) {
+        if (slot) {
+            playerActors[playerActorCount++] = slot.get();
         }
-        return false;  // Keep this actor
-    });
+    }
+    const auto collisionStart = std::chrono::steady_clock::now();
+    context.collisions.Update(actors, std::span<Actor* const>(playerActors.data(), playerActorCount), context.events);
+    collisionMillis = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - collisionStart).count();
+    triggers.Update(actors, std::span<Actor* const>(playerActors.data(), playerActorCount), context.events);
 
-    // Erase the dead actors from the vector
-    if (iterator != actors.end()) {
-        actors.erase(iterator, actors.end());
+    // Handle this tick's events in bulk now that no system is iterating the actors
+    {
+        PROFILE_ZONE("Events");
+        context.events.Dispatch<CollisionEvent>();
+        context.events.Dispatch<TriggerEvent>();
+        // damage published by the collision and trigger handlers
+        context.events.Dispatch<DamageEvent>();
+        context.events.Dispatch<ActorRemovedEvent>();
     }
-    // do not remove player - keep for respawn
 
-    // Run collision detection after all movement/animation updates
-    CollisionSystem::Instance().Update(actors, player.get());
+    // After a short delay the game over message ends the level
+    if (levelState == LevelState::LEVEL_NO_LIVES) {
+        gameOverTimer += delta;
+        if (gameOverTimer > GameConfig::GAME_OVER_DELAY) {
+            levelState = LevelState::LEVEL_GAME_OVER;
+        }
+    }
+}
+
+void GameLevel::Step(float delta) {
+    // Poll input and hand the key events to the players
+    context.input.Update();
+    context.events.Dispatch<KeyEvent>();
+    // Update game logic (perform active actions)
+    context.logic.Update(delta);
+    // Update all actors
+    UpdateAll(delta);
+}
+
+/**
+ * @brief Update all living non-player actors phase by phase on the job system.
+ *
+ * Actors alive at the start of the frame run every phase, like a serial Update would.
+ * Each chunk of actors records its action changes into its own command buffer; the
+ * buffers are applied in chunk order afterwards, so the resulting action list is the
+ * same as with a serial update in actor order.
+ */
+void GameLevel::UpdateActorsParallel(float delta) {
+    updateList.clear();
+    updateBodies.clear();
+    for (auto& actor : actors) {
+        if (actor->IsAlive()) {
+            updateList.push_back(actor.get());
+            updateBodies.push_back(actor->GetBatchedBody());
+        }
+    }
+    const std::size_t chunkSize = JobConfig::ACTOR_CHUNK_SIZE;
+    const std::size_t chunks = JobSystem::ChunkCount(updateList.size(), chunkSize);
+    if (chunkCommands.size() < chunks) {
+        chunkCommands.resize(chunks);
+    }
+    bodies.Resize(updateList.size());
+    context.ticks.BeginFrame(updateList.size());
+
+    JobSystem& jobs = JobSystem::Instance();
+    {
+        // patrol walking for all patrolling actors in one pass (takes the place of their Move actions)
+        PROFILE_ZONE("Patrol");
+        jobs.ParallelFor(patrols.GetCount(), JobConfig::PATROL_CHUNK_SIZE, [&](std::size_t, std::size_t begin, std::size_t end) {
+            patrols.Advance(begin, end, delta);
+        });
+    }
+    auto runPhase = [&](Actor::UpdatePhase phase) {
+        jobs.ParallelFor(updateList.size(), chunkSize, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+            CommandBuffer::Scope deferred{chunkCommands[chunk]};
+            for (std::size_t i = begin; i < end; ++i) {
+                updateList[i]->RunPhase(phase, delta);
+            }
+        });
+    };
+    {
+        PROFILE_ZONE("Grounding");
+        runPhase(Actor::UpdatePhase::Grounding);
+    }
+    {
+        /* Per chunk: gather the bodies into the integrator's arrays, integrate them with one
+           SIMD kernel call, then let each body resolve its displacement against the tiles.
+           Actors without a batched body run their Physics phase as usual. */
+        PROFILE_ZONE("Physics");
+        jobs.ParallelFor(updateList.size(), chunkSize, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+            CommandBuffer::Scope deferred{chunkCommands[chunk]};
+            if constexpr (MoveConfig::FIXED_POINT_PHYSICS) {
+                for (std::size_t i = begin; i < end; ++i) {
+                    if (const Movable* body = updateBodies[i]) {
+                        bodies.SetBodyFixed(i, body->GetFixedVelocityY(), body->GetGravityMask());
+                    } else {
+                        bodies.SetBodyFixed(i, Fixed{}, 0u);
+                    }
+                }
+                bodies.IntegrateFixed(begin, end, Fixed::FromFloat(delta));
+            } else {
+                for (std::size_t i = begin; i < end; ++i) {
+                    if (const Movable* body = updateBodies[i]) {
+                        bodies.SetBody(i, body->GetVelocity().y, body->GetGravityMask());
+                    } else {
+                        bodies.SetBody(i, 0.0f, 0u);
+                    }
+                }
+                bodies.Integrate(begin, end, delta);
+            }
+            for (std::size_t i = begin; i < end; ++i) {
+                if (Movable* body = updateBodies[i]) {
+                    if constexpr (MoveConfig::FIXED_POINT_PHYSICS) {
+                        body->FinishIntegration(bodies.GetFixedVelocityY(i), bodies.GetFixedDisplacementY(i));
+                    } else {
+                        body->FinishIntegration(bodies.GetVelocityY(i), bodies.GetDisplacementY(i));
+                    }
+                } else {
+                    updateList[i]->RunPhase(Actor::UpdatePhase::Physics, delta);
+                }
+            }
+        });
+    }
+    {
+        PROFILE_ZONE("AI");
+        runPhase(Actor::UpdatePhase::AI);
+    }
+    PROFILE_SET_COUNT(TickSensors, context.ticks.GetTickCount(TickGroup::Sensors));
+    PROFILE_SET_COUNT(TickAnimation, context.ticks.GetTickCount(TickGroup::Animation));
+    PROFILE_SET_COUNT(TickAI, context.ticks.GetTickCount(TickGroup::AI));
+    {
+        PROFILE_ZONE("ApplyCommands");
+        for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+            chunkCommands[chunk].Apply(context.logic);
+        }
+    }
 }
 
 /**
- * @brief Render the TMX map and all actors using the level camera.
+ * @brief Render the current state of the level (capture and draw in one go).
  */
 void GameLevel::Render() {
-    // Camera follows player, but clamp to map edges
-    Vector2 camTarget = GetPlayer() ? GetPlayer()->GetPosition() : Vector2{0, 0};
+    CaptureRenderState(renderState);
+    Render(renderState);
+}
+
+/**
+ * @brief Capture camera, actor sprites and HUD values for drawing.
+ */
+void GameLevel::CaptureRenderState(RenderState& state) const {
+    PROFILE_ZONE("RenderCapture");
+    // Camera follows the viewed player, but clamp to map edges
+    const Player* viewed = GetPlayer(viewPlayer) ? GetPlayer(viewPlayer) : GetPlayer();
+    Vector2 camTarget = viewed ? viewed->GetPosition() : Vector2{0, 0};
     float halfScreenW = Config::SCREEN_WIDTH / (2 * camera.zoom);
     float halfScreenH = Config::SCREEN_HEIGHT / (2 * camera.zoom);
     float maxX = map->width * map->tileWidth - halfScreenW;
@@ -87,37 +288,82 @@ void GameLevel::Render() {
     if (camTarget.x > maxX) camTarget.x = maxX;
     if (camTarget.y < halfScreenH) camTarget.y = halfScreenH;
     if (camTarget.y > maxY) camTarget.y = maxY;
-    camera.target = camTarget;
+    state.cameraTarget = camTarget;
+
+    // Non-player actors first so the players are drawn on top
+    state.sprites.clear();
+    SpriteDraw sprite;
+    for (const auto& actor : actors) {
+        if (actor->IsAlive() && actor->GetSprite(sprite)) {
+            state.sprites.push_back(sprite);
+        }
+    }
+    // Players last, kept even if dead for the death animation
+    for (const auto& slot : players) {
+        if (slot && slot->GetSprite(sprite)) {
+            state.sprites.push_back(sprite);
+        }
+    }
+
+    state.hasPlayer = (viewed != nullptr);
+    state.lives = viewed ? viewed->GetLives() : 0;
+    state.showGameOver = (levelState == LevelState::LEVEL_NO_LIVES);
+}
+
+/**
+ * @brief Render the TMX map and a captured render state using the level camera.
+ */
+void GameLevel::Render(const RenderState& state) {
+    PROFILE_ZONE("Render");
+    camera.target = state.cameraTarget;
+    // sprites of actors created off the window thread (e.g. by the simulation thread)
+    TextureManager::Instance().UploadPending();
 
     BeginDrawing();
     ClearBackground(BLACK);
     BeginMode2D(camera);
-    AnimateTMX(map);
-    DrawTMX(map, &camera, 0, 0, WHITE);
-
-    // Render all non-player actors first so the player is drawn on top
-    for (const auto& actor : actors) {
-        if (actor->IsAlive()) {
-            actor->Draw();
-        }
+    {
+        PROFILE_ZONE("Tilemap");
+        AnimateTMX(map);
+        DrawTMX(map, &camera, 0, 0, WHITE);
+        PROFILE_COUNT(DrawCalls, 1);
     }
 
-    // Render player last so it appears on top of other actors, keep drawing even if dead for death
-    // animation
-    if (player) {
-        player->Draw();
+    {
+        PROFILE_ZONE("DrawActors");
+        for (const SpriteDraw& sprite : state.sprites) {
+            DrawSprite(sprite);
+        }
     }
 
     EndMode2D();
     // HUD (lives, etc.) drawn after world but before FPS
-    DrawHUD();
+    DrawHUD(state);
     DrawFPS(10, 10);
+    // profiler overlay shows the last completed frame
+    PROFILE_DRAW_OVERLAY();
     EndDrawing();
 }
 
-Player* GameLevel::GetPlayer() const {
+std::uint32_t GameLevel::NextActorSeed() noexcept {
+    // Mix level seed and spawn counter (golden-ratio increment with a murmur-style finalizer)
+    std::uint32_t mixed = seed + 0x9E3779B9u * ++actorSeedCount;
+    mixed ^= mixed >> 16;
+    mixed *= 0x85EBCA6Bu;
+    mixed ^= mixed >> 13;
+    mixed *= 0xC2B2AE35u;
+    mixed ^= mixed >> 16;
+    return mixed;
+}
+
+Player* GameLevel::GetPlayer(std::size_t index) const {
     // Return the dedicated player instance if present
-    return player.get();
+    return index < players.size() ? players[index].get() : nullptr;
+}
+
+std::size_t GameLevel::GetPlayerCount() const noexcept {
+    return static_cast<std::size_t>(
+        std::count_if(players.begin(), players.end(), [](const std::unique_ptr<Player>& slot) { return slot != nullptr; }));
 }
 
 float GameLevel::GetMapBottom() const {
@@ -152,15 +398,19 @@ void GameLevel::SpawnActorsFromMap(bool createPlayer) {
         const TmxObject& obj = group.objects[i];
         if (obj.visible && obj.name != nullptr) {
             // Position from Tiled is top-left - that is what the actors expect
+            PROFILE_EVENT("Spawn", obj.name);
             if (strcmp(obj.name, GameConfig::PLAYER_OBJECT_NAME.data()) == 0) {
-                // Create player if not existing yet
-                if (createPlayer || !player) {
-                    addActor<Player>(obj.x, obj.y, PlayerConfig::DEFAULT_JUMP_STRENGTH,
-                                     PlayerConfig::DEFAULT_MOVE_SPEED, PlayerConfig::IDLE_ANIM, PlayerConfig::WALK_ANIM,
-                                     PlayerConfig::JUMP_ANIM, PlayerConfig::FALL_ANIM);
-                } else {
-                    // Move existing player to start position
-                    player->SetPosition(obj.x, obj.y);
+                // Co-op players spawn side by side; create them if not existing yet
+                for (std::size_t index = 0; index < spawnPlayerCount; ++index) {
+                    const float x = obj.x + PlayerConfig::CO_OP_SPAWN_OFFSET_X * static_cast<float>(index);
+                    if (createPlayer || !players[index]) {
+                        addActor<Player>(x, obj.y, PlayerConfig::DEFAULT_JUMP_STRENGTH, PlayerConfig::DEFAULT_MOVE_SPEED,
+                                         PlayerConfig::IDLE_ANIM, PlayerConfig::WALK_ANIM, PlayerConfig::JUMP_ANIM,
+                                         PlayerConfig::FALL_ANIM);
+                    } else {
+                        // Move existing player to start position
+                        players[index]->SetPosition(x, obj.y);
+                    }
                 }
             } else if (strcmp(obj.name, GameConfig::ZOMBIE_OBJECT_NAME.data()) == 0) {
                 addActor<Enemy>(obj.x, obj.y, EnemyConfig::DEFAULT_MOVE_SPEED, EnemyConfig::IDLE_ANIM,
@@ -171,42 +421,282 @@ void GameLevel::SpawnActorsFromMap(bool createPlayer) {
 }
 
 /**
- * @brief Reset level: keep Player instance, move to start, respawn other actors from TMX.
+ * @brief Assign spawn slots in spawn order and capture the initial state of every actor.
+ */
+void GameLevel::CaptureInitialSnapshot() {
+    for (std::size_t i = 0; i < actors.size(); ++i) {
+        actors[i]->SetSpawnSlot(static_cast<std::uint32_t>(i));
+    }
+    spawnSlotCount = static_cast<std::uint32_t>(actors.size());
+    for (std::size_t index = 0; index < players.size(); ++index) {
+        if (players[index]) {
+            players[index]->SetSpawnSlot(Actor::PLAYER_SPAWN_SLOT - static_cast<std::uint32_t>(index));
+        }
+    }
+    // Retired actors never outnumber the spawned ones; avoid growth when actors die
+    retiredActors.reserve(actors.size());
+
+    SaveWorldState(initialSnapshot);
+}
+
+Actor* GameLevel::FindActorBySlot(std::uint32_t slot) const {
+    if (slot <= Actor::PLAYER_SPAWN_SLOT && slot > Actor::PLAYER_SPAWN_SLOT - players.size()) {
+        return players[Actor::PLAYER_SPAWN_SLOT - slot].get();
+    }
+    // After a restore actors are sorted by slot, so the slot is also the index
+    if (slot < actors.size() && actors[slot]->GetSpawnSlot() == slot) {
+        return actors[slot].get();
+    }
+    for (const auto& actor : actors) {
+        if (actor->GetSpawnSlot() == slot) return actor.get();
+    }
+    return nullptr;
+}
+
+void GameLevel::SaveWorldState(WorldState& state) const {
+    state.actors.resize(spawnSlotCount);
+    auto saveSlotted = [&state](const std::vector<std::unique_ptr<Actor>>& list) {
+        for (const auto& actor : list) {
+            const std::uint32_t slot = actor->GetSpawnSlot();
+            if (slot < state.actors.size()) {
+                actor->SaveSnapshot(state.actors[slot]);
+            }
+        }
+    };
+    saveSlotted(actors);
+    saveSlotted(retiredActors);
+
+    // player slots are filled in order, so the occupied ones are a prefix
+    state.playerCount = 0;
+    while (state.playerCount < players.size() && players[state.playerCount]) {
+        players[state.playerCount]->SaveSnapshot(state.players[state.playerCount]);
+        ++state.playerCount;
+    }
+    state.levelState = static_cast<std::uint8_t>(levelState.load());
+    state.gameOverTimer = gameOverTimer;
+    state.checkpoint = checkpoint;
+    state.tickFrame = context.ticks.GetFrame();
+    context.collisions.SaveContacts(state.contacts);
+    triggers.SaveOccupancy(state.triggers);
+
+    // Actions are stored with their target slot; actions on unslotted actors cannot be restored
+    state.actions.clear();
+    for (const auto& action : context.logic.GetActions()) {
+        const Actor& target = action->GetActor();
+        const std::uint32_t slot = target.GetSpawnSlot();
+        if (slot == Actor::NO_SPAWN_SLOT) continue;
+
+        ActionSnapshot& record = state.actions.emplace_back();
+        action->SaveSnapshot(record);
+        record.targetSlot = slot;
+        const auto* movable = dynamic_cast<const Movable*>(&target);
+        record.activeMove = (movable != nullptr && movable->GetActiveMoveAction() == action.get());
+    }
+}
+
+void GameLevel::RestoreWorldState(const WorldState& state) {
+    // Pending events refer to the state being replaced
+    context.events.Clear();
+    // Clear all actions from GameLogic first; Move destructors reset velocities of their targets
+    context.logic.Cleanup();
+
+    // Bring retired actors back so their storage is reused
+    for (auto& retired : retiredActors) {
+        actors.push_back(std::move(retired));
+    }
+    retiredActors.clear();
+
+    // Actors without a record in the state have nothing to return to
+    std::erase_if(actors, [&state](const std::unique_ptr<Actor>& actor) {
+        return actor->GetSpawnSlot() >= state.actors.size();
+    });
+    // Restore spawn order so update and draw order match a freshly loaded level
+    std::sort(actors.begin(), actors.end(), [](const std::unique_ptr<Actor>& lhs, const std::unique_ptr<Actor>& rhs) {
+        return lhs->GetSpawnSlot() < rhs->GetSpawnSlot();
+    });
+    for (auto& actor : actors) {
+        actor->RestoreSnapshot(state.actors[actor->GetSpawnSlot()]);
+    }
+    for (std::size_t index = 0; index < state.playerCount; ++index) {
+        if (players[index]) {
+            players[index]->RestoreSnapshot(state.players[index]);
+        }
+    }
+    levelState = static_cast<LevelState>(state.levelState);
+    gameOverTimer = state.gameOverTimer;
+    checkpoint = state.checkpoint < triggers.GetCount() ? state.checkpoint : WorldState::NO_CHECKPOINT;
+    context.ticks.SetFrame(state.tickFrame);
+
+    // Contacts of the restored tick, so the next collision pass reports the same phases
+    context.collisions.ClearContacts();
+    for (const std::uint64_t key : state.contacts) {
+        Actor* self = FindActorBySlot(static_cast<std::uint32_t>(key >> 32));
+        Actor* other = FindActorBySlot(static_cast<std::uint32_t>(key));
+        if (self != nullptr && other != nullptr) {
+            context.collisions.RestoreContact(*self, *other);
+        }
+    }
+    triggers.ClearOccupancy();
+    for (const std::uint64_t key : state.triggers) {
+        if (Actor* actor = FindActorBySlot(static_cast<std::uint32_t>(key >> 32))) {
+            triggers.RestoreOccupancy(*actor, static_cast<std::uint32_t>(key));
+        }
+    }
+
+    // Recreate active actions and re-bind active move actions to their actors
+    for (const ActionSnapshot& record : state.actions) {
+        Actor* target = FindActorBySlot(record.targetSlot);
+        if (target == nullptr) continue;
+        std::unique_ptr<Action> action = GameLogic::CreateAction(*target, record);
+        if (!action) continue;
+        if (record.activeMove) {
+            if (auto* movable = dynamic_cast<Movable*>(target)) {
+                movable->SetActiveMoveAction(action.get());
+            }
+        }
+        context.logic.RegisterAction(std::move(action));
+    }
+}
+
+/**
+ * @brief Reset level: keep the Player instances and restore all actors from the initial snapshot.
  */
 void GameLevel::Reset() {
-    // Clear all actions from GameLogic
-    GameLogic::Instance().Cleanup();
-    // Remove non-player actors
-    actors.clear();
-    // Recreate non-player actors from map and move player to start position
-    SpawnActorsFromMap(false);
-    // reset player state
-    if (player) {
-        player->ResetState();
+    PROFILE_ZONE("LevelReset");
+    PROFILE_EVENT("LevelReset");
+    // Remaining lives and the checkpoint reached are kept across restarts
+    std::array<int, PlayerConfig::MAX_PLAYERS> lives{};
+    for (std::size_t index = 0; index < players.size(); ++index) {
+        lives[index] = players[index] ? players[index]->GetLives() : 0;
+    }
+    const std::uint32_t reached = checkpoint;
+    RestoreWorldState(initialSnapshot);
+    checkpoint = reached;
+    for (std::size_t index = 0; index < players.size(); ++index) {
+        if (players[index]) {
+            players[index]->SetLives(lives[index]);
+            MoveToCheckpoint(*players[index]);
+        }
+    }
+}
+
+void GameLevel::Restart() {
+    PROFILE_ZONE("LevelReset");
+    PROFILE_EVENT("LevelRestart");
+    RestoreWorldState(initialSnapshot);
+}
+
+std::size_t GameLevel::SpawnExtraZombies(std::size_t count) {
+    const std::size_t spanCount = navGraph.GetSpanCount();
+    if (count == 0 || spanCount == 0) return 0;
+    PROFILE_ZONE("SpawnExtraZombies");
+    CounterRng rng{NextActorSeed()};
+    actors.reserve(actors.size() + count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const NavSpan& span = navGraph.GetSpan(rng.NextBelow(static_cast<std::uint32_t>(spanCount)));
+        Enemy& zombie = addActor<Enemy>(span.left, span.top, EnemyConfig::DEFAULT_MOVE_SPEED, EnemyConfig::IDLE_ANIM,
+                                        EnemyConfig::WALK_ANIM);
+        // stand on the span: the collider's bottom edge on the walking surface
+        const Rectangle body = zombie.GetRect();
+        const float colliderTop = body.y - zombie.GetPosition().y;
+        const float room = std::max(0.0f, span.right - span.left - body.width);
+        zombie.SetPosition(span.left + rng.NextFloat() * room, span.top - colliderTop - body.height);
+    }
+    CaptureInitialSnapshot();
+    return count;
+}
+
+/**
+ * @brief React to the actors entering and staying in trigger volumes.
+ */
+void GameLevel::OnEvents(std::span<const TriggerEvent> events) {
+    for (const TriggerEvent& event : events) {
+        if (event.phase == ContactPhase::Exit) continue;
+        const bool isPlayer = (event.actor->GetCollisionLayer() & CollisionConfig::LAYER_PLAYER) != 0;
+        switch (event.kind) {
+        case TriggerKind::Exit:
+            if (isPlayer && event.phase == ContactPhase::Enter && levelState == LevelState::LEVEL_RUNNING) {
+                TraceLog(LOG_INFO, "Level completed at exit %u", triggers.Get(event.trigger).objectId);
+                levelState = LevelState::LEVEL_COMPLETED;
+            }
+            break;
+        case TriggerKind::Damage:
+            // like an enemy contact, staying inside hurts again once the invulnerability ends
+            context.events.Publish(DamageEvent{event.actor, nullptr});
+            break;
+        case TriggerKind::Checkpoint:
+            if (isPlayer && event.phase == ContactPhase::Enter && checkpoint != event.trigger) {
+                TraceLog(LOG_DEBUG, "Checkpoint %u reached", triggers.Get(event.trigger).objectId);
+                checkpoint = event.trigger;
+            }
+            break;
+        case TriggerKind::Custom:
+            break;
+        }
     }
 }
 
 void GameLevel::GameOver() {
     levelState = LevelState::LEVEL_NO_LIVES;
+    gameOverTimer = 0.0f;
+}
+
+void GameLevel::OnPlayerDied(Player& player) {
+    bool livesLeft = false;
+    for (const auto& slot : players) {
+        livesLeft = livesLeft || (slot && slot->GetLives() > 0);
+    }
+    if (!livesLeft) {
+        GameOver();  // every player is out of lives
+    } else if (GetPlayerCount() == 1) {
+        Reset();  // alone: start the level over
+    } else if (player.GetLives() > 0) {
+        RespawnPlayer(player);
+    }
+    // else: out of lives, the player stays dead while the others play on
+}
+
+void GameLevel::RespawnPlayer(Player& player) {
+    const std::size_t index = player.GetPlayerIndex();
+    if (index >= initialSnapshot.playerCount) return;
+    PROFILE_EVENT("PlayerRespawn");
+    // a jump still running must not carry over to the respawned player
+    context.logic.DeregisterActions(player);
+    const int lives = player.GetLives();
+    player.RestoreSnapshot(initialSnapshot.players[index]);
+    player.SetLives(lives);
+    MoveToCheckpoint(player);
+}
+
+void GameLevel::MoveToCheckpoint(Player& player) {
+    if (checkpoint == WorldState::NO_CHECKPOINT) return;
+    // like the player object, the volume's left edge is where the first player stands
+    const Rectangle area = triggers.Get(checkpoint).bounds;
+    const Rectangle body = player.GetRect();
+    const Vector2 origin = player.GetPosition();
+    const float x = area.x + PlayerConfig::CO_OP_SPAWN_OFFSET_X * static_cast<float>(player.GetPlayerIndex());
+    player.SetPosition(x - (body.x - origin.x), area.y + area.height - body.height - (body.y - origin.y));
 }
 
-void GameLevel::DrawHUD() {
-    if (player) {
+void GameLevel::DrawHUD(const RenderState& state) {
+    PROFILE_ZONE("HUD");
+    if (state.hasPlayer) {
         // Draw lives as heart icons in upper-right corner
-        Texture2D& fullTex = TextureManager::Instance().GetTexture(PlayerConfig::HEART_FULL_TEXTURE);
-        Texture2D& emptyTex = TextureManager::Instance().GetTexture(PlayerConfig::HEART_EMPTY_TEXTURE);
+        const Texture2D fullTex = TextureManager::Instance().GetTexture(PlayerConfig::HEART_FULL_TEXTURE).Get();
+        const Texture2D emptyTex = TextureManager::Instance().GetTexture(PlayerConfig::HEART_EMPTY_TEXTURE).Get();
         int tileW = map ? (int)map->tileWidth : fullTex.width;
 
         for (int i = 0; i < PlayerConfig::MAX_LIVES; ++i) {
             int x = Config::SCREEN_WIDTH - ((PlayerConfig::MAX_LIVES - i) * tileW);
-            Texture2D& lifeTexture = (i < player->GetLives()) ? fullTex : emptyTex;
+            const Texture2D& lifeTexture = (i < state.lives) ? fullTex : emptyTex;
             DrawTexture(lifeTexture, x, 0, WHITE);
+            PROFILE_COUNT(DrawCalls, 1);
         }
     }
 
     // TODO: game over message only temporarily here - move to class handling
     // level/game state one implementation exists
-    if (levelState == LevelState::LEVEL_NO_LIVES) {
+    if (state.showGameOver) {
         int fontSize = 40;
         int w = MeasureText(GameConfig::GAME_OVER_TEXT.data(), fontSize);
         int x = (Config::SCREEN_WIDTH - w) / 2;
@@ -215,12 +705,6 @@ void GameLevel::DrawHUD() {
         // draw shadow and main text
         DrawText(GameConfig::GAME_OVER_TEXT.data(), x + 2, y + 2, fontSize, BLACK);
         DrawText(GameConfig::GAME_OVER_TEXT.data(), x, y, fontSize, RED);
-
-        // After short delay exit
-        static float goTimer = 0.0f;
-        goTimer += GetFrameTime();
-        if (goTimer > 1.5f) {
-            levelState = LevelState::LEVEL_GAME_OVER;
-        }
+        PROFILE_COUNT(DrawCalls, 2);
     }
 }
\ No newline at end of file
@@ -2,20 +2,35 @@
 
 #include <vector>
 #include <memory>
-#include <functional>
+#include <random>
+#include <span>
 #include <string_view>
 #include <type_traits>
 #include "raytmx.h"
 #include "actor.h"
 #include "config.hpp"
 #include "player.h"
+#include "world_state.h"
+#include "tile_collision_grid.h"
+#include "line_of_sight_cache.h"
+#include "nav_graph.h"
+#include "trigger_system.h"
+#include "patrol_system.h"
+#include "command_buffer.h"
+#include "body_integrator.h"
+#include "render_state.h"
+#include "world_context.h"
+#include <array>
+#include <atomic>
 
 /**
  * @brief Represents a loaded game level, including its map and actors.
  *
  * Loads a TMX map and manages actors, rendering and per-frame updates for the level.
+ * Each level is an independent world: actions, collision listeners and input live in
+ * its WorldContext, so several levels can be simulated at the same time.
  */
-class GameLevel {
+class GameLevel : public IEventHandler<TriggerEvent> {
 public:
     enum class LevelState {
         LEVEL_RUNNING,
@@ -29,14 +44,53 @@ public:
     /**
      * @brief Construct a new GameLevel from a TMX map file.
      *
-     * @param mapFileName Path to the TMX map file to load.
+     * @param mapFileName Path to the TMX map file; see MapManager (a level built off the
+     *        window thread needs the map preloaded).
+     * @param seed Seed for per-actor random number generators; a fixed seed makes runs reproducible.
+     * @param playerCount Players spawned at the map's player object (1..PlayerConfig::MAX_PLAYERS).
      */
-    GameLevel(std::string_view mapFileName);
+    GameLevel(std::string_view mapFileName, std::uint32_t seed = std::random_device{}(), std::size_t playerCount = 1);
+
+    /**
+     * @brief Destroy the level; active actions are cleared before the actors they refer to.
+     */
+    ~GameLevel();
+
+    GameLevel(const GameLevel&) = delete;
+    GameLevel& operator=(const GameLevel&) = delete;
+
+    /**
+     * @brief Actions, collision and input services of this world.
+     */
+    WorldContext& GetContext() noexcept { return context; }
+    const WorldContext& GetContext() const noexcept { return context; }
 
     /**
      * @brief Update all actors and internal state for the level.
+     *
+     * @param delta Simulation time step in seconds.
+     */
+    void UpdateAll(float delta);
+
+    /**
+     * @brief Simulate one tick: dispatch input, perform the active actions and update all actors.
+     *
+     * @param delta Simulation time step in seconds.
      */
-    void UpdateAll();
+    void Step(float delta);
+
+    /**
+     * @brief Seed the level was created with.
+     */
+    std::uint32_t GetSeed() const noexcept { return seed; }
+
+    /**
+     * @brief Derive the RNG seed for the next spawned actor from the level seed.
+     *
+     * Seeds depend only on the level seed and spawn order, so actors get the same
+     * random sequences in every run that uses the same level seed.
+     */
+    std::uint32_t NextActorSeed() noexcept;
 
     /**
      * @brief Render the level and all actors.
@@ -44,17 +98,77 @@ public:
     void Render();
 
     /**
-     * @brief Return a pointer to the Player actor in this level.
+     * @brief Capture what the next frame shows (camera, actor sprites, HUD values).
+     *
+     * Reads simulation state only, so it runs on the thread that updates the level.
+     */
+    void CaptureRenderState(RenderState& state) const;
+
+    /**
+     * @brief Draw a captured render state (GL thread).
      *
-     * @return Player* Pointer to the Player instance or nullptr when no player exists.
+     * Only the camera and the animated tilemap are touched, so the simulation may update
+     * the level concurrently.
      */
-    Player* GetPlayer() const;
+    void Render(const RenderState& state);
+
+    /**
+     * @brief Return a pointer to a Player actor in this level.
+     *
+     * @param index Player slot (0 is the first player).
+     * @return Player* Pointer to the Player instance or nullptr when the slot is empty.
+     */
+    Player* GetPlayer(std::size_t index = 0) const;
+
+    /**
+     * @brief Number of occupied player slots.
+     */
+    std::size_t GetPlayerCount() const noexcept;
+
+    /**
+     * @brief Player the camera follows and whose lives the HUD shows.
+     */
+    void SetViewPlayer(std::size_t index) noexcept { viewPlayer = index; }
 
     /**
      * @brief Return the cached ground layer pointer (non-owning).
      */
     TmxLayer const* GetCachedGroundLayer() const { return groundLayer; }
 
+    /**
+     * @brief Collision shapes of the ground layer, baked at load time.
+     */
+    const TileCollisionGrid& GetCollisionGrid() const { return collisionGrid; }
+
+    /**
+     * @brief Cached line-of-sight queries against the collision grid (safe from update jobs).
+     */
+    const LineOfSightCache& GetLineOfSight() const { return lineOfSight; }
+
+    /**
+     * @brief Platform navigation graph of the ground layer, with the flow field towards the player.
+     */
+    const NavGraph& GetNavGraph() const { return navGraph; }
+
+    /**
+     * @brief Trigger volumes of the "triggers" object layer (exits, damage zones, checkpoints).
+     */
+    const TriggerSystem& GetTriggers() const { return triggers; }
+
+    /**
+     * @brief Select the body integration kernel (to check SIMD paths against the scalar one).
+     */
+    void SetIntegrationPath(BodyIntegrator::Path path) noexcept { bodies.SetPath(path); }
+
+    /** Body integration kernel in use. */
+    BodyIntegrator::Path GetIntegrationPath() const noexcept { return bodies.GetPath(); }
+
+    /**
+     * @brief Batched walking of the level's patrolling actors.
+     */
+    PatrolSystem& GetPatrols() noexcept { return patrols; }
+    const PatrolSystem& GetPatrols() const noexcept { return patrols; }
+
     /**
      * @brief Accessor for the TMX map pointer.
      */
@@ -68,8 +182,8 @@ public:
     /**
      * @brief Add an actor of type T to the level.
      *
-     * The actor is constructed in-place and stored in the level's actor container. When
-     * adding a Player, any existing Player instance will be replaced.
+     * The actor is constructed in-place and stored in the level's actor container. A Player
+     * takes the first free player slot (replacing the last player when all are taken).
      */
     template <typename T, typename... Args>
     T& addActor(Args&&... args) {
@@ -77,10 +191,14 @@ public:
         auto actor = std::make_unique<T>(*this, std::forward<Args>(args)...);
         T& ref = *actor;  // reference to created actor
 
-        // If adding a Player, ensure there's at most one Player in the level.
+        // Players live in the dedicated player slots
         if constexpr (std::is_base_of_v<Player, T>) {
-            // Store the new Player in the dedicated player slot.
-            player = std::move(actor);
+            std::size_t index = 0;
+            while (index + 1 < players.size() && players[index]) {
+                ++index;
+            }
+            ref.SetPlayerIndex(index);
+            players[index] = std::move(actor);
             return ref;
         }
 
@@ -90,15 +208,71 @@ public:
     }
 
     /**
-     * @brief Reset level state: keep Player but move to start; recreate other actors from TMX.
+     * @brief Reset level state by restoring the snapshot taken after the first spawn.
+     *
+     * Actors are restored in place (including ones retired after death), so a restart does
+     * not re-read the TMX map or allocate new actors. The players keep their remaining lives
+     * and start at the last checkpoint reached, if any.
      */
     void Reset();
 
+    /**
+     * @brief Start a new game on the loaded level: like Reset, but the players get their full lives back
+     * and start at the level start.
+     */
+    void Restart();
+
+    /**
+     * @brief Spawn additional zombies standing on random walkable spans (benchmark scenes).
+     *
+     * Positions are drawn from the level seed, so a scene is identical in every run. The
+     * initial snapshot is captured again, so Reset and Restart bring the extra zombies back.
+     * Call on a new or just restarted level.
+     *
+     * @return Number of zombies spawned (0 when the level has no walkable spans).
+     */
+    std::size_t SpawnExtraZombies(std::size_t count);
+
+    /**
+     * @brief Wall time of the collision pass of the last UpdateAll in milliseconds.
+     */
+    float GetCollisionMillis() const noexcept { return collisionMillis; }
+
+    /**
+     * @brief Capture the complete simulation state (actors, players, actions, level state) of the level.
+     *
+     * Records are written by spawn slot; after the first call the output vectors are reused
+     * without reallocation.
+     *
+     * @param state Output state.
+     */
+    void SaveWorldState(WorldState& state) const;
+
+    /**
+     * @brief Restore a state captured with SaveWorldState.
+     *
+     * Active actions are replaced, retired actors are brought back and every actor is
+     * restored in place. Actors that were dead at the captured tick are retired again on
+     * the next update.
+     *
+     * @param state State to apply.
+     */
+    void RestoreWorldState(const WorldState& state);
+
     /**
      * @brief Handle game over state.
      */
     void GameOver();
 
+    /**
+     * @brief A player's death fade has ended and the life it lost is taken.
+     *
+     * A single player resets the level (or ends it when out of lives). In co-op only this
+     * player respawns while the others play on; a player out of lives stays out, and the
+     * game is over once every player is.
+     */
+    void OnPlayerDied(Player& player);
+
     /**
      * @brief Query whether the game is over.
      *
@@ -106,6 +280,28 @@ public:
      */
     bool IsGameOver() const noexcept { return levelState == LevelState::LEVEL_GAME_OVER; }
 
+    /**
+     * @brief Query whether a player reached an exit of the level.
+     */
+    bool IsCompleted() const noexcept { return levelState == LevelState::LEVEL_COMPLETED; }
+
+    /**
+     * @brief Query whether the level ended, by game over or by reaching an exit.
+     */
+    bool IsFinished() const noexcept { return IsGameOver() || IsCompleted(); }
+
+    /**
+     * @brief Handle trigger volumes: a player entering an exit completes the level, damage zones hurt their occupants.
+     */
+    void OnEvents(std::span<const TriggerEvent> events) override;
+
+    /**
+     * @brief Query whether the TMX map was loaded.
+     *
+     * @return false when the map file could not be loaded (the level is empty).
+     */
+    bool IsLoaded() const noexcept { return map != nullptr; }
+
     /**
      * @brief Get the bottom edge of the map.
      *
@@ -118,20 +314,67 @@ private:
     const TmxLayer* FindLayerByName(const char* name) const;
     // Helper to spawn actors from the TMX actors layer
     void SpawnActorsFromMap(bool createPlayer);
+    // Helper to assign spawn slots and record the initial snapshot of all spawned actors
+    void CaptureInitialSnapshot();
+    // Put a co-op player back at its start or the checkpoint, keeping its lives
+    void RespawnPlayer(Player& player);
+    // Stand a player on the bottom of the checkpoint volume (co-op players side by side)
+    void MoveToCheckpoint(Player& player);
+    // Helper to resolve a spawn slot (including the player slot) to a live actor pointer
+    Actor* FindActorBySlot(std::uint32_t slot) const;
     // Helper to draw the HUD (lives, score, etc.)
-    void DrawHUD();
+    void DrawHUD(const RenderState& state);
+    // Helper to run the update phases of all non-player actors on the job system
+    void UpdateActorsParallel(float delta);
 
+    // per-world actions, collisions and input; declared first so it outlives the actors
+    WorldContext context;
     TmxMap* map = nullptr;  // Pointer to the TMX map
     // Cached pointer to the tile layer named "ground" (non-owning)
     const TmxLayer* groundLayer = nullptr;
+    // ground collision shapes per tile cell, queried without allocating
+    TileCollisionGrid collisionGrid;
+    // cell-pair visibility shared by all enemies looking for the player
+    LineOfSightCache lineOfSight{collisionGrid};
+    // walkable spans, drop and jump edges for enemy routing
+    NavGraph navGraph;
+    // exits, damage zones and checkpoints with their per-cell lookup table
+    TriggerSystem triggers;
+    // Batched patrol walking; declared before the actor lists so it outlives the members it points to
+    PatrolSystem patrols;
     // container of actors belonging to this level
     std::vector<std::unique_ptr<Actor>> actors;
-    // Dedicated slot for the Player actor (separate from other actors so it can be drawn on top)
-    std::unique_ptr<Player> player;
-    // listeners called when an actor is removed
-    std::vector<std::function<void(const Actor&)>> removalListeners;
+    // actors updated this frame, their batched bodies (or null) and per-chunk deferred action
+    // changes (storage reused between frames)
+    std::vector<Actor*> updateList;
+    std::vector<Movable*> updateBodies;
+    std::vector<CommandBuffer> chunkCommands;
+    // structure-of-arrays physics state of updateBodies, integrated chunk by chunk
+    BodyIntegrator bodies;
+    // dead actors removed from play; kept alive so Reset can restore them without reallocation
+    std::vector<std::unique_ptr<Actor>> retiredActors;
+    // initial state of all actors, captured once after the first spawn
+    WorldState initialSnapshot;
+    // number of spawn slots handed out by CaptureInitialSnapshot
+    std::uint32_t spawnSlotCount = 0;
+    // Dedicated slots for the Player actors (separate from other actors so they can be drawn on top)
+    std::array<std::unique_ptr<Player>, PlayerConfig::MAX_PLAYERS> players;
+    // players spawned at the map's player object, and the one the camera follows
+    std::size_t spawnPlayerCount = 1;
+    std::size_t viewPlayer = 0;
     // camera object for rendering
     Camera2D camera = {0};
-    // level state
-    LevelState levelState = LevelState::LEVEL_RUNNING;
+    // render state reused by Render() when capture and drawing happen on the same thread
+    RenderState renderState;
+    // level state; atomic because the render thread polls it in pipelined mode
+    std::atomic<LevelState> levelState{LevelState::LEVEL_RUNNING};
+    // simulation time spent showing the game over message
+    float gameOverTimer = 0.0f;
+    // trigger index of the last checkpoint a player entered; players respawn there
+    std::uint32_t checkpoint = WorldState::NO_CHECKPOINT;
+    // wall time of the last collision pass (benchmarks)
+    float collisionMillis = 0.0f;
+    // seed for per-actor RNGs and number of seeds handed out so far
+    std::uint32_t seed = 0;
+    std::uint32_t actorSeedCount = 0;
 };
\ No newline at end of file
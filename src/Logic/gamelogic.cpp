@@ -1,15 +1,30 @@
 #include "gamelogic.h"
+#include "move.h"
+#include "jump.h"
+#include "profiler.h"
+#include "config.hpp"
+#include "command_buffer.h"
 
-GameLogic& GameLogic::Instance() {
-    static GameLogic instance;
-    return instance;
+GameLogic::GameLogic() {
+    // Warm up action storage so gameplay does not allocate when actions come and go
+    actions.reserve(ActionConfig::ACTION_RESERVE);
+    ActionPool::Instance().Reserve(ActionConfig::ACTION_RESERVE);
 }
 
 void GameLogic::RegisterAction(std::unique_ptr<Action> action) {
+    // inside a parallel update job: defer until the job's buffer is applied
+    if (CommandBuffer* commands = CommandBuffer::Active()) {
+        commands->RegisterAction(std::move(action));
+        return;
+    }
     actions.push_back(std::move(action));
 }
 
 bool GameLogic::DeregisterAction(Action* actionPtr) {
+    if (CommandBuffer* commands = CommandBuffer::Active()) {
+        commands->DeregisterAction(actionPtr);
+        return true;
+    }
     for (auto it = actions.begin(); it != actions.end(); ++it) {
         if (it->get() == actionPtr) {
             actions.erase(it);
@@ -19,10 +34,29 @@ bool GameLogic::DeregisterAction(Action* actionPtr) {
     return false;
 }
 
-void GameLogic::Update() {
-    // get delta time for this frame
-    float delta = GetFrameTime();
+void GameLogic::DeregisterActions(const Actor& actor) {
+    std::erase_if(actions, [&actor](const std::unique_ptr<Action>& action) { return &action->GetActor() == &actor; });
+}
+
+std::unique_ptr<Action> GameLogic::CreateAction(Actor& target, const ActionSnapshot& snapshot) {
+    std::unique_ptr<Action> action;
+    switch (snapshot.kind) {
+        case ActionSnapshot::Kind::Move:
+            action = std::make_unique<Move>(target, snapshot.direction, snapshot.param);
+            break;
+        case ActionSnapshot::Kind::Jump:
+            action = std::make_unique<Jump>(target, snapshot.param);
+            break;
+    }
+    if (action) {
+        action->RestoreTiming(snapshot);
+    }
+    return action;
+}
 
+void GameLogic::Update(float delta) {
+    PROFILE_ZONE("Actions");
+    PROFILE_COUNT(Actions, static_cast<std::int64_t>(actions.size()));
     // Perform each action; advance time; remove expired
     for (auto it = actions.begin(); it != actions.end();) {
         Action* a = it->get();
@@ -5,30 +5,46 @@
 #include <memory>
 
 /**
- * @brief Simple global action manager.
+ * @brief Simple action manager of one world (see WorldContext).
  *
  * Owns and updates `Action` instances, removing them when they expire.
  */
 class GameLogic {
 public:
-    static GameLogic& Instance();
+    GameLogic();
+    ~GameLogic() = default;
+    GameLogic(const GameLogic&) = delete;
+    GameLogic& operator=(const GameLogic&) = delete;
 
     // register an action - ownership is transferred to GameLogic
+    // (recorded into the thread's CommandBuffer while one is active, as are deregistrations)
     void RegisterAction(std::unique_ptr<Action> action);
 
-    // deregister and destroy an action by pointer (returns true if found)
+    // deregister and destroy an action by pointer (returns true if found, always true when deferred)
     bool DeregisterAction(Action* actionPtr);
 
-    // Update all active actions; remove expired ones
-    void Update();
+    // deregister and destroy every action on an actor (not deferred: outside parallel update jobs only)
+    void DeregisterActions(const Actor& actor);
+
+    // Update all active actions by delta seconds; remove expired ones
+    void Update(float delta);
 
     void Cleanup() { actions.clear(); }
 
-private:
-    GameLogic() = default;
-    ~GameLogic() = default;
-    GameLogic(const GameLogic&) = delete;
-    GameLogic& operator=(const GameLogic&) = delete;
+    /**
+     * @brief Read-only access to active actions in execution order.
+     */
+    const std::vector<std::unique_ptr<Action>>& GetActions() const { return actions; }
 
+    /**
+     * @brief Recreate an action from a snapshot record, including its timing.
+     *
+     * @param target Actor the action operates on.
+     * @param snapshot Record captured with `Action::SaveSnapshot`.
+     * @return std::unique_ptr<Action> New action (not registered yet).
+     */
+    static std::unique_ptr<Action> CreateAction(Actor& target, const ActionSnapshot& snapshot);
+
+private:
     std::vector<std::unique_ptr<Action>> actions;
 };
@@ -0,0 +1,126 @@
+#include "job_system.h"
+#include <algorithm>
+#include "config.hpp"
+
+namespace {
+// set by SetWorkerCount before the pool is created; 0 = JobConfig default
+std::atomic<std::size_t> workerCountOverride{0};
+}  // namespace
+
+JobSystem& JobSystem::Instance() {
+    static JobSystem instance;
+    return instance;
+}
+
+void JobSystem::SetWorkerCount(std::size_t count) noexcept {
+    workerCountOverride.store(count, std::memory_order_relaxed);
+}
+
+JobSystem::JobSystem() {
+    std::size_t workers = workerCountOverride.load(std::memory_order_relaxed);
+    if (workers == 0) {
+        workers = JobConfig::WORKER_THREADS;
+    }
+    if (workers == 0) {
+        // leave one core for the render thread and the OS
+        workers = std::max<std::size_t>(std::thread::hardware_concurrency(), 2) - 1;
+    }
+    workers = std::min(workers, JobConfig::MAX_WORKER_THREADS);
+
+    for (std::size_t i = 0; i < workers; ++i) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    // queue 0 is served by the thread calling ParallelFor; the others get their own threads
+    for (std::size_t i = 1; i < workers; ++i) {
+        threads.emplace_back([this, i] { WorkerLoop(i); });
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+bool JobSystem::WorkerQueue::Push(const Job& job) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (size == CAPACITY) return false;
+    ring[(head + size) % CAPACITY] = job;
+    ++size;
+    return true;
+}
+
+bool JobSystem::WorkerQueue::PopBack(Job& job) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (size == 0) return false;
+    --size;
+    job = ring[(head + size) % CAPACITY];
+    return true;
+}
+
+bool JobSystem::WorkerQueue::StealFront(Job& job) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (size == 0) return false;
+    job = ring[head];
+    head = (head + 1) % CAPACITY;
+    --size;
+    return true;
+}
+
+void JobSystem::Execute(const Job& job) {
+    job.group->invoke(job.group->context, job.chunk, job.begin, job.end);
+    job.group->pending.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+bool JobSystem::TryRunOne(std::size_t worker) {
+    Job job;
+    bool found = queues[worker]->PopBack(job);
+    // own queue empty: steal from the others, starting with the next worker
+    for (std::size_t i = 1; !found && i < queues.size(); ++i) {
+        found = queues[(worker + i) % queues.size()]->StealFront(job);
+    }
+    if (!found) return false;
+    queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+    Execute(job);
+    return true;
+}
+
+void JobSystem::Run(JobGroup& group, std::size_t count, std::size_t chunkSize, std::size_t chunks) {
+    group.pending.store(chunks, std::memory_order_relaxed);
+    // deal chunks round-robin so every worker starts with local work
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+        const std::size_t begin = chunk * chunkSize;
+        const Job job{&group, chunk, begin, std::min(begin + chunkSize, count)};
+        if (queues[chunk % queues.size()]->Push(job)) {
+            queuedJobs.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            Execute(job);  // queue full: run it right away
+        }
+    }
+    {
+        // taking the lock orders the notification after a worker's predicate check
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    wake.notify_all();
+
+    // help until the whole group is done
+    while (group.pending.load(std::memory_order_acquire) > 0) {
+        if (!TryRunOne(0)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::WorkerLoop(std::size_t worker) {
+    for (;;) {
+        if (TryRunOne(worker)) continue;
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this] { return stopping || queuedJobs.load(std::memory_order_relaxed) > 0; });
+        if (stopping) return;
+    }
+}
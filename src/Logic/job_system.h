@@ -0,0 +1,125 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Work-stealing thread pool for data-parallel frame phases.
+ *
+ * `ParallelFor` splits an index range into fixed-size chunks, spreads them over the
+ * per-worker queues and lets the calling thread help until every chunk has run.
+ * Idle workers steal from the front of other queues while owners pop from the back.
+ *
+ * Chunk boundaries depend only on the range and chunk size, never on scheduling, so
+ * per-chunk outputs merged in chunk order give the same result as a serial loop.
+ * Ranges that fit in a single chunk run inline without waking any worker.
+ *
+ * Queues are fixed-size rings, so scheduling work never allocates.
+ */
+class JobSystem {
+public:
+    static JobSystem& Instance();
+
+    /**
+     * @brief Override the number of job threads (including the calling thread); call before the first Instance().
+     *
+     * Processes sharing the machine, like parallel soak runs, split the cores this way.
+     * 0 keeps the JobConfig default; later calls have no effect on the created pool.
+     */
+    static void SetWorkerCount(std::size_t count) noexcept;
+
+    /**
+     * @brief Number of threads executing jobs, including the thread calling ParallelFor.
+     */
+    std::size_t GetWorkerCount() const noexcept { return queues.size(); }
+
+    /**
+     * @brief Number of chunks ParallelFor uses for a range.
+     */
+    static std::size_t ChunkCount(std::size_t count, std::size_t chunkSize) noexcept {
+        return chunkSize == 0 ? 0 : (count + chunkSize - 1) / chunkSize;
+    }
+
+    /**
+     * @brief Run fn(chunk, begin, end) for every chunk of [0, count) and wait for completion.
+     *
+     * Must not be called from inside a job. Several threads (e.g. independent worlds)
+     * may call it at the same time; each waits only for its own chunks.
+     *
+     * @param count Number of items.
+     * @param chunkSize Items per chunk (> 0).
+     * @param fn Callable invoked as fn(std::size_t chunk, std::size_t begin, std::size_t end).
+     */
+    template <typename Fn>
+    void ParallelFor(std::size_t count, std::size_t chunkSize, Fn&& fn) {
+        const std::size_t chunks = ChunkCount(count, chunkSize);
+        if (chunks == 0) return;
+        if (chunks == 1 || queues.size() == 1) {
+            for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+                const std::size_t begin = chunk * chunkSize;
+                fn(chunk, begin, std::min(begin + chunkSize, count));
+            }
+            return;
+        }
+        using Callable = std::remove_reference_t<Fn>;
+        JobGroup group;
+        group.context = const_cast<void*>(static_cast<const void*>(&fn));
+        group.invoke = [](void* context, std::size_t chunk, std::size_t begin, std::size_t end) {
+            (*static_cast<Callable*>(context))(chunk, begin, end);
+        };
+        Run(group, count, chunkSize, chunks);
+    }
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+private:
+    JobSystem();
+    ~JobSystem();
+
+    struct JobGroup {
+        void (*invoke)(void*, std::size_t, std::size_t, std::size_t) = nullptr;
+        void* context = nullptr;
+        std::atomic<std::size_t> pending{0};
+    };
+
+    struct Job {
+        JobGroup* group;
+        std::size_t chunk;
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    /* Mutex-guarded ring deque; the owner works at the back, thieves take from the front */
+    struct WorkerQueue {
+        static constexpr std::size_t CAPACITY = 1024;
+        std::mutex mutex;
+        std::array<Job, CAPACITY> ring;
+        std::size_t head = 0;  // index of the front job
+        std::size_t size = 0;
+
+        bool Push(const Job& job);
+        bool PopBack(Job& job);
+        bool StealFront(Job& job);
+    };
+
+    void Run(JobGroup& group, std::size_t count, std::size_t chunkSize, std::size_t chunks);
+    bool TryRunOne(std::size_t worker);
+    static void Execute(const Job& job);
+    void WorkerLoop(std::size_t worker);
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues; /**< queues[0] belongs to the calling (main) thread. */
+    std::vector<std::thread> threads;
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::atomic<std::size_t> queuedJobs{0};
+    bool stopping = false;
+};
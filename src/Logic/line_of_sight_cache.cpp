@@ -0,0 +1,58 @@
+#include "line_of_sight_cache.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr std::uint64_t VALID_BIT = 2;
+constexpr std::uint64_t VISIBLE_BIT = 1;
+constexpr std::uint32_t MAX_CELL_INDEX = (1u << 31) - 1;
+}  // namespace
+
+void LineOfSightCache::Clear() noexcept {
+    for (auto& entry : entries) {
+        entry.store(0, std::memory_order_relaxed);
+    }
+}
+
+bool LineOfSightCache::CastBetweenCells(std::uint32_t first, std::uint32_t second) const noexcept {
+    const auto width = static_cast<std::uint32_t>(grid.GetWidth());
+    const auto centre = [&](std::uint32_t cell) {
+        return Vector2{(static_cast<float>(cell % width) + 0.5f) * grid.GetTileWidth(),
+                       (static_cast<float>(cell / width) + 0.5f) * grid.GetTileHeight()};
+    };
+    TileRayHit hit;
+    return !grid.Raycast(centre(first), centre(second), hit);
+}
+
+bool LineOfSightCache::HasLineOfSight(Vector2 from, Vector2 to) const noexcept {
+    const int width = grid.GetWidth();
+    const int height = grid.GetHeight();
+    if (width == 0 || height == 0) return true;  // no ground layer: nothing blocks the view
+
+    // points outside the map are clamped to its border cells
+    const auto cellOf = [&](Vector2 point) {
+        const int x = std::clamp(static_cast<int>(std::floor(point.x / grid.GetTileWidth())), 0, width - 1);
+        const int y = std::clamp(static_cast<int>(std::floor(point.y / grid.GetTileHeight())), 0, height - 1);
+        return static_cast<std::uint32_t>(y) * static_cast<std::uint32_t>(width) + static_cast<std::uint32_t>(x);
+    };
+    const std::uint32_t a = cellOf(from);
+    const std::uint32_t b = cellOf(to);
+    const std::uint32_t first = std::min(a, b);
+    const std::uint32_t second = std::max(a, b);
+    if (second > MAX_CELL_INDEX) {
+        return CastBetweenCells(first, second);  // too large to pack; never cached
+    }
+
+    const std::uint64_t key = (static_cast<std::uint64_t>(first) << 33) | (static_cast<std::uint64_t>(second) << 2);
+    // multiplicative hash of the pair, top bits select the slot
+    const std::uint64_t mixed = (key | VALID_BIT) * 0x9E3779B97F4A7C15ull;
+    std::atomic<std::uint64_t>& entry = entries[mixed >> (64 - SLOT_BITS)];
+
+    const std::uint64_t cached = entry.load(std::memory_order_relaxed);
+    if ((cached & ~VISIBLE_BIT) == (key | VALID_BIT)) {
+        return (cached & VISIBLE_BIT) != 0;
+    }
+    const bool visible = CastBetweenCells(first, second);
+    entry.store(key | VALID_BIT | (visible ? VISIBLE_BIT : 0), std::memory_order_relaxed);
+    return visible;
+}
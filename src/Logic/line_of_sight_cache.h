@@ -0,0 +1,55 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include "raylib.h"
+#include "config.hpp"
+#include "tile_collision_grid.h"
+
+/**
+ * @brief Shared line-of-sight answers between tile cells, backed by grid raycasts.
+ *
+ * Queries are reduced to a pair of cells and answered by a ray between the two cell
+ * centres, so all enemies looking from one cell at a target in another cell share a
+ * single raycast. Pairs are stored unordered (and cast from the lower cell index), which
+ * makes the answer symmetric.
+ *
+ * The table is direct-mapped with one atomic word per entry: lookups and inserts are
+ * lock-free and safe from the job workers of the AI phase. Colliding pairs simply
+ * replace each other. Because the ground layer never changes while a level runs, an
+ * answer stays valid across ticks; Clear is only needed after the grid is rebuilt.
+ */
+class LineOfSightCache {
+public:
+    /**
+     * @param grid Collision grid to cast against; must outlive the cache.
+     */
+    explicit LineOfSightCache(const TileCollisionGrid& grid) : grid(grid) { Clear(); }
+
+    LineOfSightCache(const LineOfSightCache&) = delete;
+    LineOfSightCache& operator=(const LineOfSightCache&) = delete;
+
+    /**
+     * @brief Whether no solid cell lies between the cells containing two world points.
+     */
+    bool HasLineOfSight(Vector2 from, Vector2 to) const noexcept;
+
+    /**
+     * @brief Forget all cached answers.
+     */
+    void Clear() noexcept;
+
+private:
+    static constexpr std::size_t ENTRIES = LineOfSightConfig::CACHE_ENTRIES;
+    static_assert(ENTRIES >= 2 && std::has_single_bit(ENTRIES), "cache size must be a power of two");
+    static constexpr int SLOT_BITS = std::countr_zero(ENTRIES);
+
+    // Uncached answer for a pair of cell indices
+    bool CastBetweenCells(std::uint32_t first, std::uint32_t second) const noexcept;
+
+    const TileCollisionGrid& grid;
+    /* Entry layout: first cell (bits 33..63) | second cell (bits 2..32) | valid (bit 1) | visible (bit 0) */
+    mutable std::array<std::atomic<std::uint64_t>, ENTRIES> entries;
+};
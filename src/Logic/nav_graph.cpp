@@ -0,0 +1,284 @@
+#include "nav_graph.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include "config.hpp"
+
+namespace {
+constexpr float INF = std::numeric_limits<float>::infinity();
+}  // namespace
+
+void NavGraph::Build(const TileCollisionGrid& grid, const Agent& agent) {
+    spans.clear();
+    edges.clear();
+    cellSpan.clear();
+    nextEdgeCache.reset();
+    flowTargets.clear();
+    width = grid.GetWidth();
+    height = grid.GetHeight();
+    tileWidth = grid.GetTileWidth();
+    tileHeight = grid.GetTileHeight();
+    cellSpan.assign(static_cast<std::size_t>(width) * height, NAV_NONE);
+
+    // a cell can be stood on when it is solid and the cells above it are free
+    const auto standable = [&](int x, int y) {
+        if (!grid.IsSolidCell(x, y)) return false;
+        for (int k = 1; k <= agent.clearanceCells; ++k) {
+            if (grid.IsSolidCell(x, y - k)) return false;
+        }
+        return true;
+    };
+
+    // Spans: horizontal runs of standable cells, row by row
+    for (int y = 0; y < height; ++y) {
+        int x = 0;
+        while (x < width) {
+            if (!standable(x, y)) {
+                ++x;
+                continue;
+            }
+            NavSpan span;
+            span.row = y;
+            span.firstCell = x;
+            while (x < width && standable(x, y)) {
+                cellSpan[static_cast<std::size_t>(y) * width + x] = static_cast<std::int32_t>(spans.size());
+                ++x;
+            }
+            span.lastCell = x - 1;
+            span.left = span.firstCell * tileWidth;
+            span.right = (span.lastCell + 1) * tileWidth;
+            // stand on the actual shapes, which may be thinner than the cell
+            const Rectangle surfaceRow{span.left, y * tileHeight, span.right - span.left, tileHeight};
+            if (!grid.FindHighestTop(surfaceRow, span.top)) {
+                span.top = y * tileHeight;
+            }
+            spans.push_back(span);
+        }
+    }
+
+    // Drop edges: walk off either end of a span (if no wall is in the way) and fall straight down
+    for (std::uint32_t s = 0; s < spans.size(); ++s) {
+        const NavSpan& span = spans[s];
+        for (const int column : {span.firstCell - 1, span.lastCell + 1}) {
+            if (column < 0 || column >= width) continue;
+            bool blocked = false;
+            for (int k = 0; k <= agent.clearanceCells; ++k) {
+                blocked = blocked || grid.IsSolidCell(column, span.row - k);
+            }
+            if (blocked) continue;
+            for (int y = span.row + 1; y < height; ++y) {
+                if (!grid.IsSolidCell(column, y)) continue;
+                const std::int32_t target = cellSpan[static_cast<std::size_t>(y) * width + column];
+                if (target != NAV_NONE) {
+                    const float fall = spans[target].top - span.top;
+                    edges.push_back({s, static_cast<std::uint32_t>(target), NavEdgeType::Drop, column, column,
+                                     tileWidth + fall});
+                }
+                break;
+            }
+        }
+    }
+
+    // Jump edges between every pair of spans within reach
+    for (std::uint32_t a = 0; a < spans.size(); ++a) {
+        for (std::uint32_t b = 0; b < spans.size(); ++b) {
+            if (a != b) TryAddJump(a, b, agent);
+        }
+    }
+    FinishEdges();
+
+    // Query storage is reserved here so routing never allocates during play
+    const std::size_t spanCount = spans.size();
+    if (spanCount > 0 && spanCount <= NavConfig::PATH_CACHE_MAX_SPANS) {
+        nextEdgeCache = std::make_unique<std::atomic<std::int32_t>[]>(spanCount * spanCount);
+        for (std::size_t i = 0; i < spanCount * spanCount; ++i) {
+            nextEdgeCache[i].store(NAV_UNKNOWN, std::memory_order_relaxed);
+        }
+    }
+    scratch.cost.assign(spanCount, INF);
+    scratch.via.assign(spanCount, NAV_NONE);
+    scratch.closed.assign(spanCount, 0);
+    scratch.open.clear();
+    scratch.open.reserve(edges.size() + 1);
+    flowNextEdge.assign(spanCount, NAV_NONE);
+    flowGoal.assign(spanCount, NAV_NONE);
+    flowDistance.assign(spanCount, INF);
+    flowOpen.clear();
+    flowOpen.reserve(edges.size() + 1);
+}
+
+/**
+ * @brief Add a jump from span a to span b if the arc can reach it.
+ *
+ * Rising by h needs h <= v^2 / 2g; the time until the descending arc is back at height h
+ * is t = (v + sqrt(v^2 - 2gh)) / g, which bounds the horizontal gap to runSpeed * t.
+ */
+void NavGraph::TryAddJump(std::uint32_t a, std::uint32_t b, const Agent& agent) {
+    const NavSpan& from = spans[a];
+    const NavSpan& to = spans[b];
+    if (agent.gravity <= 0.0f || agent.jumpStrength <= 0.0f) return;
+    const float rise = from.top - to.top;  // positive when the target is higher
+    const float v = agent.jumpStrength;
+    const float discriminant = v * v - 2.0f * agent.gravity * rise;
+    if (discriminant < 0.0f) return;
+    const float reach = agent.runSpeed * (v + std::sqrt(discriminant)) / agent.gravity;
+
+    int takeoff, landing;
+    float gap;
+    if (to.firstCell > from.lastCell) {
+        takeoff = from.lastCell;
+        landing = to.firstCell;
+        gap = to.left - from.right;
+    } else if (to.lastCell < from.firstCell) {
+        takeoff = from.firstCell;
+        landing = to.lastCell;
+        gap = from.left - to.right;
+    } else {
+        // overlapping columns: only worth a jump when the target is above (lower ones are drops);
+        // platforms are one-way, so the actor jumps through it from below
+        if (rise <= 0.0f) return;
+        takeoff = landing = std::max(from.firstCell, to.firstCell);
+        gap = 0.0f;
+    }
+    // the actor takes off from the centre of the takeoff cell
+    if (gap + tileWidth * 0.5f > reach) return;
+
+    const float dx = std::fabs(GetCellCentreX(landing) - GetCellCentreX(takeoff));
+    edges.push_back({a, b, NavEdgeType::Jump, takeoff, landing, dx + std::fabs(rise) + NavConfig::JUMP_EDGE_PENALTY});
+}
+
+void NavGraph::FinishEdges() {
+    std::sort(edges.begin(), edges.end(), [](const NavEdge& lhs, const NavEdge& rhs) {
+        if (lhs.from != rhs.from) return lhs.from < rhs.from;
+        if (lhs.to != rhs.to) return lhs.to < rhs.to;
+        return lhs.type < rhs.type;
+    });
+    const std::size_t spanCount = spans.size();
+    edgeStart.assign(spanCount + 1, 0);
+    incomingStart.assign(spanCount + 1, 0);
+    for (const NavEdge& edge : edges) {
+        ++edgeStart[edge.from + 1];
+        ++incomingStart[edge.to + 1];
+    }
+    for (std::size_t s = 0; s < spanCount; ++s) {
+        edgeStart[s + 1] += edgeStart[s];
+        incomingStart[s + 1] += incomingStart[s];
+    }
+    incomingEdges.assign(edges.size(), 0);
+    std::vector<std::uint32_t> fill(incomingStart.begin(), incomingStart.end() - 1);
+    for (std::uint32_t e = 0; e < edges.size(); ++e) {
+        incomingEdges[fill[edges[e].to]++] = e;
+    }
+}
+
+std::int32_t NavGraph::FindSpan(Vector2 feet) const noexcept {
+    if (width == 0 || height == 0) return NAV_NONE;
+    const int x = static_cast<int>(std::floor(feet.x / tileWidth));
+    if (x < 0 || x >= width) return NAV_NONE;
+    // the feet rest on (or, after the ground snap, one pixel inside) the surface cell
+    for (const float y : {feet.y, feet.y + 1.0f}) {
+        const int row = static_cast<int>(std::floor(y / tileHeight));
+        if (row < 0 || row >= height) continue;
+        const std::int32_t span = cellSpan[static_cast<std::size_t>(row) * width + x];
+        if (span != NAV_NONE) return span;
+    }
+    return NAV_NONE;
+}
+
+std::int32_t NavGraph::FindNextEdge(std::uint32_t from, std::uint32_t to) const {
+    if (from == to || from >= spans.size() || to >= spans.size()) return NAV_NONE;
+    std::atomic<std::int32_t>* cached = nextEdgeCache ? &nextEdgeCache[from * spans.size() + to] : nullptr;
+    if (cached != nullptr) {
+        const std::int32_t edge = cached->load(std::memory_order_relaxed);
+        if (edge != NAV_UNKNOWN) return edge;
+    }
+    std::lock_guard<std::mutex> lock(searchMutex);
+    const std::int32_t edge = SearchNextEdge(from, to);
+    if (cached != nullptr) {
+        cached->store(edge, std::memory_order_relaxed);
+    }
+    return edge;
+}
+
+/**
+ * @brief A* over spans; the heuristic is the height difference, which no route can beat.
+ */
+std::int32_t NavGraph::SearchNextEdge(std::uint32_t from, std::uint32_t to) const {
+    const float goalTop = spans[to].top;
+    const auto heuristic = [&](std::uint32_t span) { return std::fabs(spans[span].top - goalTop); };
+    std::fill(scratch.cost.begin(), scratch.cost.end(), INF);
+    std::fill(scratch.via.begin(), scratch.via.end(), NAV_NONE);
+    std::fill(scratch.closed.begin(), scratch.closed.end(), 0);
+    auto& open = scratch.open;
+    open.clear();
+
+    scratch.cost[from] = 0.0f;
+    open.push_back({heuristic(from), from});
+    while (!open.empty()) {
+        std::pop_heap(open.begin(), open.end(), std::greater<>{});
+        const std::uint32_t span = open.back().second;
+        open.pop_back();
+        if (scratch.closed[span]) continue;
+        if (span == to) break;
+        scratch.closed[span] = 1;
+        for (std::uint32_t e = edgeStart[span]; e < edgeStart[span + 1]; ++e) {
+            const NavEdge& edge = edges[e];
+            const float cost = scratch.cost[span] + edge.cost;
+            if (cost < scratch.cost[edge.to]) {
+                scratch.cost[edge.to] = cost;
+                scratch.via[edge.to] = static_cast<std::int32_t>(e);
+                // every edge push is bounded by the edge count, so the reserved storage suffices
+                open.push_back({cost + heuristic(edge.to), edge.to});
+                std::push_heap(open.begin(), open.end(), std::greater<>{});
+            }
+        }
+    }
+    if (scratch.via[to] == NAV_NONE) return NAV_NONE;
+
+    // walk back from the goal to the edge leaving the start span
+    std::int32_t edge = scratch.via[to];
+    while (edges[edge].from != from) {
+        edge = scratch.via[edges[edge].from];
+    }
+    return edge;
+}
+
+/**
+ * @brief Dijkstra from all targets at once over reversed edges; ties resolve by span index.
+ */
+void NavGraph::BuildFlowField(std::span<const std::uint32_t> targets) {
+    if (std::ranges::equal(targets, flowTargets)) return;
+    flowTargets.assign(targets.begin(), targets.end());
+    std::fill(flowNextEdge.begin(), flowNextEdge.end(), NAV_NONE);
+    std::fill(flowGoal.begin(), flowGoal.end(), NAV_NONE);
+    std::fill(flowDistance.begin(), flowDistance.end(), INF);
+    flowOpen.clear();
+
+    // every target starts at distance 0; the heap settles ties by span index
+    for (const std::uint32_t target : targets) {
+        if (target >= spans.size() || flowDistance[target] == 0.0f) continue;
+        flowDistance[target] = 0.0f;
+        flowGoal[target] = static_cast<std::int32_t>(target);
+        flowOpen.push_back({0.0f, target});
+        std::push_heap(flowOpen.begin(), flowOpen.end(), std::greater<>{});
+    }
+    while (!flowOpen.empty()) {
+        std::pop_heap(flowOpen.begin(), flowOpen.end(), std::greater<>{});
+        const auto [distance, span] = flowOpen.back();
+        flowOpen.pop_back();
+        if (distance > flowDistance[span]) continue;  // stale entry
+        for (std::uint32_t i = incomingStart[span]; i < incomingStart[span + 1]; ++i) {
+            const std::uint32_t e = incomingEdges[i];
+            const NavEdge& edge = edges[e];
+            const float candidate = distance + edge.cost;
+            if (candidate < flowDistance[edge.from]) {
+                flowDistance[edge.from] = candidate;
+                flowNextEdge[edge.from] = static_cast<std::int32_t>(e);
+                flowGoal[edge.from] = flowGoal[span];
+                flowOpen.push_back({candidate, edge.from});
+                std::push_heap(flowOpen.begin(), flowOpen.end(), std::greater<>{});
+            }
+        }
+    }
+}
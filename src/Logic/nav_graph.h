@@ -0,0 +1,174 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <utility>
+#include <vector>
+#include "raylib.h"
+#include "tile_collision_grid.h"
+
+/**
+ * @brief Horizontal run of standable cells: solid cells with free headroom above them.
+ */
+struct NavSpan {
+    int row = 0;        /**< Cell row of the solid surface. */
+    int firstCell = 0;  /**< First and last cell column (inclusive). */
+    int lastCell = 0;
+    float left = 0.0f;  /**< World x of the span's left and right ends. */
+    float right = 0.0f;
+    float top = 0.0f;   /**< World y of the walking surface. */
+};
+
+/**
+ * @brief Ways of getting from one span to another.
+ */
+enum class NavEdgeType : std::uint8_t {
+    Drop, /**< Walk off the span end at the takeoff column and fall onto the target. */
+    Jump  /**< Jump from the takeoff column and steer towards the landing column. */
+};
+
+/**
+ * @brief Directed connection between two spans.
+ */
+struct NavEdge {
+    std::uint32_t from = 0;
+    std::uint32_t to = 0;
+    NavEdgeType type = NavEdgeType::Drop;
+    int takeoffCell = 0; /**< Column where the actor leaves `from` (just outside it for drops). */
+    int landingCell = 0; /**< Column where the actor arrives on `to`. */
+    float cost = 0.0f;   /**< Travel distance in pixels (horizontal + vertical). */
+};
+
+/// Span or edge index meaning "none".
+inline constexpr std::int32_t NAV_NONE = -1;
+
+/**
+ * @brief Platform navigation graph baked from a level's collision grid.
+ *
+ * Nodes are walkable spans; edges are drops off span ends and jumps whose reach follows
+ * from the jump impulse and gravity (apex height v^2 / 2g, horizontal reach at the given
+ * run speed over the time of flight). Walking within a span needs no edge.
+ *
+ * Two kinds of routing queries are offered:
+ *  - `FindNextEdge` runs A* between two spans. The first edge of every queried pair is
+ *    stored in a dense, lock-free table, so repeated queries (from any thread) are a
+ *    single load. Only the queried pair is stored, which keeps results independent of the
+ *    order in which threads ask.
+ *  - `BuildFlowField` computes, for every span, the next edge towards the nearest of a few
+ *    target spans (multi-source Dijkstra over reversed edges). All actors heading to those
+ *    targets share it.
+ *
+ * The graph is immutable after Build; queries are safe from job workers (A* itself runs
+ * under a mutex with scratch storage reserved at build time, so it never allocates).
+ * BuildFlowField must not run concurrently with GetFlowEdge.
+ */
+class NavGraph {
+public:
+    /**
+     * @brief Movement abilities the graph is baked for.
+     */
+    struct Agent {
+        float jumpStrength = 0.0f; /**< Upward take-off speed (pixels per second). */
+        float gravity = 0.0f;      /**< Pixels per second squared. */
+        float runSpeed = 0.0f;     /**< Horizontal speed while airborne (pixels per second). */
+        int clearanceCells = 1;    /**< Free cells needed above a surface to stand on it. */
+    };
+
+    /**
+     * @brief Bake spans and edges from a collision grid.
+     *
+     * @param grid Baked collision grid of the level.
+     * @param agent Movement abilities deciding which jumps are possible.
+     */
+    void Build(const TileCollisionGrid& grid, const Agent& agent);
+
+    std::size_t GetSpanCount() const noexcept { return spans.size(); }
+    const NavSpan& GetSpan(std::uint32_t span) const noexcept { return spans[span]; }
+    const NavEdge& GetEdge(std::uint32_t edge) const noexcept { return edges[edge]; }
+
+    /**
+     * @brief Span an actor stands on, given the bottom centre of its collider.
+     *
+     * @return Span index or NAV_NONE when the point is not on a span.
+     */
+    std::int32_t FindSpan(Vector2 feet) const noexcept;
+
+    /**
+     * @brief World x of a cell column's centre.
+     */
+    float GetCellCentreX(int cell) const noexcept { return (static_cast<float>(cell) + 0.5f) * tileWidth; }
+
+    /**
+     * @brief First edge of the cheapest route between two spans (A*, cached per pair).
+     *
+     * @return Edge index, or NAV_NONE when from == to or the target is unreachable.
+     */
+    std::int32_t FindNextEdge(std::uint32_t from, std::uint32_t to) const;
+
+    /**
+     * @brief Compute the shared flow field towards the nearest of several spans.
+     *
+     * A no-op when it already points to the same targets. Routes of equal cost are
+     * resolved by span index, so the field does not depend on the order of the targets.
+     */
+    void BuildFlowField(std::span<const std::uint32_t> targets);
+
+    /**
+     * @brief Target span the flow field leads to from a span (NAV_NONE when unreachable or before the first build).
+     */
+    std::int32_t GetFlowTarget(std::uint32_t span) const noexcept {
+        return span < flowGoal.size() ? flowGoal[span] : NAV_NONE;
+    }
+
+    /**
+     * @brief Next edge from a span towards its nearest flow field target (NAV_NONE at a target or when unreachable).
+     */
+    std::int32_t GetFlowEdge(std::uint32_t span) const noexcept {
+        return span < flowNextEdge.size() ? flowNextEdge[span] : NAV_NONE;
+    }
+
+private:
+    /* Open-list entry: (estimated total cost, span); ordered by cost, then span index */
+    using HeapEntry = std::pair<float, std::uint32_t>;
+
+    /* A* working storage, sized by Build */
+    struct SearchScratch {
+        std::vector<float> cost;
+        std::vector<std::int32_t> via;
+        std::vector<std::uint8_t> closed;
+        std::vector<HeapEntry> open;
+    };
+
+    // Uncached A* (caller holds searchMutex); returns the first edge of the path
+    std::int32_t SearchNextEdge(std::uint32_t from, std::uint32_t to) const;
+    // Add the jump edge from span a to span b when it is within reach
+    void TryAddJump(std::uint32_t a, std::uint32_t b, const Agent& agent);
+    // Sort edges by source span and build the CSR offsets
+    void FinishEdges();
+
+    float tileWidth = 0.0f;
+    float tileHeight = 0.0f;
+    int width = 0;
+    int height = 0;
+    std::vector<NavSpan> spans;
+    std::vector<NavEdge> edges;               /**< Sorted by source span. */
+    std::vector<std::uint32_t> edgeStart;     /**< spans+1 offsets into edges. */
+    std::vector<std::uint32_t> incomingEdges; /**< Edge indices grouped by target span. */
+    std::vector<std::uint32_t> incomingStart; /**< spans+1 offsets into incomingEdges. */
+    std::vector<std::int32_t> cellSpan;       /**< Span of every surface cell (NAV_NONE otherwise). */
+
+    /* Next edge per (from, to) pair: NAV_UNKNOWN until first asked; empty when too many spans */
+    static constexpr std::int32_t NAV_UNKNOWN = -2;
+    std::unique_ptr<std::atomic<std::int32_t>[]> nextEdgeCache;
+    mutable std::mutex searchMutex;
+    mutable SearchScratch scratch;
+
+    std::vector<std::uint32_t> flowTargets;
+    std::vector<std::int32_t> flowNextEdge;
+    std::vector<std::int32_t> flowGoal; /**< Target span the route of every span ends at. */
+    std::vector<float> flowDistance;
+    std::vector<HeapEntry> flowOpen;
+};
@@ -0,0 +1,72 @@
+#include "patrol_system.h"
+#include <algorithm>
+#include "actor.h"
+#include "movable.h"
+#include "config.hpp"
+
+std::uint32_t PatrolSystem::Add(Actor& actor, Movable& body) {
+    const auto slot = static_cast<std::uint32_t>(mode.size());
+    mode.push_back(Mode::Off);
+    sign.push_back(1.0f);
+    timer.push_back(0.0f);
+    speed.push_back(0.0f);
+    minX.push_back(0.0f);
+    maxX.push_back(0.0f);
+    actors.push_back(&actor);
+    bodies.push_back(&body);
+    return slot;
+}
+
+void PatrolSystem::Remove(std::uint32_t slot) noexcept {
+    mode[slot] = Mode::Off;
+    actors[slot] = nullptr;
+    bodies[slot] = nullptr;
+}
+
+void PatrolSystem::Start(std::uint32_t slot, float minXNew, float maxXNew, GameTypes::Direction dir, float speedNew,
+                         float waitTimer) noexcept {
+    mode[slot] = (waitTimer > 0.0f) ? Mode::Waiting : Mode::Moving;
+    sign[slot] = (dir == GameTypes::Direction::Left) ? -1.0f : 1.0f;
+    timer[slot] = waitTimer;
+    speed[slot] = speedNew;
+    minX[slot] = minXNew;
+    maxX[slot] = maxXNew;
+}
+
+void PatrolSystem::Stop(std::uint32_t slot) noexcept {
+    mode[slot] = Mode::Off;
+}
+
+void PatrolSystem::Advance(std::size_t begin, std::size_t end, float delta) noexcept {
+    for (std::size_t i = begin; i < end; ++i) {
+        if (mode[i] == Mode::Off) continue;
+        Actor& actor = *actors[i];
+        if (!actor.IsAlive()) {
+            mode[i] = Mode::Off;
+            continue;
+        }
+        if (mode[i] == Mode::Waiting) {
+            // the wait at a range end is over: turn around
+            timer[i] -= delta;
+            if (timer[i] <= 0.0f) {
+                sign[i] = -sign[i];
+                mode[i] = Mode::Moving;
+            }
+            continue;
+        }
+
+        const Vector2 position = actor.GetPosition();
+        const float x = position.x + sign[i] * speed[i] * delta;
+        const float clamped = std::clamp(x, minX[i], maxX[i]);
+        if (clamped != x) {
+            // reached a ledge or wall: stop there and wait before turning
+            mode[i] = Mode::Waiting;
+            timer[i] = EnemyConfig::PATROL_WAIT_TIME;
+            bodies[i]->SetVelocityX(0.0f);
+        } else {
+            // keep horizontal velocity in sync for facing and animation (like Move)
+            bodies[i]->SetVelocityX(sign[i] * speed[i]);
+        }
+        actor.SetPosition(clamped, position.y);
+    }
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "types.h"
+
+class Actor;
+class Movable;
+
+/**
+ * @brief Batched walking for patrolling actors.
+ *
+ * Patrol state is kept in parallel arrays (one entry per member): mode, direction sign,
+ * wait timer, speed and the range of x positions the actor may take. The range comes
+ * from the nav-graph span the actor stands on; spans stop at ledges and walls, so
+ * walking inside it needs neither ground probes nor a tile sweep. Each frame Advance
+ * walks every moving member, turns it into a wait at the range ends and reverses it
+ * when the wait is over. No Move actions are involved, so patrolling does not touch
+ * GameLogic.
+ *
+ * Patrolable owns the transitions into and out of the batch (Start / Stop); a member
+ * whose slot is stopped is skipped. Advance may run in parallel on disjoint ranges;
+ * Start and Stop only touch their own slot, so members may call them from job workers
+ * as long as that does not overlap with Advance.
+ */
+class PatrolSystem {
+public:
+    /**
+     * @brief Add a member; returns its slot. Called when a patrolling actor is constructed.
+     */
+    std::uint32_t Add(Actor& actor, Movable& body);
+
+    /**
+     * @brief Forget a member (its actor is being destroyed); the slot is not reused.
+     */
+    void Remove(std::uint32_t slot) noexcept;
+
+    /**
+     * @brief Hand a member's patrol to the batch.
+     *
+     * @param slot Member slot.
+     * @param minX Smallest actor x (position, not collider) the patrol may reach.
+     * @param maxX Largest actor x the patrol may reach.
+     * @param dir Current walking direction.
+     * @param speed Walking speed in pixels per second.
+     * @param waitTimer Remaining wait when the actor is currently waiting, 0 otherwise.
+     */
+    void Start(std::uint32_t slot, float minX, float maxX, GameTypes::Direction dir, float speed,
+               float waitTimer) noexcept;
+
+    /**
+     * @brief Take a member's patrol out of the batch (it keeps its position and velocity).
+     */
+    void Stop(std::uint32_t slot) noexcept;
+
+    bool IsActive(std::uint32_t slot) const noexcept { return mode[slot] != Mode::Off; }
+    bool IsWaiting(std::uint32_t slot) const noexcept { return mode[slot] == Mode::Waiting; }
+    GameTypes::Direction GetDirection(std::uint32_t slot) const noexcept {
+        return sign[slot] < 0.0f ? GameTypes::Direction::Left : GameTypes::Direction::Right;
+    }
+    float GetWaitTimer(std::uint32_t slot) const noexcept { return timer[slot]; }
+
+    /** Number of slots (including removed ones). */
+    std::size_t GetCount() const noexcept { return mode.size(); }
+
+    /**
+     * @brief Walk the members in slots [begin, end) by one frame.
+     */
+    void Advance(std::size_t begin, std::size_t end, float delta) noexcept;
+
+private:
+    enum class Mode : std::uint8_t { Off, Moving, Waiting };
+
+    std::vector<Mode> mode;
+    std::vector<float> sign;  /**< -1 walking left, +1 walking right. */
+    std::vector<float> timer; /**< Remaining wait while Waiting. */
+    std::vector<float> speed;
+    std::vector<float> minX;
+    std::vector<float> maxX;
+    std::vector<Actor*> actors;
+    std::vector<Movable*> bodies;
+};
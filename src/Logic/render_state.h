@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "raylib.h"
+#include "sprite_draw.h"
+
+/**
+ * @brief Everything GameLevel needs to draw one frame, captured from the simulation.
+ *
+ * The state is plain data: once captured it can be drawn while the simulation already
+ * advances (see the pipelined main loop). Vectors are reused between captures.
+ */
+struct RenderState {
+    std::vector<SpriteDraw> sprites; /**< Actor sprites in draw order; the player comes last. */
+    Vector2 cameraTarget{0.0f, 0.0f};
+    bool hasPlayer = false;
+    int lives = 0;
+    bool showGameOver = false; /**< Player ran out of lives; the game over message is shown. */
+};
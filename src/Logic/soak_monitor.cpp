@@ -0,0 +1,85 @@
+#include "soak_monitor.h"
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <string>
+#include "config.hpp"
+#include "gamelevel.h"
+#include "process_memory.h"
+#include "texture_manager.h"
+#include "raylib.h"
+
+namespace {
+constexpr const char* HEADER = "tick,mean_frame_ms,max_frame_ms,resident_bytes,actions,collision_listeners,event_handlers,textures,restarts";
+}
+
+bool SoakMonitor::Open(const std::filesystem::path& path) {
+    file.open(path, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) {
+        TraceLog(LOG_ERROR, "Soak: cannot create %s", path.string().c_str());
+        return false;
+    }
+    file << HEADER << '\n';
+    nextSampleTick = SoakConfig::SAMPLE_INTERVAL_TICKS;
+    return true;
+}
+
+void SoakMonitor::RecordFrame(const GameLevel& level, std::uint64_t ticks, double frameMs) {
+    if (!file.is_open()) return;
+    ++frames;
+    frameMsSum += frameMs;
+    frameMsMax = std::max(frameMsMax, frameMs);
+    if (ticks < nextSampleTick) return;
+
+    const WorldContext& context = level.GetContext();
+    SoakSample sample;
+    sample.tick = ticks;
+    sample.meanFrameMs = frameMsSum / static_cast<double>(frames);
+    sample.maxFrameMs = frameMsMax;
+    sample.residentBytes = GetResidentMemoryBytes();
+    sample.actions = static_cast<std::uint32_t>(context.logic.GetActions().size());
+    sample.collisionListeners = static_cast<std::uint32_t>(context.collisions.GetListenerCount());
+    sample.eventHandlers = static_cast<std::uint32_t>(context.events.GetHandlerCount());
+    sample.textures = static_cast<std::uint32_t>(TextureManager::Instance().GetCachedCount());
+    sample.restarts = restarts;
+
+    char line[192];
+    const int length = std::snprintf(line, sizeof(line), "%" PRIu64 ",%.4f,%.4f,%" PRIu64 ",%u,%u,%u,%u,%u\n",
+                                     sample.tick, sample.meanFrameMs, sample.maxFrameMs, sample.residentBytes,
+                                     sample.actions, sample.collisionListeners, sample.eventHandlers, sample.textures,
+                                     sample.restarts);
+    file.write(line, length);
+    file.flush();  // a run that crashes keeps the samples up to the crash
+
+    nextSampleTick = ticks + SoakConfig::SAMPLE_INTERVAL_TICKS;
+    frames = 0;
+    frameMsSum = 0.0;
+    frameMsMax = 0.0;
+}
+
+void SoakMonitor::Finish() {
+    file.close();
+}
+
+bool SoakMonitor::ReadSamples(const std::filesystem::path& path, std::vector<SoakSample>& samples) {
+    std::ifstream in(path);
+    std::string line;
+    if (!in.is_open() || !std::getline(in, line) || line != HEADER) {
+        return false;
+    }
+    samples.clear();
+    while (std::getline(in, line)) {
+        SoakSample sample;
+        unsigned long long tick = 0;
+        unsigned long long resident = 0;
+        if (std::sscanf(line.c_str(), "%llu,%lf,%lf,%llu,%u,%u,%u,%u,%u", &tick, &sample.meanFrameMs,
+                        &sample.maxFrameMs, &resident, &sample.actions, &sample.collisionListeners,
+                        &sample.eventHandlers, &sample.textures, &sample.restarts) != 9) {
+            return false;
+        }
+        sample.tick = tick;
+        sample.residentBytes = resident;
+        samples.push_back(sample);
+    }
+    return true;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+class GameLevel;
+
+/**
+ * @brief Resource usage of a soak run over one sample interval.
+ */
+struct SoakSample {
+    std::uint64_t tick = 0;          /**< Simulated ticks at the end of the interval. */
+    double meanFrameMs = 0.0;        /**< Mean wall time per frame during the interval. */
+    double maxFrameMs = 0.0;         /**< Longest frame of the interval. */
+    std::uint64_t residentBytes = 0; /**< Resident set size of the process. */
+    std::uint32_t actions = 0;       /**< Active actions (GameLogic). */
+    std::uint32_t collisionListeners = 0;
+    std::uint32_t eventHandlers = 0; /**< Handlers subscribed to the event bus. */
+    std::uint32_t textures = 0;      /**< Textures cached by the TextureManager. */
+    std::uint32_t restarts = 0;      /**< Game overs restarted so far. */
+};
+
+/**
+ * @brief Samples the resource usage of a long headless run into a CSV file (--soak-report).
+ *
+ * Every SoakConfig::SAMPLE_INTERVAL_TICKS simulated ticks one line with the frame time
+ * of the interval and the current memory, action, listener and texture counts is
+ * written. The soak runner reads these files back and checks each metric for an upward
+ * trend, which is how leaks that only show after hours of play become visible.
+ */
+class SoakMonitor {
+public:
+    SoakMonitor() = default;
+    SoakMonitor(const SoakMonitor&) = delete;
+    SoakMonitor& operator=(const SoakMonitor&) = delete;
+
+    /**
+     * @brief Create the sample file.
+     *
+     * @return true when the file was created.
+     */
+    bool Open(const std::filesystem::path& path);
+
+    bool IsOpen() const { return file.is_open(); }
+
+    /**
+     * @brief Account one frame; writes a sample when a sample interval is complete.
+     *
+     * @param ticks Simulated ticks so far.
+     * @param frameMs Wall time of the frame.
+     */
+    void RecordFrame(const GameLevel& level, std::uint64_t ticks, double frameMs);
+
+    /** @brief Count a game over that was restarted to keep the run going. */
+    void NoteRestart() noexcept { ++restarts; }
+
+    /** @brief Close the file. */
+    void Finish();
+
+    /**
+     * @brief Read the samples of a file written by a SoakMonitor.
+     *
+     * @return false when the file cannot be read or is malformed.
+     */
+    static bool ReadSamples(const std::filesystem::path& path, std::vector<SoakSample>& samples);
+
+private:
+    std::ofstream file;
+    std::uint64_t nextSampleTick = 0;
+    std::uint64_t frames = 0;
+    double frameMsSum = 0.0;
+    double frameMsMax = 0.0;
+    std::uint32_t restarts = 0;
+};
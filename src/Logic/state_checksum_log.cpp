@@ -0,0 +1,71 @@
+#include "state_checksum_log.h"
+#include <cinttypes>
+#include <cstdio>
+#include <string>
+#include "raylib.h"
+
+bool StateChecksumLog::OpenWrite(const std::filesystem::path& path) {
+    file.open(path, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) {
+        TraceLog(LOG_ERROR, "StateChecksum: cannot create %s", path.string().c_str());
+        return false;
+    }
+    writing = true;
+    return true;
+}
+
+bool StateChecksumLog::OpenCompare(const std::filesystem::path& path) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        TraceLog(LOG_ERROR, "StateChecksum: cannot open %s", path.string().c_str());
+        return false;
+    }
+    std::string line;
+    while (std::getline(in, line)) {
+        unsigned long long tick = 0;
+        unsigned long long hash = 0;
+        if (std::sscanf(line.c_str(), "%llu %llx", &tick, &hash) != 2 || tick != reference.size() + 1) {
+            TraceLog(LOG_ERROR, "StateChecksum: malformed line %zu in %s", reference.size() + 1,
+                     path.string().c_str());
+            reference.clear();
+            return false;
+        }
+        reference.push_back(hash);
+    }
+    comparing = true;
+    TraceLog(LOG_INFO, "StateChecksum: comparing against %zu ticks from %s", reference.size(), path.string().c_str());
+    return true;
+}
+
+void StateChecksumLog::Record(std::uint64_t hash) {
+    ++ticks;
+    if (writing) {
+        char line[48];
+        const int length = std::snprintf(line, sizeof(line), "%08" PRIu64 " %016" PRIx64 "\n", ticks, hash);
+        file.write(line, length);
+    } else if (comparing && firstMismatch == 0 && ticks <= reference.size() && reference[ticks - 1] != hash) {
+        firstMismatch = ticks;
+        TraceLog(LOG_ERROR, "StateChecksum: state DIVERGES at tick %" PRIu64 " (expected %016" PRIx64 ", got %016" PRIx64 ")",
+                 ticks, reference[ticks - 1], hash);
+    }
+}
+
+bool StateChecksumLog::Finish() {
+    bool matched = true;
+    if (writing) {
+        file.close();
+        TraceLog(LOG_INFO, "StateChecksum: wrote %" PRIu64 " tick hashes", ticks);
+    } else if (comparing) {
+        if (firstMismatch != 0) {
+            matched = false;
+        } else if (ticks < reference.size()) {
+            TraceLog(LOG_WARNING, "StateChecksum: run ended after %" PRIu64 " of %zu reference ticks (all matched)",
+                     ticks, reference.size());
+        } else {
+            TraceLog(LOG_INFO, "StateChecksum: all %zu reference ticks match", reference.size());
+        }
+    }
+    writing = false;
+    comparing = false;
+    return matched;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+/**
+ * @brief Per-tick simulation state hashes, written to or compared against a text file.
+ *
+ * Each line holds a tick number and the HashWorldState of the level after that tick,
+ * both in fixed-width form, so two logs can also be compared with plain `diff`. In
+ * compare mode every recorded hash is checked against a reference log and the first
+ * tick whose state differs is reported, which pinpoints where two runs (builds,
+ * optimisation levels, code changes) stopped agreeing.
+ */
+class StateChecksumLog {
+public:
+    StateChecksumLog() = default;
+    StateChecksumLog(const StateChecksumLog&) = delete;
+    StateChecksumLog& operator=(const StateChecksumLog&) = delete;
+
+    /**
+     * @brief Start writing a log.
+     *
+     * @return true when the file was created.
+     */
+    bool OpenWrite(const std::filesystem::path& path);
+
+    /**
+     * @brief Load a reference log to compare against.
+     *
+     * @return true when the file was read.
+     */
+    bool OpenCompare(const std::filesystem::path& path);
+
+    /** @brief True while writing or comparing. */
+    bool IsOpen() const { return writing || comparing; }
+
+    /**
+     * @brief Record the state hash after a tick (written or compared, depending on the mode).
+     *
+     * @param hash HashWorldState of the level after the tick.
+     */
+    void Record(std::uint64_t hash);
+
+    /**
+     * @brief Close the log; in compare mode also report whether the runs matched.
+     *
+     * @return false when a compared run diverged from the reference.
+     */
+    bool Finish();
+
+    /** @brief Number of ticks recorded so far. */
+    std::uint64_t GetTickCount() const noexcept { return ticks; }
+
+private:
+    std::ofstream file;
+    std::vector<std::uint64_t> reference;
+    std::uint64_t ticks = 0;
+    std::uint64_t firstMismatch = 0; /**< 1-based tick of the first difference; 0 while matching. */
+    bool writing = false;
+    bool comparing = false;
+};
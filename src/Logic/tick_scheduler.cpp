@@ -0,0 +1,63 @@
+#include "tick_scheduler.h"
+#include <algorithm>
+#include <cmath>
+#include "config.hpp"
+
+TickScheduler::TickScheduler() {
+    Configure(TickGroup::Sensors, {TickConfig::SENSOR_RATE, TickConfig::SENSOR_PHASE, TickConfig::SENSOR_MAX_PER_FRAME});
+    Configure(TickGroup::Animation,
+              {TickConfig::ANIMATION_RATE, TickConfig::ANIMATION_PHASE, TickConfig::ANIMATION_MAX_PER_FRAME});
+    Configure(TickGroup::AI, {TickConfig::AI_RATE, TickConfig::AI_PHASE, TickConfig::AI_MAX_PER_FRAME});
+}
+
+void TickScheduler::Configure(TickGroup group, const GroupConfig& config) noexcept {
+    Group& target = groups[Index(group)];
+    target.config = config;
+    target.basePeriod = 1;
+    if (config.rate > 0.0f && config.rate < static_cast<float>(Config::TARGET_FPS)) {
+        const float frames = std::round(static_cast<float>(Config::TARGET_FPS) / config.rate);
+        target.basePeriod = std::max(1u, static_cast<std::uint32_t>(frames));
+    }
+    target.period = target.basePeriod;
+}
+
+void TickScheduler::BeginFrame(std::size_t members) noexcept {
+    ++frame;
+    for (Group& group : groups) {
+        const std::uint32_t ticks = group.ticks.exchange(0, std::memory_order_relaxed);
+        group.peakTicks = std::max(group.peakTicks, ticks);
+        group.period = group.basePeriod;
+        if (group.config.maxPerFrame > 0) {
+            const std::size_t cap = group.config.maxPerFrame;
+            const auto needed = static_cast<std::uint32_t>((members + cap - 1) / cap);
+            group.period = std::max(group.period, needed);
+        }
+    }
+}
+
+bool TickScheduler::Tick(TickGroup group, TickState& state, float delta, float& elapsed) noexcept {
+    Group& target = groups[Index(group)];
+    float& pending = state.elapsed[Index(group)];
+    pending += delta;
+    if ((state.slot + target.config.phase + frame) % target.period != 0) {
+        return false;
+    }
+    elapsed = pending;
+    pending = 0.0f;
+    target.ticks.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+const char* TickScheduler::GetGroupName(TickGroup group) noexcept {
+    switch (group) {
+        case TickGroup::Sensors:
+            return "Sensors";
+        case TickGroup::Animation:
+            return "Animation";
+        case TickGroup::AI:
+            return "AI";
+        case TickGroup::Count:
+            break;
+    }
+    return "?";
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Groups of per-actor work that may run below the frame rate.
+ */
+enum class TickGroup : std::uint8_t {
+    Sensors,   /**< Ground sensor and snapping (Movable::UpdateGrounding). */
+    Animation, /**< Animation state checks (Jumpable::Update). */
+    AI,        /**< Behaviour decisions (Patrolable::Update). */
+    Count
+};
+
+inline constexpr std::size_t TICK_GROUP_COUNT = static_cast<std::size_t>(TickGroup::Count);
+
+/**
+ * @brief Per-actor scheduling state: the actor's slot and the time not yet handed to each group.
+ */
+struct TickState {
+    std::uint32_t slot = 0;                          /**< Assigned by TickScheduler::AssignSlot. */
+    std::array<float, TICK_GROUP_COUNT> elapsed{};   /**< Seconds since the group last ran. */
+};
+
+/**
+ * @brief Decides which actors run which tick group in the current frame.
+ *
+ * A group with rate R runs every P = TARGET_FPS / R frames. Actors get consecutive
+ * slots when they are added, and an actor runs a group on the frames where
+ * (slot + phase + frame) is a multiple of P, so the members of a slow group are spread
+ * evenly over the P frames instead of all running together. Each group can also cap the
+ * number of members that run per frame: with N members the period stretches to at
+ * least ceil(N / cap), which bounds the per-frame cost of the group regardless of N.
+ *
+ * Skipped frames are not lost: the time since an actor last ran a group accumulates
+ * in its TickState and is passed as the delta when the group runs again.
+ *
+ * Tick may be called from job workers (one call per actor and group each frame); the
+ * per-group tick counters are atomic and reset by BeginFrame.
+ */
+class TickScheduler {
+public:
+    /**
+     * @brief Rate and spreading of one group.
+     */
+    struct GroupConfig {
+        float rate = 0.0f;            /**< Runs per second; 0 (or >= TARGET_FPS) runs every frame. */
+        std::uint32_t phase = 0;      /**< Frame offset, keeps groups of equal rate on different frames. */
+        std::uint32_t maxPerFrame = 0; /**< Member cap per frame; 0 means unlimited. */
+    };
+
+    /**
+     * @brief Create a scheduler with the groups configured from TickConfig.
+     */
+    TickScheduler();
+
+    /**
+     * @brief Change the rate, phase or cap of a group (takes effect on the next BeginFrame).
+     */
+    void Configure(TickGroup group, const GroupConfig& config) noexcept;
+
+    const GroupConfig& GetConfig(TickGroup group) const noexcept { return groups[Index(group)].config; }
+
+    /**
+     * @brief Next free slot; consecutive slots land on consecutive frames of a slow group.
+     */
+    std::uint32_t AssignSlot() noexcept { return nextSlot++; }
+
+    /**
+     * @brief Advance to the next frame and recompute the group periods.
+     *
+     * @param members Number of actors that will call Tick this frame.
+     */
+    void BeginFrame(std::size_t members) noexcept;
+
+    /**
+     * @brief Account a frame for one actor and group and decide whether the group runs.
+     *
+     * @param group Group of the work.
+     * @param state Scheduling state of the actor.
+     * @param delta Seconds since the previous frame.
+     * @param elapsed Receives the seconds since the group last ran for this actor (when it runs).
+     * @return true when the actor should run the group this frame.
+     */
+    bool Tick(TickGroup group, TickState& state, float delta, float& elapsed) noexcept;
+
+    /** Frames between two runs of a group for the same actor in the current frame. */
+    std::uint32_t GetPeriod(TickGroup group) const noexcept { return groups[Index(group)].period; }
+
+    /** Members that ran a group during the current frame (the group's cost). */
+    std::uint32_t GetTickCount(TickGroup group) const noexcept {
+        return groups[Index(group)].ticks.load(std::memory_order_relaxed);
+    }
+
+    /** Largest per-frame tick count of a group since the scheduler was created. */
+    std::uint32_t GetPeakTickCount(TickGroup group) const noexcept { return groups[Index(group)].peakTicks; }
+
+    /**
+     * @brief Frame counter; part of the world state so restored worlds keep their tick pattern.
+     */
+    std::uint32_t GetFrame() const noexcept { return frame; }
+    void SetFrame(std::uint32_t value) noexcept { frame = value; }
+
+    /**
+     * @brief Display name of a group.
+     */
+    static const char* GetGroupName(TickGroup group) noexcept;
+
+private:
+    struct Group {
+        GroupConfig config;
+        std::uint32_t basePeriod = 1;
+        std::uint32_t period = 1;
+        std::uint32_t peakTicks = 0;
+        std::atomic<std::uint32_t> ticks{0};
+    };
+
+    static constexpr std::size_t Index(TickGroup group) noexcept { return static_cast<std::size_t>(group); }
+
+    std::array<Group, TICK_GROUP_COUNT> groups;
+    std::uint32_t frame = 0;
+    std::uint32_t nextSlot = 0;
+};
@@ -0,0 +1,214 @@
+#include "tile_collision_grid.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+void TileCollisionGrid::Build(const TmxMap* map, const TmxLayer* layer) {
+    cellStart.clear();
+    shapes.clear();
+    width = 0;
+    height = 0;
+    if (map == nullptr || layer == nullptr || map->tileWidth == 0 || map->tileHeight == 0) return;
+
+    width = static_cast<int>(map->width);
+    height = static_cast<int>(map->height);
+    tileWidth = static_cast<float>(map->tileWidth);
+    tileHeight = static_cast<float>(map->tileHeight);
+    cellStart.reserve(static_cast<std::size_t>(width) * height + 1);
+    cellStart.push_back(0);
+
+    // One raytmx query per cell; shapes overlapping several cells are stored in each of them
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            const Rectangle cell{x * tileWidth, y * tileHeight, tileWidth, tileHeight};
+            std::uint32_t hitCount = 0;
+            TmxObject* hits = CheckCollisionTMXTileLayersRecAllAlloc(map, layer, 1, cell, &hitCount);
+            if (hits != NULL) {
+                for (std::uint32_t i = 0; i < hitCount; ++i) {
+                    const Rectangle shape{static_cast<float>(hits[i].x), static_cast<float>(hits[i].y),
+                                          static_cast<float>(hits[i].width), static_cast<float>(hits[i].height)};
+                    if (CheckCollisionRecs(cell, shape)) {
+                        shapes.push_back(shape);
+                    }
+                }
+                MemFree(hits);
+            }
+            cellStart.push_back(static_cast<std::uint32_t>(shapes.size()));
+        }
+    }
+    shapes.shrink_to_fit();
+}
+
+bool TileCollisionGrid::CellRange(Rectangle area, int& minX, int& minY, int& maxX, int& maxY) const {
+    if (width == 0 || height == 0) return false;
+    minX = std::max(static_cast<int>(std::floor(area.x / tileWidth)), 0);
+    minY = std::max(static_cast<int>(std::floor(area.y / tileHeight)), 0);
+    maxX = std::min(static_cast<int>(std::floor((area.x + area.width) / tileWidth)), width - 1);
+    maxY = std::min(static_cast<int>(std::floor((area.y + area.height) / tileHeight)), height - 1);
+    return minX <= maxX && minY <= maxY;
+}
+
+bool TileCollisionGrid::FindHighestTop(Rectangle area, float& top) const {
+    bool found = false;
+    ForEachShapeIn(area, [&](const Rectangle& shape) {
+        if (!found || shape.y < top) {
+            top = shape.y;
+            found = true;
+        }
+    });
+    return found;
+}
+
+namespace {
+/* Entry and exit times of a box moving along one axis relative to a static interval */
+void AxisSlab(float boxMin, float boxSize, float motion, float shapeMin, float shapeSize, float& enter, float& exit) {
+    constexpr float INF = std::numeric_limits<float>::infinity();
+    if (motion == 0.0f) {
+        // no motion on this axis: the box must already overlap the interval (touching does not count)
+        const bool overlaps = boxMin < shapeMin + shapeSize && boxMin + boxSize > shapeMin;
+        enter = overlaps ? -INF : INF;
+        exit = overlaps ? INF : -INF;
+        return;
+    }
+    const float towards = motion > 0.0f ? shapeMin - (boxMin + boxSize) : (shapeMin + shapeSize) - boxMin;
+    const float away = motion > 0.0f ? (shapeMin + shapeSize) - boxMin : shapeMin - (boxMin + boxSize);
+    enter = towards / motion;
+    exit = away / motion;
+}
+}  // namespace
+
+void TileCollisionGrid::SweepCells(int minX, int minY, int maxX, int maxY, Rectangle box, Vector2 motion,
+                                   TileSweepHit& best, bool& found) const {
+    minX = std::max(minX, 0);
+    minY = std::max(minY, 0);
+    maxX = std::min(maxX, width - 1);
+    maxY = std::min(maxY, height - 1);
+    for (int y = minY; y <= maxY; ++y) {
+        for (int x = minX; x <= maxX; ++x) {
+            const std::size_t cell = static_cast<std::size_t>(y) * width + static_cast<std::size_t>(x);
+            for (std::uint32_t i = cellStart[cell]; i < cellStart[cell + 1]; ++i) {
+                const Rectangle& shape = shapes[i];
+                float enterX, exitX, enterY, exitY;
+                AxisSlab(box.x, box.width, motion.x, shape.x, shape.width, enterX, exitX);
+                AxisSlab(box.y, box.height, motion.y, shape.y, shape.height, enterY, exitY);
+                const float enter = std::max(enterX, enterY);
+                const float exit = std::min(exitX, exitY);
+                // negative entry: already overlapping at the start, which never blocks
+                if (enter >= exit || enter < 0.0f || enter > best.time) continue;
+                if (found && enter == best.time) continue;  // keep the first shape found at equal times
+                best.time = enter;
+                best.normal = enterX > enterY ? Vector2{motion.x > 0.0f ? -1.0f : 1.0f, 0.0f}
+                                              : Vector2{0.0f, motion.y > 0.0f ? -1.0f : 1.0f};
+                found = true;
+            }
+        }
+    }
+}
+
+bool TileCollisionGrid::SweepBox(Rectangle box, Vector2 motion, TileSweepHit& hit) const {
+    hit = {};
+    if (width == 0 || height == 0 || (motion.x == 0.0f && motion.y == 0.0f)) return false;
+    // NaN or infinite motion would never advance the DDA below
+    if (!std::isfinite(motion.x) || !std::isfinite(motion.y)) return false;
+    constexpr float INF = std::numeric_limits<float>::infinity();
+
+    // cells covered by the box at the start (not clamped: the box may enter the map later)
+    int minX = static_cast<int>(std::floor(box.x / tileWidth));
+    int minY = static_cast<int>(std::floor(box.y / tileHeight));
+    int maxX = static_cast<int>(std::floor((box.x + box.width) / tileWidth));
+    int maxY = static_cast<int>(std::floor((box.y + box.height) / tileHeight));
+    bool found = false;
+    SweepCells(minX, minY, maxX, maxY, box, motion, hit, found);
+
+    /* DDA over the leading edges: tNextX/tNextY is the fraction of the motion at which the
+       leading vertical/horizontal edge enters the next column/row. Each step only tests the
+       newly entered column or row across the span covered so far. An axis stops once its
+       leading edge has left the map, as no cell beyond can block, so a huge motion still
+       takes at most as many steps as the grid has columns and rows. */
+    const float leadX = motion.x > 0.0f ? box.x + box.width : box.x;
+    const float leadY = motion.y > 0.0f ? box.y + box.height : box.y;
+    float tNextX = INF, tNextY = INF, tStepX = INF, tStepY = INF;
+    if (motion.x != 0.0f) {
+        const float boundary = (motion.x > 0.0f ? maxX + 1 : minX) * tileWidth;
+        tNextX = (boundary - leadX) / motion.x;
+        tStepX = tileWidth / std::fabs(motion.x);
+    }
+    if (motion.y != 0.0f) {
+        const float boundary = (motion.y > 0.0f ? maxY + 1 : minY) * tileHeight;
+        tNextY = (boundary - leadY) / motion.y;
+        tStepY = tileHeight / std::fabs(motion.y);
+    }
+
+    while (true) {
+        const float tNext = std::min(tNextX, tNextY);
+        // stop when the motion ends or the next cells are reached after the best hit
+        if (tNext > 1.0f || (found && tNext > hit.time)) break;
+        if (tNextX <= tNextY) {
+            const int column = motion.x > 0.0f ? ++maxX : --minX;
+            if (motion.x > 0.0f ? column >= width : column < 0) {
+                tNextX = INF;
+                continue;
+            }
+            SweepCells(column, minY, column, maxY, box, motion, hit, found);
+            tNextX += tStepX;
+        } else {
+            const int row = motion.y > 0.0f ? ++maxY : --minY;
+            if (motion.y > 0.0f ? row >= height : row < 0) {
+                tNextY = INF;
+                continue;
+            }
+            SweepCells(minX, row, maxX, row, box, motion, hit, found);
+            tNextY += tStepY;
+        }
+    }
+    return found;
+}
+
+bool TileCollisionGrid::Raycast(Vector2 from, Vector2 to, TileRayHit& hit) const {
+    hit = {};
+    if (width == 0 || height == 0) return false;
+    if (!std::isfinite(from.x) || !std::isfinite(from.y) || !std::isfinite(to.x) || !std::isfinite(to.y)) {
+        return false;
+    }
+    constexpr float INF = std::numeric_limits<float>::infinity();
+
+    int x = static_cast<int>(std::floor(from.x / tileWidth));
+    int y = static_cast<int>(std::floor(from.y / tileHeight));
+    const int endX = static_cast<int>(std::floor(to.x / tileWidth));
+    const int endY = static_cast<int>(std::floor(to.y / tileHeight));
+    const float dx = to.x - from.x;
+    const float dy = to.y - from.y;
+
+    /* tMax: fraction of the segment at which the next vertical/horizontal cell border is
+       crossed; tDelta: fraction needed to cross one whole cell */
+    const int stepX = dx > 0.0f ? 1 : (dx < 0.0f ? -1 : 0);
+    const int stepY = dy > 0.0f ? 1 : (dy < 0.0f ? -1 : 0);
+    float tMaxX = stepX != 0 ? ((x + (stepX > 0 ? 1 : 0)) * tileWidth - from.x) / dx : INF;
+    float tMaxY = stepY != 0 ? ((y + (stepY > 0 ? 1 : 0)) * tileHeight - from.y) / dy : INF;
+    const float tDeltaX = stepX != 0 ? tileWidth / std::fabs(dx) : INF;
+    const float tDeltaY = stepY != 0 ? tileHeight / std::fabs(dy) : INF;
+
+    float time = 0.0f;
+    while (true) {
+        if (IsSolidCell(x, y)) {
+            hit = {true, x, y, time};
+            return true;
+        }
+        if (x == endX && y == endY) return false;
+        if (tMaxX < tMaxY) {
+            time = tMaxX;
+            tMaxX += tDeltaX;
+            x += stepX;
+        } else {
+            time = tMaxY;
+            tMaxY += tDeltaY;
+            y += stepY;
+        }
+        // rounding can step past the end cell; the segment is over once time passes 1
+        if (time > 1.0f) return false;
+        // cells beyond the map edge the ray is heading to are never solid
+        if ((stepX > 0 && x >= width) || (stepX < 0 && x < 0) || (stepY > 0 && y >= height) || (stepY < 0 && y < 0)) {
+            return false;
+        }
+    }
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "raylib.h"
+#include "raytmx.h"
+
+/**
+ * @brief Result of a swept box query against the tile grid.
+ */
+struct TileSweepHit {
+    float time = 1.0f;          /**< Fraction of the motion travelled before contact (0..1). */
+    Vector2 normal{0.0f, 0.0f}; /**< Outward normal of the face that was hit. */
+};
+
+/**
+ * @brief Result of a tile raycast.
+ */
+struct TileRayHit {
+    bool hit = false;
+    int cellX = -1;    /**< Solid cell that stopped the ray. */
+    int cellY = -1;
+    float time = 1.0f; /**< Fraction of the segment travelled before entering that cell. */
+};
+
+/**
+ * @brief Static collision shapes of a tile layer, baked into a per-cell lookup table.
+ *
+ * raytmx answers collision queries by allocating an array of hit objects on every
+ * call. The tile layers never change while a level runs, so the grid runs those
+ * queries once per cell at load time and stores the resulting rectangles in a
+ * compact cell-indexed table (CSR layout). Runtime queries only visit the cells an
+ * area overlaps and never allocate.
+ */
+class TileCollisionGrid {
+public:
+    /**
+     * @brief Bake the collision shapes of a tile layer.
+     *
+     * @param map Loaded map (may be null, which leaves the grid empty).
+     * @param layer Tile layer providing the collision shapes (may be null).
+     */
+    void Build(const TmxMap* map, const TmxLayer* layer);
+
+    /**
+     * @brief Find the highest (smallest y) top edge among shapes overlapping an area.
+     *
+     * @param area World-space query rectangle.
+     * @param top Receives the highest top edge when a shape overlaps.
+     * @return true when at least one shape overlaps the area.
+     */
+    bool FindHighestTop(Rectangle area, float& top) const;
+
+    /**
+     * @brief Sweep a box along a motion vector and find the first shape it runs into.
+     *
+     * The cells entered by the box's leading edges are visited in the order the motion
+     * reaches them (DDA), so the cost is proportional to the number of tiles crossed, not
+     * to the length of the time step. Shapes the box already overlaps at the start are
+     * ignored, which lets a box that ended up inside a shape move out of it.
+     *
+     * @param box World-space box at the start of the motion.
+     * @param motion Displacement in world units; NaN or infinite components never hit.
+     * @param hit Receives the time of impact and contact normal of the earliest hit.
+     * @return true when the box hits a shape before completing the motion.
+     */
+    bool SweepBox(Rectangle box, Vector2 motion, TileSweepHit& hit) const;
+
+    /**
+     * @brief Walk the cells a segment passes through and stop at the first solid one.
+     *
+     * Amanatides–Woo traversal: cells are visited in the order the segment enters them,
+     * so the cost is the number of cells crossed. Any cell holding a collision shape
+     * blocks the ray (see IsSolidCell), including the start cell.
+     *
+     * @param from Segment start in world units.
+     * @param to Segment end in world units.
+     * @param hit Receives the blocking cell and entry time.
+     * @return true when a solid cell lies on the segment (never for a non-finite segment).
+     */
+    bool Raycast(Vector2 from, Vector2 to, TileRayHit& hit) const;
+
+    /**
+     * @brief Visit every shape overlapping an area; shapes spanning several cells may be visited more than once.
+     *
+     * @param area World-space query rectangle.
+     * @param visit Callable taking `const Rectangle&`.
+     */
+    template <typename Visitor>
+    void ForEachShapeIn(Rectangle area, Visitor&& visit) const {
+        int minX, minY, maxX, maxY;
+        if (!CellRange(area, minX, minY, maxX, maxY)) return;
+        for (int y = minY; y <= maxY; ++y) {
+            for (int x = minX; x <= maxX; ++x) {
+                const std::size_t cell = static_cast<std::size_t>(y) * width + static_cast<std::size_t>(x);
+                for (std::uint32_t i = cellStart[cell]; i < cellStart[cell + 1]; ++i) {
+                    if (CheckCollisionRecs(area, shapes[i])) {
+                        visit(shapes[i]);
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Whether any collision shape touches the given cell.
+     */
+    bool IsSolidCell(int x, int y) const noexcept {
+        if (x < 0 || y < 0 || x >= width || y >= height) return false;
+        const std::size_t cell = static_cast<std::size_t>(y) * width + static_cast<std::size_t>(x);
+        return cellStart[cell + 1] > cellStart[cell];
+    }
+
+    int GetWidth() const noexcept { return width; }
+    int GetHeight() const noexcept { return height; }
+    float GetTileWidth() const noexcept { return tileWidth; }
+    float GetTileHeight() const noexcept { return tileHeight; }
+
+private:
+    // Clamp the cells overlapped by area to the grid; false when outside the map
+    bool CellRange(Rectangle area, int& minX, int& minY, int& maxX, int& maxY) const;
+    // Test the shapes of a block of cells (clamped to the grid) against a swept box, keeping the earliest hit
+    void SweepCells(int minX, int minY, int maxX, int maxY, Rectangle box, Vector2 motion, TileSweepHit& best,
+                    bool& found) const;
+
+    int width = 0;
+    int height = 0;
+    float tileWidth = 0.0f;
+    float tileHeight = 0.0f;
+    std::vector<std::uint32_t> cellStart; /**< width*height+1 offsets into shapes. */
+    std::vector<Rectangle> shapes;        /**< Collision rectangles grouped by cell. */
+};
@@ -0,0 +1,351 @@
+#include "time_rewind.h"
+#include "gamelevel.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace {
+/* Common prefix of every encoded frame; followed by the player records, the action records,
+   the contact and trigger keys and then either all actor records (keyframe) or the changed-word entries (delta). */
+struct FrameHeader {
+    std::uint64_t tick;
+    std::uint32_t actorCount;
+    std::uint32_t entryCount;  // delta entries; unused for keyframes
+    std::uint32_t actionCount;
+    std::uint8_t playerCount;
+    std::uint8_t keyframe;
+    std::uint8_t levelState;
+    std::uint8_t reserved;
+    float gameOverTimer;
+    std::uint32_t tickFrame;  // TickScheduler frame, so tick groups keep their phase after a rewind
+    std::uint32_t contactCount;  // collision pair cache keys, so ongoing contacts do not enter again
+    std::uint32_t triggerCount;  // trigger occupancy keys, so occupied volumes do not enter again
+    std::uint32_t checkpoint;    // trigger index of the respawn checkpoint
+};
+
+constexpr std::size_t RECORD_WORDS = sizeof(ActorSnapshot) / sizeof(std::uint32_t);
+static_assert(RECORD_WORDS <= 32, "delta word mask is 32 bits wide");
+
+constexpr float CAPTURE_AVERAGE_WEIGHT = 0.05f;
+
+template <typename T>
+void Append(std::uint8_t* buffer, std::size_t& pos, const T& value) {
+    std::memcpy(buffer + pos, &value, sizeof(T));
+    pos += sizeof(T);
+}
+
+template <typename T>
+T Take(const std::uint8_t*& cursor) {
+    T value;
+    std::memcpy(&value, cursor, sizeof(T));
+    cursor += sizeof(T);
+    return value;
+}
+
+std::size_t CommonSize(const WorldState& state) {
+    return sizeof(FrameHeader) + state.playerCount * sizeof(ActorSnapshot) +
+           state.actions.size() * sizeof(ActionSnapshot) + state.contacts.size() * sizeof(std::uint64_t) +
+           state.triggers.size() * sizeof(std::uint64_t);
+}
+
+void AppendCommon(std::uint8_t* buffer, std::size_t& pos, const WorldState& state, const FrameHeader& header) {
+    Append(buffer, pos, header);
+    std::memcpy(buffer + pos, state.players.data(), state.playerCount * sizeof(ActorSnapshot));
+    pos += state.playerCount * sizeof(ActorSnapshot);
+    if (!state.actions.empty()) {
+        std::memcpy(buffer + pos, state.actions.data(), state.actions.size() * sizeof(ActionSnapshot));
+        pos += state.actions.size() * sizeof(ActionSnapshot);
+    }
+    if (!state.contacts.empty()) {
+        std::memcpy(buffer + pos, state.contacts.data(), state.contacts.size() * sizeof(std::uint64_t));
+        pos += state.contacts.size() * sizeof(std::uint64_t);
+    }
+    if (!state.triggers.empty()) {
+        std::memcpy(buffer + pos, state.triggers.data(), state.triggers.size() * sizeof(std::uint64_t));
+        pos += state.triggers.size() * sizeof(std::uint64_t);
+    }
+}
+
+/* Read header, players, actions, contacts and trigger occupancy; returns a cursor to the frame body */
+const std::uint8_t* ReadCommon(const std::uint8_t* cursor, WorldState& out, FrameHeader& header) {
+    header = Take<FrameHeader>(cursor);
+    out.playerCount = header.playerCount;
+    for (std::size_t i = 0; i < header.playerCount; ++i) {
+        out.players[i] = Take<ActorSnapshot>(cursor);
+    }
+    out.levelState = header.levelState;
+    out.gameOverTimer = header.gameOverTimer;
+    out.checkpoint = header.checkpoint;
+    out.tickFrame = header.tickFrame;
+    out.actions.resize(header.actionCount);
+    if (header.actionCount > 0) {
+        std::memcpy(out.actions.data(), cursor, header.actionCount * sizeof(ActionSnapshot));
+        cursor += header.actionCount * sizeof(ActionSnapshot);
+    }
+    out.contacts.resize(header.contactCount);
+    if (header.contactCount > 0) {
+        std::memcpy(out.contacts.data(), cursor, header.contactCount * sizeof(std::uint64_t));
+        cursor += header.contactCount * sizeof(std::uint64_t);
+    }
+    out.triggers.resize(header.triggerCount);
+    if (header.triggerCount > 0) {
+        std::memcpy(out.triggers.data(), cursor, header.triggerCount * sizeof(std::uint64_t));
+        cursor += header.triggerCount * sizeof(std::uint64_t);
+    }
+    return cursor;
+}
+}  // namespace
+
+TimeRewind::TimeRewind(std::size_t memoryBudgetBytes, std::size_t maxTicks)
+    : arena(memoryBudgetBytes), frames(std::max<std::size_t>(maxTicks, 2)) {}
+
+void TimeRewind::Clear() {
+    firstFrame = 0;
+    frameCount = 0;
+    head = 0;
+    bytesUsed = 0;
+    hasKeyframe = false;
+}
+
+bool TimeRewind::IsKeyframeBuffered(std::uint64_t keyTick) const noexcept {
+    return frameCount > 0 && FrameAt(0).tick <= keyTick;
+}
+
+void TimeRewind::EncodeKeyframe(const WorldState& state, std::uint64_t tick) {
+    const std::size_t size = CommonSize(state) + state.actors.size() * sizeof(ActorSnapshot);
+    if (scratch.size() < size) scratch.resize(size);
+
+    const FrameHeader header{tick,
+                             static_cast<std::uint32_t>(state.actors.size()),
+                             0,
+                             static_cast<std::uint32_t>(state.actions.size()),
+                             state.playerCount,
+                             1,
+                             state.levelState,
+                             0,
+                             state.gameOverTimer,
+                             state.tickFrame,
+                             static_cast<std::uint32_t>(state.contacts.size()),
+                             static_cast<std::uint32_t>(state.triggers.size()),
+                             state.checkpoint};
+    std::size_t pos = 0;
+    AppendCommon(scratch.data(), pos, state, header);
+    if (!state.actors.empty()) {
+        std::memcpy(scratch.data() + pos, state.actors.data(), state.actors.size() * sizeof(ActorSnapshot));
+        pos += state.actors.size() * sizeof(ActorSnapshot);
+    }
+    scratchSize = pos;
+}
+
+void TimeRewind::EncodeDelta(const WorldState& state, std::uint64_t tick) {
+    // worst case: every record changed in every word
+    const std::size_t worstCase =
+        CommonSize(state) + state.actors.size() * (2 * sizeof(std::uint32_t) + sizeof(ActorSnapshot));
+    if (scratch.size() < worstCase) scratch.resize(worstCase);
+
+    FrameHeader header{tick,
+                       static_cast<std::uint32_t>(state.actors.size()),
+                       0,
+                       static_cast<std::uint32_t>(state.actions.size()),
+                       state.playerCount,
+                       0,
+                       state.levelState,
+                       0,
+                       state.gameOverTimer,
+                       state.tickFrame,
+                       static_cast<std::uint32_t>(state.contacts.size()),
+                       static_cast<std::uint32_t>(state.triggers.size()),
+                       state.checkpoint};
+    std::size_t pos = 0;
+    AppendCommon(scratch.data(), pos, state, header);
+
+    std::uint32_t entryCount = 0;
+    for (std::size_t slot = 0; slot < state.actors.size(); ++slot) {
+        const ActorSnapshot& now = state.actors[slot];
+        const ActorSnapshot& key = keyframeState.actors[slot];
+        if (std::memcmp(&now, &key, sizeof(ActorSnapshot)) == 0) continue;
+
+        std::uint32_t nowWords[RECORD_WORDS];
+        std::uint32_t keyWords[RECORD_WORDS];
+        std::memcpy(nowWords, &now, sizeof(ActorSnapshot));
+        std::memcpy(keyWords, &key, sizeof(ActorSnapshot));
+
+        Append(scratch.data(), pos, static_cast<std::uint32_t>(slot));
+        const std::size_t maskPos = pos;
+        pos += sizeof(std::uint32_t);
+        std::uint32_t mask = 0;
+        for (std::size_t word = 0; word < RECORD_WORDS; ++word) {
+            if (nowWords[word] != keyWords[word]) {
+                mask |= (1u << word);
+                Append(scratch.data(), pos, nowWords[word]);
+            }
+        }
+        std::memcpy(scratch.data() + maskPos, &mask, sizeof(mask));
+        ++entryCount;
+    }
+
+    // patch the entry count into the already written header
+    header.entryCount = entryCount;
+    std::memcpy(scratch.data(), &header, sizeof(header));
+    scratchSize = pos;
+}
+
+void TimeRewind::EvictOldest() {
+    /* Deltas are useless without their keyframe, so evict the whole keyframe group */
+    do {
+        bytesUsed -= FrameAt(0).size;
+        firstFrame = (firstFrame + 1) % frames.size();
+        --frameCount;
+    } while (frameCount > 0 && !FrameAt(0).keyframe);
+    if (frameCount == 0) {
+        head = 0;
+        hasKeyframe = false;
+    }
+}
+
+void TimeRewind::DropNewest() {
+    const FrameInfo& newest = FrameAt(frameCount - 1);
+    head = newest.offset;
+    bytesUsed -= newest.size;
+    --frameCount;
+    if (frameCount == 0) {
+        head = 0;
+    }
+}
+
+bool TimeRewind::Reserve(std::size_t size, std::size_t& offset) {
+    if (size > arena.size()) return false;
+    if (frameCount == frames.size()) EvictOldest();
+    if (frameCount == 0) head = 0;
+
+    std::size_t writePos = head;
+    if (writePos + size > arena.size()) {
+        // The arena tail is too small; frames stored there are the oldest ones, drop them and wrap
+        while (frameCount > 0 && FrameAt(0).offset >= writePos) EvictOldest();
+        writePos = 0;
+    }
+    // Evict oldest frames until the target range is free
+    while (frameCount > 0) {
+        const FrameInfo& oldest = FrameAt(0);
+        const bool overlaps = oldest.offset < writePos + size && writePos < oldest.offset + oldest.size;
+        if (!overlaps) break;
+        EvictOldest();
+    }
+    offset = writePos;
+    return true;
+}
+
+void TimeRewind::Capture(const GameLevel& level) {
+    const auto start = std::chrono::steady_clock::now();
+
+    level.SaveWorldState(current);
+    const std::uint64_t tick = nextTick++;
+
+    bool keyframe = !hasKeyframe || !IsKeyframeBuffered(keyframeTick) ||
+                    tick - keyframeTick >= RewindConfig::KEYFRAME_INTERVAL ||
+                    current.actors.size() != keyframeState.actors.size();
+    std::size_t offset = 0;
+    bool reserved = false;
+    if (!keyframe) {
+        EncodeDelta(current, tick);
+        // fall back to a keyframe when most records changed anyway
+        const std::size_t keyframeSize = CommonSize(current) + current.actors.size() * sizeof(ActorSnapshot);
+        if (scratchSize < keyframeSize) {
+            reserved = Reserve(scratchSize, offset);
+            // making room may have evicted the keyframe this delta refers to
+            keyframe = !reserved || !IsKeyframeBuffered(keyframeTick);
+        } else {
+            keyframe = true;
+        }
+    }
+    if (keyframe) {
+        EncodeKeyframe(current, tick);
+        reserved = Reserve(scratchSize, offset);
+    }
+
+    if (!reserved) {
+        // A single frame does not fit the budget; keep the buffer consistent (ticks contiguous)
+        Clear();
+        if (!budgetWarningIssued) {
+            TraceLog(LOG_WARNING, "TimeRewind: frame of %zu bytes exceeds the %zu byte budget", scratchSize,
+                     arena.size());
+            budgetWarningIssued = true;
+        }
+    } else {
+        std::memcpy(arena.data() + offset, scratch.data(), scratchSize);
+        frames[(firstFrame + frameCount) % frames.size()] =
+            FrameInfo{offset, scratchSize, tick, keyframe ? tick : keyframeTick, keyframe};
+        ++frameCount;
+        head = offset + scratchSize;
+        bytesUsed += scratchSize;
+
+        if (keyframe) {
+            keyframeState = current;
+            keyframeTick = tick;
+            hasKeyframe = true;
+        }
+    }
+
+    const auto elapsed = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start);
+    lastCaptureMicros = elapsed.count();
+    averageCaptureMicros += (lastCaptureMicros - averageCaptureMicros) * CAPTURE_AVERAGE_WEIGHT;
+    maxCaptureMicros = std::max(maxCaptureMicros, lastCaptureMicros);
+    if (lastCaptureMicros > RewindConfig::CAPTURE_BUDGET_MICROS && !budgetWarningIssued) {
+        TraceLog(LOG_WARNING, "TimeRewind: capture took %.1f us for %zu actors (budget %.1f us)", lastCaptureMicros,
+                 current.actors.size(), RewindConfig::CAPTURE_BUDGET_MICROS);
+        budgetWarningIssued = true;
+    }
+}
+
+void TimeRewind::Decode(std::size_t index, WorldState& out) {
+    const FrameInfo& frame = FrameAt(index);
+    FrameHeader header{};
+
+    if (frame.keyframe) {
+        const std::uint8_t* cursor = ReadCommon(arena.data() + frame.offset, out, header);
+        out.actors.resize(header.actorCount);
+        if (header.actorCount > 0) {
+            std::memcpy(out.actors.data(), cursor, header.actorCount * sizeof(ActorSnapshot));
+        }
+        keyframeState = out;
+        keyframeTick = frame.tick;
+        hasKeyframe = true;
+        return;
+    }
+
+    // Decode the keyframe first (this also refreshes the capture-side keyframe cache)
+    const std::size_t keyIndex = index - static_cast<std::size_t>(frame.tick - frame.keyTick);
+    Decode(keyIndex, out);
+
+    const std::uint8_t* cursor = ReadCommon(arena.data() + frame.offset, out, header);
+    for (std::uint32_t entry = 0; entry < header.entryCount; ++entry) {
+        const std::uint32_t slot = Take<std::uint32_t>(cursor);
+        const std::uint32_t mask = Take<std::uint32_t>(cursor);
+        std::uint32_t words[RECORD_WORDS];
+        std::memcpy(words, &out.actors[slot], sizeof(ActorSnapshot));
+        for (std::size_t word = 0; word < RECORD_WORDS; ++word) {
+            if (mask & (1u << word)) {
+                words[word] = Take<std::uint32_t>(cursor);
+            }
+        }
+        std::memcpy(&out.actors[slot], words, sizeof(ActorSnapshot));
+    }
+}
+
+bool TimeRewind::RestoreTick(GameLevel& level, std::uint64_t tick) {
+    if (frameCount == 0 || tick < GetOldestTick() || tick > GetNewestTick()) return false;
+
+    const std::size_t index = static_cast<std::size_t>(tick - GetOldestTick());
+    while (frameCount > index + 1) {
+        DropNewest();
+    }
+    Decode(index, restoreState);
+    level.RestoreWorldState(restoreState);
+    nextTick = tick + 1;
+    return true;
+}
+
+bool TimeRewind::StepBack(GameLevel& level) {
+    if (frameCount < 2) return false;
+    return RestoreTick(level, GetNewestTick() - 1);
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "config.hpp"
+#include "world_state.h"
+
+class GameLevel;
+
+/**
+ * @brief Fixed-size ring buffer of per-tick world snapshots used for time rewind.
+ *
+ * Every tick `Capture` stores the level's `WorldState`. Every `KEYFRAME_INTERVAL`
+ * ticks a full keyframe is written; other ticks store only the 32-bit words of
+ * actor records that differ from the previous keyframe (players, actions, the
+ * collision pair cache and the trigger occupancy are always stored in full, they
+ * are tiny). Frames live in a preallocated circular byte arena whose size is the
+ * hard memory cap; the oldest frames are evicted (whole keyframe groups at a time)
+ * when space runs out.
+ *
+ * Capture cost is measured on every call and exposed for profiling.
+ */
+class TimeRewind {
+public:
+    /**
+     * @brief Create a rewind buffer.
+     *
+     * @param memoryBudgetBytes Size of the snapshot arena (hard cap for encoded frames).
+     * @param maxTicks Maximum number of buffered ticks.
+     */
+    explicit TimeRewind(std::size_t memoryBudgetBytes = RewindConfig::MEMORY_BUDGET_BYTES,
+                        std::size_t maxTicks = RewindConfig::MAX_TICKS);
+
+    /**
+     * @brief Capture the current state of the level as the next tick.
+     */
+    void Capture(const GameLevel& level);
+
+    /**
+     * @brief Discard the newest tick and restore the one before it.
+     *
+     * @return true when a tick was restored, false when the buffer is exhausted.
+     */
+    bool StepBack(GameLevel& level);
+
+    /**
+     * @brief Restore any buffered tick; newer ticks are discarded.
+     *
+     * @param tick Tick number as counted by Capture.
+     * @return true when the tick was buffered and restored.
+     */
+    bool RestoreTick(GameLevel& level, std::uint64_t tick);
+
+    /**
+     * @brief Drop all buffered ticks (e.g. after a level reset).
+     */
+    void Clear();
+
+    /** Number of ticks currently buffered. */
+    std::size_t GetBufferedTicks() const noexcept { return frameCount; }
+
+    /** Oldest buffered tick number (valid when GetBufferedTicks() > 0). */
+    std::uint64_t GetOldestTick() const noexcept { return frameCount ? FrameAt(0).tick : 0; }
+
+    /** Newest buffered tick number (valid when GetBufferedTicks() > 0). */
+    std::uint64_t GetNewestTick() const noexcept { return frameCount ? FrameAt(frameCount - 1).tick : 0; }
+
+    /** Bytes of the arena occupied by buffered frames. */
+    std::size_t GetBytesUsed() const noexcept { return bytesUsed; }
+
+    /** Size of the preallocated snapshot arena. */
+    std::size_t GetMemoryBudget() const noexcept { return arena.size(); }
+
+    /** Duration of the most recent capture in microseconds. */
+    float GetLastCaptureMicros() const noexcept { return lastCaptureMicros; }
+
+    /** Exponential moving average of capture duration in microseconds. */
+    float GetAverageCaptureMicros() const noexcept { return averageCaptureMicros; }
+
+    /** Longest capture duration seen in microseconds. */
+    float GetMaxCaptureMicros() const noexcept { return maxCaptureMicros; }
+
+private:
+    struct FrameInfo {
+        std::size_t offset = 0;
+        std::size_t size = 0;
+        std::uint64_t tick = 0;
+        std::uint64_t keyTick = 0; /**< Tick of the keyframe this frame is encoded against. */
+        bool keyframe = false;
+    };
+
+    const FrameInfo& FrameAt(std::size_t index) const noexcept { return frames[(firstFrame + index) % frames.size()]; }
+
+    // Encode the captured state into the scratch buffer, either as keyframe or as delta
+    void EncodeKeyframe(const WorldState& state, std::uint64_t tick);
+    void EncodeDelta(const WorldState& state, std::uint64_t tick);
+    // Find room for size bytes, evicting oldest frames; returns false if size exceeds the arena
+    bool Reserve(std::size_t size, std::size_t& offset);
+    void EvictOldest();
+    void DropNewest();
+    // Decode buffered frame into out; refreshes the keyframe cache as a side effect
+    void Decode(std::size_t index, WorldState& out);
+    bool IsKeyframeBuffered(std::uint64_t keyTick) const noexcept;
+
+    std::vector<std::uint8_t> arena;   /**< Circular storage for encoded frames (hard cap). */
+    std::vector<FrameInfo> frames;     /**< Frame index ring. */
+    std::vector<std::uint8_t> scratch; /**< Encoding buffer, reused every tick. */
+    std::size_t scratchSize = 0;       /**< Bytes of scratch used by the last encode. */
+    std::size_t firstFrame = 0;
+    std::size_t frameCount = 0;
+    std::size_t head = 0; /**< Arena offset just past the newest frame. */
+    std::size_t bytesUsed = 0;
+
+    WorldState current;       /**< State captured this tick. */
+    WorldState keyframeState; /**< Decoded state of the newest keyframe; deltas are built against it. */
+    WorldState restoreState;  /**< Decoding target used when rewinding. */
+    std::uint64_t keyframeTick = 0;
+    bool hasKeyframe = false;
+    std::uint64_t nextTick = 0;
+
+    float lastCaptureMicros = 0.0f;
+    float averageCaptureMicros = 0.0f;
+    float maxCaptureMicros = 0.0f;
+    bool budgetWarningIssued = false;
+};
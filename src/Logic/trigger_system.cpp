@@ -0,0 +1,280 @@
+#include "trigger_system.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "config.hpp"
+#include "profiler.h"
+
+namespace {
+TriggerKind ParseKind(const char* name) {
+    if (name == nullptr) return TriggerKind::Custom;
+    const std::string_view kind{name};
+    if (kind == TriggerConfig::EXIT_TYPE) return TriggerKind::Exit;
+    if (kind == TriggerConfig::DAMAGE_TYPE) return TriggerKind::Damage;
+    if (kind == TriggerConfig::CHECKPOINT_TYPE) return TriggerKind::Checkpoint;
+    return TriggerKind::Custom;
+}
+
+std::uint64_t OccupancyKey(const Actor& actor, std::uint32_t trigger) {
+    return (static_cast<std::uint64_t>(actor.GetSpawnSlot()) << 32) | trigger;
+}
+}  // namespace
+
+void TriggerSystem::Build(const TmxMap* map, const TmxLayer* layer) {
+    volumes.clear();
+    points.clear();
+    properties.clear();
+    cellStart.clear();
+    cellTriggers.clear();
+    occupancy.clear();
+    current.clear();
+    testedLayers = 0;
+    width = 0;
+    height = 0;
+    if (map == nullptr || layer == nullptr || map->tileWidth == 0 || map->tileHeight == 0) return;
+    if (layer->type != LAYER_TYPE_OBJECT_GROUP) {
+        TraceLog(LOG_WARNING, "Trigger layer %s is not an object layer", layer->name);
+        return;
+    }
+
+    const TmxObjectGroup& group = layer->exact.objectGroup;
+    volumes.reserve(group.objectsLength);
+    for (std::uint32_t i = 0; i < group.objectsLength; ++i) {
+        const TmxObject& obj = group.objects[i];
+        if (!obj.visible) continue;
+
+        TriggerVolume volume;
+        volume.objectId = obj.id;
+        volume.name = obj.name ? obj.name : "";
+        // the object class selects the kind; untyped objects may use their name instead
+        volume.kind = ParseKind((obj.typeString != nullptr && obj.typeString[0] != '\0') ? obj.typeString : obj.name);
+        const float x = static_cast<float>(obj.x);
+        const float y = static_cast<float>(obj.y);
+        const float w = static_cast<float>(obj.width);
+        const float h = static_cast<float>(obj.height);
+
+        // Polygon vertices are relative to the object position and rotate around it (clockwise in Tiled)
+        std::vector<Vector2> outline;
+        switch (obj.type) {
+        case OBJECT_TYPE_RECTANGLE:
+            if (obj.rotation == 0.0) {
+                volume.shape = TriggerShape::Rectangle;
+                volume.bounds = {x, y, w, h};
+            } else {
+                outline = {{0.0f, 0.0f}, {w, 0.0f}, {w, h}, {0.0f, h}};
+            }
+            break;
+        case OBJECT_TYPE_ELLIPSE:
+            if (obj.rotation != 0.0) {
+                TraceLog(LOG_WARNING, "Trigger %u: rotation of ellipses is ignored", obj.id);
+            }
+            volume.shape = TriggerShape::Ellipse;
+            volume.bounds = {x, y, w, h};
+            break;
+        case OBJECT_TYPE_POLYGON:
+            if (obj.points == nullptr || obj.pointsLength < 3) {
+                TraceLog(LOG_WARNING, "Trigger %u: polygon needs at least 3 points, skipped", obj.id);
+                continue;
+            }
+            outline.assign(obj.points, obj.points + obj.pointsLength);
+            break;
+        default:
+            TraceLog(LOG_WARNING, "Trigger %u: only rectangles, ellipses and polygons are supported, skipped", obj.id);
+            continue;
+        }
+        if (!outline.empty()) {
+            const float angle = static_cast<float>(obj.rotation) * DEG2RAD;
+            const float cosA = std::cos(angle);
+            const float sinA = std::sin(angle);
+            volume.shape = TriggerShape::Polygon;
+            volume.firstPoint = static_cast<std::uint32_t>(points.size());
+            volume.pointCount = static_cast<std::uint32_t>(outline.size());
+            constexpr float INF = std::numeric_limits<float>::infinity();
+            Vector2 min{INF, INF};
+            Vector2 max{-INF, -INF};
+            for (const Vector2& local : outline) {
+                const Vector2 point{x + local.x * cosA - local.y * sinA, y + local.x * sinA + local.y * cosA};
+                points.push_back(point);
+                min = {std::min(min.x, point.x), std::min(min.y, point.y)};
+                max = {std::max(max.x, point.x), std::max(max.y, point.y)};
+            }
+            volume.bounds = {min.x, min.y, max.x - min.x, max.y - min.y};
+        }
+        if (volume.bounds.width <= 0.0f || volume.bounds.height <= 0.0f) {
+            TraceLog(LOG_WARNING, "Trigger %u: empty shape, skipped", obj.id);
+            if (volume.shape == TriggerShape::Polygon) points.resize(volume.firstPoint);
+            continue;
+        }
+
+        volume.firstProperty = static_cast<std::uint32_t>(properties.size());
+        volume.propertyCount = obj.propertiesLength;
+        for (std::uint32_t p = 0; p < obj.propertiesLength; ++p) {
+            const TmxProperty& source = obj.properties[p];
+            TriggerProperty& property = properties.emplace_back();
+            property.name = source.name ? source.name : "";
+            property.stringValue = source.stringValue ? source.stringValue : "";
+            property.type = source.type;
+            property.intValue = source.intValue;
+            property.floatValue = source.floatValue;
+            property.boolValue = source.boolValue;
+        }
+        volumes.push_back(std::move(volume));
+        const auto index = static_cast<std::uint32_t>(volumes.size() - 1);
+        volumes.back().mask = static_cast<std::uint32_t>(
+            GetInt(index, TriggerConfig::MASK_PROPERTY, static_cast<int>(TriggerConfig::DEFAULT_MASK)));
+        testedLayers |= volumes.back().mask;
+    }
+    if (volumes.empty()) return;
+
+    // Bake the cell table: count the volumes per cell, then fill the cells in volume order
+    width = static_cast<int>(map->width);
+    height = static_cast<int>(map->height);
+    tileWidth = static_cast<float>(map->tileWidth);
+    tileHeight = static_cast<float>(map->tileHeight);
+    cellStart.assign(static_cast<std::size_t>(width) * height + 1, 0);
+    auto forEachCell = [this](Rectangle area, auto&& visit) {
+        const int minX = std::max(static_cast<int>(std::floor(area.x / tileWidth)), 0);
+        const int minY = std::max(static_cast<int>(std::floor(area.y / tileHeight)), 0);
+        const int maxX = std::min(static_cast<int>(std::floor((area.x + area.width) / tileWidth)), width - 1);
+        const int maxY = std::min(static_cast<int>(std::floor((area.y + area.height) / tileHeight)), height - 1);
+        for (int cy = minY; cy <= maxY; ++cy) {
+            for (int cx = minX; cx <= maxX; ++cx) {
+                visit(static_cast<std::size_t>(cy) * width + static_cast<std::size_t>(cx));
+            }
+        }
+    };
+    for (const TriggerVolume& volume : volumes) {
+        forEachCell(volume.bounds, [this](std::size_t cell) { ++cellStart[cell + 1]; });
+    }
+    for (std::size_t cell = 1; cell < cellStart.size(); ++cell) {
+        cellStart[cell] += cellStart[cell - 1];
+    }
+    cellTriggers.resize(cellStart.back());
+    std::vector<std::uint32_t> fill(cellStart.begin(), cellStart.end() - 1);
+    for (std::uint32_t index = 0; index < volumes.size(); ++index) {
+        forEachCell(volumes[index].bounds, [&](std::size_t cell) { cellTriggers[fill[cell]++] = index; });
+    }
+    TraceLog(LOG_INFO, "Triggers: %zu volumes in %zu cell entries", volumes.size(), cellTriggers.size());
+}
+
+bool TriggerSystem::Contains(std::uint32_t trigger, Vector2 point) const {
+    const TriggerVolume& volume = volumes[trigger];
+    switch (volume.shape) {
+    case TriggerShape::Rectangle:
+        return CheckCollisionPointRec(point, volume.bounds);
+    case TriggerShape::Ellipse: {
+        const float rx = volume.bounds.width * 0.5f;
+        const float ry = volume.bounds.height * 0.5f;
+        const float dx = (point.x - volume.bounds.x - rx) / rx;
+        const float dy = (point.y - volume.bounds.y - ry) / ry;
+        return dx * dx + dy * dy <= 1.0f;
+    }
+    case TriggerShape::Polygon:
+        return CheckCollisionPointRec(point, volume.bounds) &&
+               CheckCollisionPointPoly(point, points.data() + volume.firstPoint, static_cast<int>(volume.pointCount));
+    }
+    return false;
+}
+
+void TriggerSystem::Locate(Actor& actor) {
+    const Rectangle body = actor.GetRect();
+    const Vector2 center{body.x + body.width * 0.5f, body.y + body.height * 0.5f};
+    const int x = static_cast<int>(std::floor(center.x / tileWidth));
+    const int y = static_cast<int>(std::floor(center.y / tileHeight));
+    if (x < 0 || y < 0 || x >= width || y >= height) return;
+
+    const std::size_t cell = static_cast<std::size_t>(y) * width + static_cast<std::size_t>(x);
+    const std::uint32_t layer = actor.GetCollisionLayer();
+    for (std::uint32_t i = cellStart[cell]; i < cellStart[cell + 1]; ++i) {
+        const std::uint32_t trigger = cellTriggers[i];
+        if ((volumes[trigger].mask & layer) != 0 && Contains(trigger, center)) {
+            current.push_back({OccupancyKey(actor, trigger), &actor});
+        }
+    }
+}
+
+void TriggerSystem::Update(const std::vector<std::unique_ptr<Actor>>& actors, std::span<Actor* const> players,
+                           EventBus& events) {
+    if (occupancy.empty() && testedLayers == 0) return;
+    PROFILE_ZONE("Triggers");
+    current.clear();
+    if (testedLayers != 0) {
+        auto locate = [this](Actor* actor) {
+            if (actor && actor->IsAlive() && (actor->GetCollisionLayer() & testedLayers) != 0) {
+                Locate(*actor);
+            }
+        };
+        for (auto& a : actors)
+            locate(a.get());
+        for (Actor* player : players)
+            locate(player);
+    }
+    auto byKey = [](const Occupant& lhs, const Occupant& rhs) { return lhs.key < rhs.key; };
+    std::sort(current.begin(), current.end(), byKey);
+
+    // Merge with the previous occupants: Enter, Stay and Exit all in key order
+    auto publish = [&](const Occupant& occupant, ContactPhase phase) {
+        const auto trigger = static_cast<std::uint32_t>(occupant.key);
+        events.Publish(TriggerEvent{occupant.actor, trigger, volumes[trigger].kind, phase});
+    };
+    std::size_t previous = 0;
+    for (const Occupant& occupant : current) {
+        while (previous < occupancy.size() && occupancy[previous].key < occupant.key) {
+            publish(occupancy[previous++], ContactPhase::Exit);
+        }
+        const bool stayed = previous < occupancy.size() && occupancy[previous].key == occupant.key;
+        if (stayed) ++previous;
+        publish(occupant, stayed ? ContactPhase::Stay : ContactPhase::Enter);
+    }
+    while (previous < occupancy.size()) {
+        publish(occupancy[previous++], ContactPhase::Exit);
+    }
+    std::swap(occupancy, current);
+}
+
+const TriggerProperty* TriggerSystem::FindProperty(std::uint32_t trigger, std::string_view name) const {
+    const TriggerVolume& volume = volumes[trigger];
+    for (std::uint32_t i = 0; i < volume.propertyCount; ++i) {
+        const TriggerProperty& property = properties[volume.firstProperty + i];
+        if (property.name == name) return &property;
+    }
+    return nullptr;
+}
+
+int TriggerSystem::GetInt(std::uint32_t trigger, std::string_view name, int fallback) const {
+    const TriggerProperty* property = FindProperty(trigger, name);
+    return (property && property->type == PROPERTY_TYPE_INT) ? property->intValue : fallback;
+}
+
+float TriggerSystem::GetFloat(std::uint32_t trigger, std::string_view name, float fallback) const {
+    const TriggerProperty* property = FindProperty(trigger, name);
+    if (property == nullptr) return fallback;
+    if (property->type == PROPERTY_TYPE_FLOAT) return property->floatValue;
+    return property->type == PROPERTY_TYPE_INT ? static_cast<float>(property->intValue) : fallback;
+}
+
+bool TriggerSystem::GetBool(std::uint32_t trigger, std::string_view name, bool fallback) const {
+    const TriggerProperty* property = FindProperty(trigger, name);
+    return (property && property->type == PROPERTY_TYPE_BOOL) ? property->boolValue : fallback;
+}
+
+std::string_view TriggerSystem::GetString(std::uint32_t trigger, std::string_view name,
+                                          std::string_view fallback) const {
+    const TriggerProperty* property = FindProperty(trigger, name);
+    return (property && (property->type == PROPERTY_TYPE_STRING || property->type == PROPERTY_TYPE_FILE))
+               ? std::string_view{property->stringValue}
+               : fallback;
+}
+
+void TriggerSystem::SaveOccupancy(std::vector<std::uint64_t>& keys) const {
+    keys.clear();
+    for (const Occupant& occupant : occupancy) {
+        keys.push_back(occupant.key);
+    }
+}
+
+void TriggerSystem::RestoreOccupancy(Actor& actor, std::uint32_t trigger) {
+    if (trigger < volumes.size()) {
+        occupancy.push_back({OccupancyKey(actor, trigger), &actor});
+    }
+}
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "raylib.h"
+#include "raytmx.h"
+#include "actor.h"
+#include "event_bus.h"
+
+/// Shape of a trigger volume.
+enum class TriggerShape : std::uint8_t {
+    Rectangle,
+    Ellipse, /**< Inscribed in the volume's bounds. */
+    Polygon,
+};
+
+/**
+ * @brief Custom property of a trigger volume, copied from the TMX object.
+ */
+struct TriggerProperty {
+    std::string name;
+    std::string stringValue; /**< string and file properties. */
+    TmxPropertyType type = PROPERTY_TYPE_STRING;
+    int intValue = 0;
+    float floatValue = 0.0f;
+    bool boolValue = false;
+};
+
+/**
+ * @brief A static area of the level that reports the actors inside it.
+ */
+struct TriggerVolume {
+    std::uint32_t objectId = 0; /**< Tiled object id. */
+    std::string name;
+    TriggerKind kind = TriggerKind::Custom;
+    TriggerShape shape = TriggerShape::Rectangle;
+    std::uint32_t mask = 0;         /**< Collision layers of the actors it reacts to. */
+    Rectangle bounds{};             /**< World-space AABB of the shape. */
+    std::uint32_t firstPoint = 0;   /**< Polygon vertices in world space (Polygon only). */
+    std::uint32_t pointCount = 0;
+    std::uint32_t firstProperty = 0;
+    std::uint32_t propertyCount = 0;
+};
+
+/**
+ * @brief Trigger volumes of a TMX object layer with a per-cell lookup table.
+ *
+ * The volumes (rectangles, ellipses and polygons; rotated rectangles become polygons)
+ * are read once when the level loads, and every tile cell lists the volumes whose
+ * bounds touch it in a compact cell-indexed table (CSR layout, like TileCollisionGrid).
+ * An actor is inside a volume when the center of its collider is, so each pass looks
+ * up one cell per actor and tests only the few volumes listed there: the cost grows
+ * with the number of actors, not with the number of volumes in the level. Actors on
+ * collision layers no volume reacts to are skipped before their collider is read.
+ *
+ * Occupancy persists between passes like the collision pair cache, and every pass
+ * publishes a TriggerEvent per actor and volume: Enter for new occupants, Stay for
+ * continued ones and Exit for actors that left or died. The occupancy is part of the
+ * world state (SaveOccupancy / RestoreOccupancy).
+ */
+class TriggerSystem {
+public:
+    TriggerSystem() = default;
+    TriggerSystem(const TriggerSystem&) = delete;
+    TriggerSystem& operator=(const TriggerSystem&) = delete;
+
+    /**
+     * @brief Read the visible objects of an object layer and bake the cell table.
+     *
+     * Points, polylines, text and tile objects are skipped with a warning.
+     *
+     * @param map Loaded map (its tile size is the cell size).
+     * @param layer Object layer; nullptr or another layer type leaves the system empty.
+     */
+    void Build(const TmxMap* map, const TmxLayer* layer);
+
+    /**
+     * @brief Find the volumes the actors are in and publish the changes.
+     *
+     * @param events Bus that receives a TriggerEvent per occupant and phase.
+     */
+    void Update(const std::vector<std::unique_ptr<Actor>>& actors, std::span<Actor* const> players,
+                EventBus& events);
+
+    /**
+     * @brief Number of trigger volumes.
+     */
+    std::size_t GetCount() const noexcept { return volumes.size(); }
+
+    /**
+     * @brief A trigger volume by index (TriggerEvent::trigger).
+     */
+    const TriggerVolume& Get(std::uint32_t trigger) const { return volumes[trigger]; }
+
+    /**
+     * @brief Whether a world-space point lies inside a volume's shape.
+     */
+    bool Contains(std::uint32_t trigger, Vector2 point) const;
+
+    /**
+     * @brief Find a custom property of a volume by name.
+     *
+     * @return nullptr when the volume has no such property.
+     */
+    const TriggerProperty* FindProperty(std::uint32_t trigger, std::string_view name) const;
+
+    /**
+     * @brief Typed property lookups; fallback is returned when the property is missing or of another type.
+     *
+     * GetFloat also accepts int properties.
+     */
+    int GetInt(std::uint32_t trigger, std::string_view name, int fallback = 0) const;
+    float GetFloat(std::uint32_t trigger, std::string_view name, float fallback = 0.0f) const;
+    bool GetBool(std::uint32_t trigger, std::string_view name, bool fallback = false) const;
+    std::string_view GetString(std::uint32_t trigger, std::string_view name, std::string_view fallback = {}) const;
+
+    /**
+     * @brief Number of actor and volume pairs found by the last pass.
+     */
+    std::size_t GetOccupancyCount() const noexcept { return occupancy.size(); }
+
+    /**
+     * @brief Write the occupancy keys, (actor spawn slot << 32) | trigger, in ascending order.
+     */
+    void SaveOccupancy(std::vector<std::uint64_t>& keys) const;
+
+    /**
+     * @brief Forget all occupants (before restoring a world state).
+     */
+    void ClearOccupancy() noexcept { occupancy.clear(); }
+
+    /**
+     * @brief Add an occupant; restore occupants in ascending key order.
+     */
+    void RestoreOccupancy(Actor& actor, std::uint32_t trigger);
+
+private:
+    // An actor inside a volume; key is (actor spawn slot << 32) | trigger
+    struct Occupant {
+        std::uint64_t key;
+        Actor* actor;
+    };
+
+    // Append the occupants of one actor to current
+    void Locate(Actor& actor);
+
+    std::vector<TriggerVolume> volumes;
+    std::vector<Vector2> points;
+    std::vector<TriggerProperty> properties;
+    // union of the volume masks: actors on no other layer are never located
+    std::uint32_t testedLayers = 0;
+
+    int width = 0;
+    int height = 0;
+    float tileWidth = 0.0f;
+    float tileHeight = 0.0f;
+    std::vector<std::uint32_t> cellStart;    /**< width*height+1 offsets into cellTriggers. */
+    std::vector<std::uint32_t> cellTriggers; /**< Volume indices grouped by cell. */
+
+    // occupants of the last pass and of the current one, both sorted by key after a pass
+    std::vector<Occupant> occupancy;
+    std::vector<Occupant> current;
+};
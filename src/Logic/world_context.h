@@ -0,0 +1,24 @@
+#pragma once
+
+#include "gamelogic.h"
+#include "collision_system.h"
+#include "event_bus.h"
+#include "input_manager.h"
+#include "animation_system.h"
+#include "tick_scheduler.h"
+
+/**
+ * @brief Per-world simulation services, owned by a GameLevel.
+ *
+ * Nothing in here is shared between levels, so several worlds can run side by side
+ * in one process (e.g. headless worlds on separate threads). Textures are the only
+ * shared asset state; see TextureManager.
+ */
+struct WorldContext {
+    AnimationSystem animations; /**< Animation playback records of all actors. */
+    GameLogic logic;            /**< Active actions of the world. */
+    CollisionSystem collisions; /**< Collision listeners and per-frame scratch. */
+    EventBus events;            /**< Key, collision, damage and removal events of the current tick. */
+    InputManager input{events}; /**< Keyboard polling, input sources and recorder. */
+    TickScheduler ticks;        /**< Update rates of the actors' tick groups. */
+};
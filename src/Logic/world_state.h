@@ -0,0 +1,82 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include "actor_snapshot.h"
+#include "types.h"
+#include "config.hpp"
+
+/**
+ * @brief Compact, trivially copyable record of one active `Action`.
+ *
+ * Actions are identified by kind and target actor spawn slot so they can be
+ * recreated by `GameLogic::CreateAction` when a world state is restored.
+ */
+struct ActionSnapshot {
+    enum class Kind : std::uint8_t { Move = 0, Jump };
+
+    std::uint32_t targetSlot = 0; /**< Spawn slot of the target actor. */
+    float duration = 0.0f;
+    float elapsed = 0.0f;
+    float param = 0.0f; /**< Kind-specific parameter (custom speed / jump strength). */
+    Kind kind = Kind::Move;
+    GameTypes::Direction direction = GameTypes::Direction::Right;
+    bool performedOnce = false;
+    bool activeMove = false; /**< True when the action is its target's active move action. */
+};
+
+static_assert(std::is_trivially_copyable_v<ActionSnapshot>, "ActionSnapshot must stay memcpy-able");
+
+/**
+ * @brief Complete restorable simulation state of a level at one tick.
+ *
+ * Actor records are indexed by spawn slot and include retired (dead) actors, so
+ * the record count stays constant for the lifetime of a level.
+ */
+struct WorldState {
+    static constexpr std::uint32_t NO_CHECKPOINT = std::numeric_limits<std::uint32_t>::max();
+
+    std::vector<ActorSnapshot> actors; /**< Non-player actors indexed by spawn slot. */
+    std::array<ActorSnapshot, PlayerConfig::MAX_PLAYERS> players; /**< Player records by player index. */
+    std::uint8_t playerCount = 0;                                 /**< Valid entries of players. */
+    std::uint8_t levelState = 0;         /**< GameLevel::LevelState. */
+    float gameOverTimer = 0.0f;          /**< Time the game over message has been shown. */
+    std::uint32_t checkpoint = NO_CHECKPOINT; /**< Trigger index of the checkpoint the players respawn at. */
+    std::vector<ActionSnapshot> actions; /**< Active actions in execution order. */
+    std::uint32_t tickFrame = 0;         /**< TickScheduler frame counter. */
+    /** Collision pair cache, (self slot << 32) | other slot in ascending order. Not hashed: contacts
+        only matter through the actor state they change, which is. */
+    std::vector<std::uint64_t> contacts;
+    /** Trigger occupancy, (actor slot << 32) | trigger in ascending order. Not hashed, like contacts. */
+    std::vector<std::uint64_t> triggers;
+};
+
+/**
+ * @brief 64-bit FNV-1a hash of a world state (actor and player records, level state, checkpoint, actions and
+ * tick frame).
+ *
+ * Used to check that two runs (e.g. a recorded session and its replay) ended in
+ * the same simulation state.
+ */
+inline std::uint64_t HashWorldState(const WorldState& state) {
+    std::uint64_t hash = 0xCBF29CE484222325ull;
+    auto mix = [&hash](const void* data, std::size_t size) {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+        }
+    };
+    mix(state.actors.data(), state.actors.size() * sizeof(ActorSnapshot));
+    mix(&state.playerCount, sizeof(state.playerCount));
+    mix(state.players.data(), state.playerCount * sizeof(ActorSnapshot));
+    mix(&state.levelState, sizeof(state.levelState));
+    mix(&state.gameOverTimer, sizeof(state.gameOverTimer));
+    mix(&state.checkpoint, sizeof(state.checkpoint));
+    mix(state.actions.data(), state.actions.size() * sizeof(ActionSnapshot));
+    mix(&state.tickFrame, sizeof(state.tickFrame));
+    return hash;
+}
@@ -0,0 +1,49 @@
+#include "latency_shim.h"
+#include <cstring>
+
+void LatencyShim::Configure(const Settings& newSettings, std::uint32_t seed) noexcept {
+    settings = newSettings;
+    rng = CounterRng(seed);
+    active = settings.latencyMs > 0.0f || settings.jitterMs > 0.0f || settings.lossPercent > 0.0f;
+}
+
+void LatencyShim::Send(UdpSocket& socket, const NetAddress& to, const void* data, std::size_t size, double now) {
+    if (!active) {
+        socket.Send(to, data, size);
+        return;
+    }
+    if (rng.NextFloat() * 100.0f < settings.lossPercent) {
+        ++dropped;
+        return;
+    }
+    const float delayMs = settings.latencyMs + rng.NextFloat() * settings.jitterMs;
+    if (delayMs <= 0.0f) {
+        socket.Send(to, data, size);
+        return;
+    }
+    if (heldCount == held.size() || size > NetConfig::MAX_PACKET_SIZE) {
+        // a congested link drops packets too
+        ++dropped;
+        return;
+    }
+    for (HeldPacket& packet : held) {
+        if (packet.used) continue;
+        packet.dueTime = now + delayMs / 1000.0;
+        packet.to = to;
+        packet.size = static_cast<std::uint16_t>(size);
+        packet.used = true;
+        std::memcpy(packet.data.data(), data, size);
+        ++heldCount;
+        break;
+    }
+}
+
+void LatencyShim::Flush(UdpSocket& socket, double now) {
+    if (heldCount == 0) return;
+    for (HeldPacket& packet : held) {
+        if (!packet.used || packet.dueTime > now) continue;
+        socket.Send(packet.to, packet.data.data(), packet.size);
+        packet.used = false;
+        --heldCount;
+    }
+}
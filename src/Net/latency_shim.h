@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "config.hpp"
+#include "counter_rng.h"
+#include "udp_socket.h"
+
+/**
+ * @brief Simulated network conditions for outgoing datagrams (loopback testing).
+ *
+ * Each datagram is dropped with the configured probability or held back for the
+ * latency plus a random jitter before it is handed to the socket, so two processes on
+ * 127.0.0.1 see the delays and losses of a real connection. Only the sending side is
+ * affected; give both peers the same settings for a symmetric link. Held datagrams
+ * live in a fixed queue, so the shim does not allocate while running. Jitter may
+ * reorder datagrams, like a real network.
+ */
+class LatencyShim {
+public:
+    /// Simulated link conditions.
+    struct Settings {
+        float latencyMs = 0.0f;   /**< One-way delay. */
+        float jitterMs = 0.0f;    /**< Extra random delay in [0, jitterMs). */
+        float lossPercent = 0.0f; /**< Chance of dropping a datagram. */
+    };
+
+    /**
+     * @brief Set the link conditions.
+     *
+     * @param settings Link conditions; all zero sends datagrams directly.
+     * @param seed Key of the random stream deciding losses and jitter.
+     */
+    void Configure(const Settings& settings, std::uint32_t seed) noexcept;
+
+    /** @brief True when datagrams are delayed or dropped. */
+    bool IsActive() const noexcept { return active; }
+
+    /**
+     * @brief Send a datagram through the simulated link.
+     *
+     * @param now Current time in seconds (the clock Flush is called with).
+     */
+    void Send(UdpSocket& socket, const NetAddress& to, const void* data, std::size_t size, double now);
+
+    /**
+     * @brief Hand the held datagrams that are due to the socket.
+     */
+    void Flush(UdpSocket& socket, double now);
+
+    /** @brief Datagrams dropped so far (simulated loss or a full queue). */
+    std::uint64_t GetDroppedCount() const noexcept { return dropped; }
+
+private:
+    struct HeldPacket {
+        double dueTime = 0.0;
+        NetAddress to;
+        std::uint16_t size = 0;
+        bool used = false;
+        std::array<std::uint8_t, NetConfig::MAX_PACKET_SIZE> data{};
+    };
+
+    Settings settings;
+    CounterRng rng;
+    std::array<HeldPacket, NetConfig::SHIM_QUEUE_SIZE> held{};
+    std::size_t heldCount = 0;
+    std::uint64_t dropped = 0;
+    bool active = false;
+};
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Datagram layout of the rollback netplay protocol.
+ *
+ * Every datagram starts with a PacketHeader. Peers send Hello packets until they have
+ * heard from each other, then one Input packet per frame: the sender's inputs from the
+ * first tick the receiver has not acknowledged yet (so lost packets are covered by the
+ * next one), the receiver's progress as acknowledgement, and the state hash of the
+ * newest tick the sender has finalised, which lets both sides detect a desync. Values
+ * are little-endian as written by the host, like the input recordings.
+ */
+namespace NetProtocol {
+enum class PacketType : std::uint8_t { Hello = 1, Input = 2 };
+
+#pragma pack(push, 1)
+struct PacketHeader {
+    std::uint32_t magic;   /**< NetConfig::PROTOCOL_MAGIC */
+    std::uint16_t version; /**< NetConfig::PROTOCOL_VERSION */
+    PacketType type;
+    std::uint8_t player; /**< Player slot of the sender. */
+};
+
+struct HelloPacket {
+    PacketHeader header;
+    std::uint32_t seed;       /**< Level seed; both peers must simulate the same level. */
+    std::uint16_t levelIndex; /**< Index into GameConfig::LEVELS. */
+};
+
+/* Followed by inputCount input bytes (NetInputSource::Buttons) for ticks startTick, startTick + 1, ... */
+struct InputPacket {
+    PacketHeader header;
+    std::uint32_t startTick;   /**< Tick of the first input in the packet. */
+    std::uint32_t ackTick;     /**< First tick of the receiver's input the sender has not received yet. */
+    std::uint32_t checkedTick; /**< Newest finalised tick of the sender plus one; 0 when none. */
+    std::uint64_t checkedHash; /**< HashWorldState after that tick. */
+    std::uint8_t inputCount;
+};
+#pragma pack(pop)
+}  // namespace NetProtocol
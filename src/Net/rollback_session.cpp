@@ -0,0 +1,313 @@
+#include "rollback_session.h"
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstring>
+#include "gamelevel.h"
+#include "net_protocol.h"
+#include "profiler.h"
+#include "state_checksum_log.h"
+#include "raylib.h"
+
+namespace {
+constexpr std::uint32_t INPUT_DELAY = NetConfig::INPUT_DELAY_TICKS;
+
+static_assert(sizeof(NetProtocol::InputPacket) + NetConfig::MAX_INPUTS_PER_PACKET <= NetConfig::MAX_PACKET_SIZE,
+              "NetConfig::MAX_PACKET_SIZE must hold a full input packet");
+
+NetProtocol::PacketHeader MakeHeader(NetProtocol::PacketType type, std::size_t player) {
+    return {NetConfig::PROTOCOL_MAGIC, NetConfig::PROTOCOL_VERSION, type, static_cast<std::uint8_t>(player)};
+}
+}  // namespace
+
+RollbackSession::~RollbackSession() {
+    Stop();
+}
+
+bool RollbackSession::Start(GameLevel& levelNew, const Settings& settingsNew, std::size_t levelIndexNew, double now) {
+    Stop();
+    if (levelNew.GetPlayerCount() < 2 || settingsNew.localPlayer > 1) {
+        TraceLog(LOG_ERROR, "Net: rollback sessions need a level with two players");
+        return false;
+    }
+    if (!socket.Open(settingsNew.localPort)) {
+        return false;
+    }
+    level = &levelNew;
+    settings = settingsNew;
+    seed = level->GetSeed();
+    levelIndex = static_cast<std::uint16_t>(levelIndexNew);
+    shim.Configure(settings.shim, seed + static_cast<std::uint32_t>(settings.localPlayer) + 1);
+    for (std::size_t port = 0; port < sources.size(); ++port) {
+        sources[port].SetTick(0, 0);
+        level->GetContext().input.SetSource(&sources[port], port);
+    }
+
+    // nobody presses anything during the first INPUT_DELAY ticks
+    localInputs.fill(0);
+    remoteInputs.fill(0);
+    usedRemote.fill(0);
+    currentTick = 0;
+    localInputEnd = INPUT_DELAY;
+    remoteInputEnd = INPUT_DELAY;
+    peerAck = INPUT_DELAY;
+    rollbackTick = NO_ROLLBACK;
+    finalTickEnd = 0;
+    peerCheckedTick = 0;
+    desynced = false;
+    status = Status::Connecting;
+    startTime = now;
+    lastReceiveTime = now;
+    lastHelloTime = now - NetConfig::HELLO_INTERVAL;
+    TraceLog(LOG_INFO, "Net: player %zu on port %u, waiting for peer on port %u", settings.localPlayer + 1,
+             static_cast<unsigned>(settings.localPort), static_cast<unsigned>(settings.peer.port));
+    if (shim.IsActive()) {
+        TraceLog(LOG_INFO, "Net: simulating %.0f ms latency, %.0f ms jitter, %.1f%% loss", settings.shim.latencyMs,
+                 settings.shim.jitterMs, settings.shim.lossPercent);
+    }
+    return true;
+}
+
+void RollbackSession::Stop() {
+    if (level == nullptr) return;
+    for (std::size_t port = 0; port < sources.size(); ++port) {
+        level->GetContext().input.SetSource(nullptr, port);
+    }
+    socket.Close();
+    level = nullptr;
+}
+
+bool RollbackSession::AdvanceFrame(std::uint8_t localButtons, double now) {
+    if (level == nullptr || status == Status::Disconnected) return false;
+    ReceivePackets(now);
+
+    if (status == Status::Connecting) {
+        if (now - startTime > NetConfig::CONNECT_TIMEOUT) {
+            TraceLog(LOG_ERROR, "Net: peer did not answer within %.0f s", NetConfig::CONNECT_TIMEOUT);
+            status = Status::Disconnected;
+            return false;
+        }
+        SendHello(now);
+        shim.Flush(socket, now);
+        return false;
+    }
+    if (status == Status::Disconnected) return false;
+    if (now - lastReceiveTime > NetConfig::DISCONNECT_TIMEOUT) {
+        TraceLog(LOG_WARNING, "Net: peer disconnected (no packet for %.0f s)", NetConfig::DISCONNECT_TIMEOUT);
+        status = Status::Disconnected;
+        return false;
+    }
+
+    Rollback();
+
+    // Wait for the peer when predicting further ahead would exceed the saved states, or when
+    // our unacknowledged input would no longer fit the history
+    bool simulated = false;
+    if (currentTick >= remoteInputEnd + NetConfig::MAX_PREDICTION_TICKS ||
+        localInputEnd - peerAck >= NetConfig::INPUT_HISTORY) {
+        ++stalledFrames;
+    } else {
+        localInputs[localInputEnd & INPUT_MASK] = localButtons;
+        ++localInputEnd;
+        SaveState();
+        FinalizeTicks();
+        SimulateTick();
+        simulated = true;
+    }
+
+    SendInputs(now);
+    shim.Flush(socket, now);
+    return simulated;
+}
+
+void RollbackSession::ReceivePackets(double now) {
+    std::array<std::uint8_t, NetConfig::MAX_PACKET_SIZE> buffer;
+    NetAddress from;
+    while (const std::size_t size = socket.Receive(buffer.data(), buffer.size(), from)) {
+        if (from != settings.peer || size < sizeof(NetProtocol::PacketHeader)) continue;
+        NetProtocol::PacketHeader header;
+        std::memcpy(&header, buffer.data(), sizeof(header));
+        if (header.magic != NetConfig::PROTOCOL_MAGIC || header.player != 1 - settings.localPlayer) continue;
+        if (header.version != NetConfig::PROTOCOL_VERSION) {
+            TraceLog(LOG_ERROR, "Net: peer uses protocol version %u, expected %u", static_cast<unsigned>(header.version),
+                     static_cast<unsigned>(NetConfig::PROTOCOL_VERSION));
+            status = Status::Disconnected;
+            return;
+        }
+        ++packetsReceived;
+        if (header.type == NetProtocol::PacketType::Hello) {
+            HandleHello(buffer.data(), size, now);
+        } else if (header.type == NetProtocol::PacketType::Input) {
+            HandleInput(buffer.data(), size, now);
+        }
+        if (status == Status::Disconnected) return;
+    }
+}
+
+void RollbackSession::HandleHello(const std::uint8_t* data, std::size_t size, double now) {
+    if (size < sizeof(NetProtocol::HelloPacket)) return;
+    NetProtocol::HelloPacket hello;
+    std::memcpy(&hello, data, sizeof(hello));
+    if (hello.seed != seed || hello.levelIndex != levelIndex) {
+        TraceLog(LOG_ERROR, "Net: peer runs level %u with seed 0x%08X, this process level %u with seed 0x%08X",
+                 static_cast<unsigned>(hello.levelIndex), hello.seed, static_cast<unsigned>(levelIndex), seed);
+        status = Status::Disconnected;
+        return;
+    }
+    lastReceiveTime = now;
+    if (status == Status::Connecting) {
+        status = Status::Running;
+        TraceLog(LOG_INFO, "Net: connected to player %zu", 2 - settings.localPlayer);
+    }
+}
+
+void RollbackSession::HandleInput(const std::uint8_t* data, std::size_t size, double now) {
+    if (size < sizeof(NetProtocol::InputPacket)) return;
+    NetProtocol::InputPacket packet;
+    std::memcpy(&packet, data, sizeof(packet));
+    if (size < sizeof(packet) + packet.inputCount) return;
+    // the peer only sends inputs after it has checked our hello
+    lastReceiveTime = now;
+    if (status == Status::Connecting) {
+        status = Status::Running;
+        TraceLog(LOG_INFO, "Net: connected to player %zu", 2 - settings.localPlayer);
+    }
+
+    peerAck = std::clamp(packet.ackTick, peerAck, localInputEnd);
+    if (packet.checkedTick > peerCheckedTick) {
+        peerCheckedTick = packet.checkedTick;
+        peerCheckedHash = packet.checkedHash;
+        CheckPeerHash();
+    }
+
+    // Inputs are accepted in tick order only; older ones are duplicates, later ones follow a lost packet
+    const std::uint8_t* inputs = data + sizeof(packet);
+    for (std::uint32_t i = 0; i < packet.inputCount; ++i) {
+        const std::uint32_t tick = packet.startTick + i;
+        if (tick < remoteInputEnd) continue;
+        if (tick > remoteInputEnd || tick >= currentTick + NetConfig::INPUT_HISTORY / 2) break;
+        remoteInputs[tick & INPUT_MASK] = inputs[i];
+        ++remoteInputEnd;
+        if (tick < currentTick && usedRemote[tick & INPUT_MASK] != inputs[i]) {
+            rollbackTick = std::min(rollbackTick, tick);
+        }
+    }
+}
+
+void RollbackSession::Rollback() {
+    if (rollbackTick >= currentTick) {
+        rollbackTick = NO_ROLLBACK;
+        return;
+    }
+    PROFILE_ZONE("Rollback");
+    const auto start = std::chrono::steady_clock::now();
+    const std::uint32_t endTick = currentTick;
+    const std::uint32_t count = endTick - rollbackTick;
+
+    // Return to the state before the first mispredicted tick and simulate forward with the corrected input
+    level->RestoreWorldState(states[rollbackTick % STATE_COUNT]);
+    currentTick = rollbackTick;
+    rollbackTick = NO_ROLLBACK;
+    SimulateTick();
+    while (currentTick < endTick) {
+        SaveState();
+        SimulateTick();
+    }
+
+    const float elapsedMs =
+        std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    PROFILE_COUNT(RollbackTicks, count);
+    ++rollbacks;
+    resimulatedTicks += count;
+    longestRollback = std::max(longestRollback, count);
+    slowestRollbackMs = std::max(slowestRollbackMs, elapsedMs);
+    if (elapsedMs > NetConfig::ROLLBACK_BUDGET_MS) {
+        TraceLog(LOG_WARNING, "Net: rollback of %u ticks took %.2f ms (budget %.2f ms)", count, elapsedMs,
+                 NetConfig::ROLLBACK_BUDGET_MS);
+    }
+}
+
+void RollbackSession::SaveState() {
+    level->SaveWorldState(states[currentTick % STATE_COUNT]);
+}
+
+void RollbackSession::SimulateTick() {
+    const std::size_t localPort = settings.localPlayer;
+    const std::size_t remotePort = 1 - localPort;
+    const std::uint32_t previous = currentTick - 1;
+    const std::uint8_t remote = PredictRemoteInput(currentTick);
+    usedRemote[currentTick & INPUT_MASK] = remote;
+    // the previous tick's buttons are the ones its state was simulated with, predicted or not
+    sources[localPort].SetTick(currentTick > 0 ? localInputs[previous & INPUT_MASK] : 0,
+                               localInputs[currentTick & INPUT_MASK]);
+    sources[remotePort].SetTick(currentTick > 0 ? usedRemote[previous & INPUT_MASK] : 0, remote);
+    level->Step(DeterminismConfig::FIXED_TIME_STEP);
+    ++currentTick;
+}
+
+std::uint8_t RollbackSession::PredictRemoteInput(std::uint32_t tick) const noexcept {
+    if (tick < remoteInputEnd) return remoteInputs[tick & INPUT_MASK];
+    // the remote player most likely still holds what they held last
+    return remoteInputEnd > 0 ? remoteInputs[(remoteInputEnd - 1) & INPUT_MASK] : 0;
+}
+
+void RollbackSession::FinalizeTicks() {
+    // States after ticks before currentTick are saved (as the states before the next tick);
+    // ticks with both inputs confirmed will not be simulated again
+    const std::uint32_t end = std::min(currentTick, remoteInputEnd);
+    for (; finalTickEnd < end; ++finalTickEnd) {
+        const std::uint64_t hash = HashWorldState(states[(finalTickEnd + 1) % STATE_COUNT]);
+        finalHashes[finalTickEnd & INPUT_MASK] = hash;
+        if (checksums != nullptr) {
+            checksums->Record(hash);
+        }
+    }
+    CheckPeerHash();
+}
+
+void RollbackSession::CheckPeerHash() {
+    if (peerCheckedTick == 0 || peerCheckedTick > finalTickEnd) return;
+    const std::uint32_t tick = peerCheckedTick - 1;
+    if (finalTickEnd - tick <= NetConfig::INPUT_HISTORY && !desynced &&
+        finalHashes[tick & INPUT_MASK] != peerCheckedHash) {
+        desynced = true;
+        TraceLog(LOG_ERROR, "Net: DESYNC at tick %u (local %016" PRIx64 ", peer %016" PRIx64 ")", tick + 1,
+                 finalHashes[tick & INPUT_MASK], peerCheckedHash);
+    }
+    peerCheckedTick = 0;
+}
+
+void RollbackSession::SendHello(double now) {
+    if (now - lastHelloTime < NetConfig::HELLO_INTERVAL) return;
+    lastHelloTime = now;
+    NetProtocol::HelloPacket hello{MakeHeader(NetProtocol::PacketType::Hello, settings.localPlayer), seed, levelIndex};
+    shim.Send(socket, settings.peer, &hello, sizeof(hello), now);
+    ++packetsSent;
+}
+
+void RollbackSession::SendInputs(double now) {
+    std::array<std::uint8_t, NetConfig::MAX_PACKET_SIZE> buffer;
+    NetProtocol::InputPacket packet{};
+    packet.header = MakeHeader(NetProtocol::PacketType::Input, settings.localPlayer);
+    packet.startTick = peerAck;
+    packet.ackTick = remoteInputEnd;
+    packet.checkedTick = finalTickEnd;
+    packet.checkedHash = finalTickEnd > 0 ? finalHashes[(finalTickEnd - 1) & INPUT_MASK] : 0;
+    packet.inputCount = static_cast<std::uint8_t>(
+        std::min<std::size_t>(localInputEnd - peerAck, NetConfig::MAX_INPUTS_PER_PACKET));
+    std::memcpy(buffer.data(), &packet, sizeof(packet));
+    for (std::uint32_t i = 0; i < packet.inputCount; ++i) {
+        buffer[sizeof(packet) + i] = localInputs[(peerAck + i) & INPUT_MASK];
+    }
+    shim.Send(socket, settings.peer, buffer.data(), sizeof(packet) + packet.inputCount, now);
+    ++packetsSent;
+}
+
+void RollbackSession::LogStats() const {
+    TraceLog(LOG_INFO, "Net: %u ticks (%u final), %" PRIu64 " rollbacks resimulating %" PRIu64
+             " ticks (longest %u, slowest %.2f ms), %" PRIu64 " stalled frames",
+             currentTick, finalTickEnd, rollbacks, resimulatedTicks, longestRollback, slowestRollbackMs,
+             stalledFrames);
+    TraceLog(LOG_INFO, "Net: %" PRIu64 " packets sent, %" PRIu64 " received, %" PRIu64 " dropped by the shim",
+             packetsSent, packetsReceived, shim.GetDroppedCount());
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "config.hpp"
+#include "latency_shim.h"
+#include "net_input_source.h"
+#include "udp_socket.h"
+#include "world_state.h"
+
+class GameLevel;
+class StateChecksumLog;
+
+/**
+ * @brief Two-player rollback netplay over UDP (GGPO-style).
+ *
+ * Each peer simulates both players every tick. The local player's input is applied
+ * INPUT_DELAY_TICKS late, which hides that much latency completely; the remote player's
+ * input is predicted (the last input received is assumed to still be held) when it has
+ * not arrived yet. When the real input arrives and differs from the prediction, the
+ * level is restored to the state saved before the first mispredicted tick and the ticks
+ * up to the present are simulated again with the corrected input, all within one frame.
+ *
+ * This relies on the deterministic simulation: both peers run the fixed time step on a
+ * level with the same seed, so the same input history yields the same state. Ticks whose
+ * input is confirmed for both players are final; their state hashes are exchanged, and a
+ * difference is reported as a desync. A peer that runs more than MAX_PREDICTION_TICKS
+ * ahead of the other's input waits (stalls) for it, which also keeps the two clocks in step.
+ */
+class RollbackSession {
+public:
+    /// Connection state.
+    enum class Status { Connecting, Running, Disconnected };
+
+    /// Session parameters.
+    struct Settings {
+        std::size_t localPlayer = 0; /**< Player slot controlled here (0 or 1). */
+        std::uint16_t localPort = NetConfig::DEFAULT_PORT;
+        NetAddress peer;             /**< Address of the other player's process. */
+        LatencyShim::Settings shim;  /**< Simulated link conditions for testing. */
+    };
+
+    RollbackSession() = default;
+    ~RollbackSession();
+    RollbackSession(const RollbackSession&) = delete;
+    RollbackSession& operator=(const RollbackSession&) = delete;
+
+    /**
+     * @brief Open the socket and install the players' input sources on the level.
+     *
+     * The level must have two players and must not have been simulated yet.
+     *
+     * @param levelIndex Index into GameConfig::LEVELS; both peers must use the same level and seed.
+     * @param now Current time in seconds (the clock AdvanceFrame is called with).
+     * @return false when the level has no second player or the socket could not be opened.
+     */
+    bool Start(GameLevel& level, const Settings& settings, std::size_t levelIndex, double now);
+
+    /**
+     * @brief Remove the input sources and close the socket.
+     */
+    void Stop();
+
+    /**
+     * @brief Exchange packets and simulate the next tick when possible (once per fixed step).
+     *
+     * @param localButtons Held buttons of the local player (NetInputSource::Buttons).
+     * @param now Current time in seconds.
+     * @return true when a tick was simulated; false while connecting or stalled.
+     */
+    bool AdvanceFrame(std::uint8_t localButtons, double now);
+
+    /**
+     * @brief Write the state hash of every final tick to a log (nullptr to stop).
+     *
+     * Only final ticks are logged, so the logs of both peers must be identical.
+     */
+    void SetChecksumLog(StateChecksumLog* log) noexcept { checksums = log; }
+
+    Status GetStatus() const noexcept { return status; }
+    bool HasDesynced() const noexcept { return desynced; }
+
+    /** @brief Ticks simulated for the first time. */
+    std::uint32_t GetTickCount() const noexcept { return currentTick; }
+
+    /** @brief Ticks whose input is confirmed for both players. */
+    std::uint32_t GetFinalTickCount() const noexcept { return finalTickEnd; }
+
+    /**
+     * @brief Log rollback, stall and packet statistics.
+     */
+    void LogStats() const;
+
+private:
+    static constexpr std::size_t INPUT_MASK = NetConfig::INPUT_HISTORY - 1;
+    static constexpr std::size_t STATE_COUNT = NetConfig::MAX_PREDICTION_TICKS + 2;
+    static constexpr std::uint32_t NO_ROLLBACK = 0xFFFFFFFFu;
+
+    void ReceivePackets(double now);
+    void HandleHello(const std::uint8_t* data, std::size_t size, double now);
+    void HandleInput(const std::uint8_t* data, std::size_t size, double now);
+    void Rollback();
+    void SaveState();
+    void SimulateTick();
+    void FinalizeTicks();
+    void CheckPeerHash();
+    std::uint8_t PredictRemoteInput(std::uint32_t tick) const noexcept;
+    void SendHello(double now);
+    void SendInputs(double now);
+
+    GameLevel* level = nullptr;
+    Settings settings;
+    std::uint32_t seed = 0;
+    std::uint16_t levelIndex = 0;
+    UdpSocket socket;
+    LatencyShim shim;
+    std::array<NetInputSource, PlayerConfig::MAX_PLAYERS> sources;
+    StateChecksumLog* checksums = nullptr;
+    Status status = Status::Connecting;
+
+    // input history rings, indexed by tick & INPUT_MASK
+    std::array<std::uint8_t, NetConfig::INPUT_HISTORY> localInputs{};
+    std::array<std::uint8_t, NetConfig::INPUT_HISTORY> remoteInputs{};
+    std::array<std::uint8_t, NetConfig::INPUT_HISTORY> usedRemote{}; /**< Remote input each tick was simulated with. */
+    std::array<std::uint64_t, NetConfig::INPUT_HISTORY> finalHashes{};
+    // states[t % STATE_COUNT] holds the level state before tick t
+    std::array<WorldState, STATE_COUNT> states;
+
+    std::uint32_t currentTick = 0;    /**< Next tick to simulate. */
+    std::uint32_t localInputEnd = 0;  /**< Local inputs are known for ticks before this one. */
+    std::uint32_t remoteInputEnd = 0; /**< Remote inputs are known for ticks before this one. */
+    std::uint32_t peerAck = 0;        /**< The peer has our inputs for ticks before this one. */
+    std::uint32_t rollbackTick = NO_ROLLBACK; /**< First mispredicted tick. */
+    std::uint32_t finalTickEnd = 0;   /**< Ticks before this one are final and hashed. */
+    std::uint32_t peerCheckedTick = 0; /**< Newest final tick of the peer plus one; 0 when none is pending. */
+    std::uint64_t peerCheckedHash = 0;
+    bool desynced = false;
+
+    double startTime = 0.0;
+    double lastReceiveTime = 0.0;
+    double lastHelloTime = 0.0;
+
+    // statistics
+    std::uint64_t rollbacks = 0;
+    std::uint64_t resimulatedTicks = 0;
+    std::uint32_t longestRollback = 0;
+    float slowestRollbackMs = 0.0f;
+    std::uint64_t stalledFrames = 0;
+    std::uint64_t packetsSent = 0;
+    std::uint64_t packetsReceived = 0;
+};
@@ -0,0 +1,160 @@
+#include "udp_socket.h"
+#include <charconv>
+#include <type_traits>
+
+#if defined(_WIN32)
+/* keep windows.h from declaring names raylib also uses (Rectangle, CloseWindow, DrawText, ...) */
+#define WIN32_LEAN_AND_MEAN
+#define NOGDI
+#define NOUSER
+#define NOMINMAX
+#include <winsock2.h>
+#include <ws2tcpip.h>
+using SocketLength = int;
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+using SocketLength = socklen_t;
+#endif
+#include "raylib.h"
+
+namespace {
+#if defined(_WIN32)
+using NativeSocket = SOCKET;
+
+bool StartNetworking() {
+    static const bool started = [] {
+        WSADATA data;
+        return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+    }();
+    return started;
+}
+
+int LastError() { return WSAGetLastError(); }
+bool WouldBlock(int error) { return error == WSAEWOULDBLOCK; }
+// an ICMP "port unreachable" for an earlier send (peer not started yet)
+bool IsRefused(int error) { return error == WSAECONNRESET; }
+void CloseNative(NativeSocket socket) { closesocket(socket); }
+bool MakeNonBlocking(NativeSocket socket) {
+    u_long enabled = 1;
+    return ioctlsocket(socket, FIONBIO, &enabled) == 0;
+}
+#else
+using NativeSocket = int;
+
+bool StartNetworking() { return true; }
+int LastError() { return errno; }
+bool WouldBlock(int error) { return error == EAGAIN || error == EWOULDBLOCK; }
+bool IsRefused(int error) { return error == ECONNREFUSED; }
+void CloseNative(NativeSocket socket) { close(socket); }
+bool MakeNonBlocking(NativeSocket socket) {
+    const int flags = fcntl(socket, F_GETFL, 0);
+    return flags >= 0 && fcntl(socket, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+#endif
+
+sockaddr_in ToNative(const NetAddress& address) {
+    sockaddr_in native{};
+    native.sin_family = AF_INET;
+    native.sin_addr.s_addr = htonl(address.ip);
+    native.sin_port = htons(address.port);
+    return native;
+}
+}  // namespace
+
+bool NetAddress::Parse(std::string_view text, NetAddress& out) {
+    NetAddress parsed;
+    const std::size_t colon = text.rfind(':');
+    if (colon != std::string_view::npos) {
+        // dotted quad before the colon
+        std::uint32_t ip = 0;
+        std::string_view host = text.substr(0, colon);
+        for (int part = 0; part < 4; ++part) {
+            unsigned value = 0;
+            const auto [end, error] = std::from_chars(host.data(), host.data() + host.size(), value);
+            if (error != std::errc{} || value > 255) return false;
+            ip = (ip << 8) | value;
+            host.remove_prefix(static_cast<std::size_t>(end - host.data()));
+            if (part < 3) {
+                if (host.empty() || host.front() != '.') return false;
+                host.remove_prefix(1);
+            }
+        }
+        if (!host.empty()) return false;
+        parsed.ip = ip;
+        text.remove_prefix(colon + 1);
+    }
+    unsigned port = 0;
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), port);
+    if (error != std::errc{} || end != text.data() + text.size() || port == 0 || port > 0xFFFF) return false;
+    parsed.port = static_cast<std::uint16_t>(port);
+    out = parsed;
+    return true;
+}
+
+UdpSocket::~UdpSocket() {
+    Close();
+}
+
+bool UdpSocket::Open(std::uint16_t port) {
+    Close();
+    if (!StartNetworking()) {
+        TraceLog(LOG_ERROR, "Net: networking is not available");
+        return false;
+    }
+    const NativeSocket native = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (native == static_cast<NativeSocket>(INVALID)) {
+        TraceLog(LOG_ERROR, "Net: cannot create UDP socket (error %d)", LastError());
+        return false;
+    }
+    sockaddr_in local{};
+    local.sin_family = AF_INET;
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    local.sin_port = htons(port);
+    if (bind(native, reinterpret_cast<const sockaddr*>(&local), sizeof(local)) != 0 || !MakeNonBlocking(native)) {
+        TraceLog(LOG_ERROR, "Net: cannot bind UDP port %u (error %d)", static_cast<unsigned>(port), LastError());
+        CloseNative(native);
+        return false;
+    }
+    handle = static_cast<std::intptr_t>(native);
+    return true;
+}
+
+void UdpSocket::Close() {
+    if (handle != INVALID) {
+        CloseNative(static_cast<NativeSocket>(handle));
+        handle = INVALID;
+    }
+}
+
+bool UdpSocket::Send(const NetAddress& to, const void* data, std::size_t size) {
+    if (handle == INVALID) return false;
+    const sockaddr_in remote = ToNative(to);
+    const auto sent = sendto(static_cast<NativeSocket>(handle), static_cast<const char*>(data),
+                             static_cast<int>(size), 0, reinterpret_cast<const sockaddr*>(&remote), sizeof(remote));
+    return sent == static_cast<std::remove_cv_t<decltype(sent)>>(size);
+}
+
+std::size_t UdpSocket::Receive(void* buffer, std::size_t capacity, NetAddress& from) {
+    if (handle == INVALID) return 0;
+    for (;;) {
+        sockaddr_in remote{};
+        SocketLength length = sizeof(remote);
+        const auto received = recvfrom(static_cast<NativeSocket>(handle), static_cast<char*>(buffer),
+                                       static_cast<int>(capacity), 0, reinterpret_cast<sockaddr*>(&remote), &length);
+        if (received >= 0) {
+            from.ip = ntohl(remote.sin_addr.s_addr);
+            from.port = ntohs(remote.sin_port);
+            return static_cast<std::size_t>(received);
+        }
+        const int error = LastError();
+        if (WouldBlock(error)) return 0;
+        if (IsRefused(error)) continue;
+        TraceLog(LOG_WARNING, "Net: receive failed (error %d)", error);
+        return 0;
+    }
+}
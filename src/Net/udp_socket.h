@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @brief IPv4 address and port in host byte order.
+ */
+struct NetAddress {
+    static constexpr std::uint32_t LOOPBACK = 0x7F000001u; /**< 127.0.0.1 */
+
+    std::uint32_t ip = LOOPBACK;
+    std::uint16_t port = 0;
+
+    /**
+     * @brief Parse "a.b.c.d:port" or a bare port (loopback).
+     *
+     * @return false when the text is not a valid address.
+     */
+    static bool Parse(std::string_view text, NetAddress& out);
+
+    friend bool operator==(const NetAddress&, const NetAddress&) = default;
+};
+
+/**
+ * @brief Non-blocking UDP socket.
+ *
+ * Thin wrapper over BSD sockets / Winsock: Receive never waits and returns 0 when no
+ * datagram is pending, so the game loop can poll it once per frame.
+ */
+class UdpSocket {
+public:
+    UdpSocket() = default;
+    ~UdpSocket();
+    UdpSocket(const UdpSocket&) = delete;
+    UdpSocket& operator=(const UdpSocket&) = delete;
+
+    /**
+     * @brief Open a socket bound to the given local port on all interfaces.
+     *
+     * @return true when the socket is ready.
+     */
+    bool Open(std::uint16_t port);
+
+    /** @brief Close the socket (no-op when closed). */
+    void Close();
+
+    bool IsOpen() const noexcept { return handle != INVALID; }
+
+    /**
+     * @brief Send one datagram.
+     *
+     * @return false when the datagram could not be handed to the network stack.
+     */
+    bool Send(const NetAddress& to, const void* data, std::size_t size);
+
+    /**
+     * @brief Receive one pending datagram.
+     *
+     * @param buffer Destination; longer datagrams are truncated.
+     * @param capacity Size of buffer.
+     * @param from Receives the sender address.
+     * @return Size of the datagram, 0 when none is pending.
+     */
+    std::size_t Receive(void* buffer, std::size_t capacity, NetAddress& from);
+
+private:
+    // socket handle as an integer (SOCKET on Windows, a file descriptor elsewhere)
+    static constexpr std::intptr_t INVALID = -1;
+    std::intptr_t handle = INVALID;
+};
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "types.h"
+#include "raylib.h"
+#include <cstddef>
+#include <cstdint>
 #include <string_view>
 #include <array>
 
@@ -22,11 +25,36 @@ namespace GameConfig {
     inline constexpr std::string_view PLAYER_OBJECT_NAME = "Player";
     inline constexpr std::string_view ZOMBIE_OBJECT_NAME = "Zombie";
     inline constexpr std::string_view GAME_OVER_TEXT = "GAME OVER";
+    inline constexpr float GAME_OVER_DELAY = 1.5f; // seconds the game over message is shown before the level ends
+}
+
+namespace CollisionConfig {
+    // Layer bits of the actors; a collision listener only tests actors on layers in its mask
+    inline constexpr std::uint32_t LAYER_DEFAULT = 1u << 0;   // actors that set no filter
+    inline constexpr std::uint32_t LAYER_PLAYER = 1u << 1;
+    inline constexpr std::uint32_t LAYER_ENEMY = 1u << 2;
+    inline constexpr std::uint32_t PLAYER_MASK = LAYER_ENEMY;  // players are hurt by enemies
+    inline constexpr std::uint32_t ENEMY_MASK = LAYER_PLAYER;  // enemies never test each other
+}
+
+namespace TriggerConfig {
+    // Object layer holding the trigger volumes; the object class (or its name) selects the kind
+    inline constexpr std::string_view LAYER_NAME = "triggers";
+    inline constexpr std::string_view EXIT_TYPE = "Exit";
+    inline constexpr std::string_view DAMAGE_TYPE = "Damage";
+    inline constexpr std::string_view CHECKPOINT_TYPE = "Checkpoint";
+    // int property overriding the collision layers a volume reacts to
+    inline constexpr std::string_view MASK_PROPERTY = "mask";
+    inline constexpr std::uint32_t DEFAULT_MASK = CollisionConfig::LAYER_PLAYER;
 }
 
 namespace MoveConfig {
     inline constexpr int VERTICAL_SNAP_TOLERANCE = 4;
     inline constexpr float GRAVITY_CONSTANT = 800.0f; // pixels per second squared
+    inline constexpr bool SIMD_INTEGRATION = true;    // batch-integrate bodies with SSE2/AVX2 when the CPU supports it
+    // integrate positions and vertical velocity in 16.16 fixed point (bit-exact across compilers and SIMD paths);
+    // levels refuse maps larger than Fixed::MAX_INT pixels
+    inline constexpr bool FIXED_POINT_PHYSICS = false;
     // Foot sensor shape and grounding hysteresis
     inline constexpr float FOOT_SENSOR_WIDTH_RATIO = 0.6f;   // 0.2..1.0; narrower avoids edge flicker
     inline constexpr float FOOT_SENSOR_HEIGHT = 2.0f;        // thin strip below feet
@@ -45,6 +73,8 @@ namespace PlayerConfig {
     inline constexpr GameTypes::AnimationData WALK_ANIM { "sprites/player_walk.png", 2, 0.2f, 2.0f, 0.0f };
     inline constexpr GameTypes::AnimationData JUMP_ANIM { "sprites/player_jump.png", 1, 0.1f, 3.0f, 0.0f };
     inline constexpr GameTypes::AnimationData FALL_ANIM { "sprites/player_fall.png", 1, 0.1f, 5.0f, 0.0f };
+    inline constexpr std::size_t MAX_PLAYERS = 2;        // player slots per level (co-op); slot 0 is the local default
+    inline constexpr float CO_OP_SPAWN_OFFSET_X = 48.0f; // further players spawn this far right of the previous one
     inline constexpr bool CAN_DOUBLE_JUMP = true;  // If true, grant exactly one extra jump while airborne (total 2 jumps)
     inline constexpr float DEATH_FADE_DURATION = 0.8f; // seconds
     inline constexpr float DAMAGE_STATE_DURATION = 1.0f; // seconds player is in "taking damage" state
@@ -77,4 +107,147 @@ namespace EnemyConfig {
     inline constexpr float COLLIDER_HEIGHT = 72.0f;
     inline constexpr float COLLIDER_OFFSET_X = 2.0f;
     inline constexpr float COLLIDER_OFFSET_Y = 0.0f;
-}
\ No newline at end of file
+
+    inline constexpr float PATROL_WAIT_TIME = 0.6f;  // seconds a patrolling zombie waits at a ledge or wall before turning
+
+    // Chasing: zombies that see the player walk towards it
+    inline constexpr float SIGHT_RANGE = 320.0f;     // pixels; horizontal and vertical reach of the eyes
+    inline constexpr float CHASE_SPEED = 110.0f;     // pixels per second while chasing
+    inline constexpr float CHASE_DEAD_ZONE = 8.0f;   // pixels; closer than this horizontally the direction is kept
+    inline constexpr float JUMP_STRENGTH = PlayerConfig::DEFAULT_JUMP_STRENGTH; // used to follow jump edges
+}
+
+namespace NavConfig {
+    inline constexpr std::size_t PATH_CACHE_MAX_SPANS = 1024; // larger graphs run A* on every query
+    inline constexpr float JUMP_EDGE_PENALTY = 64.0f;         // pixels added to the cost of a jump
+    inline constexpr float TAKEOFF_TOLERANCE = 8.0f;          // pixels from the takeoff column centre that start a jump
+}
+
+namespace LineOfSightConfig {
+    inline constexpr std::size_t CACHE_ENTRIES = 4096; // cell-pair answers shared by all enemies of a level
+}
+
+namespace AnimationConfig {
+    inline constexpr std::size_t MAX_CLIPS = 64; // distinct animation clips shared by all worlds
+}
+
+namespace JobConfig {
+    inline constexpr std::size_t WORKER_THREADS = 0; // job threads incl. the main thread; 0 = hardware concurrency - 1
+    inline constexpr std::size_t MAX_WORKER_THREADS = 16;
+    inline constexpr std::size_t ACTOR_CHUNK_SIZE = 64;      // actors per job in parallel update phases
+    inline constexpr std::size_t COLLISION_CHUNK_SIZE = 256; // candidates per job in collision tests
+    inline constexpr std::size_t PATROL_CHUNK_SIZE = 1024;   // patrol slots per job in the batched patrol pass
+}
+
+namespace TickConfig {
+    // Per-group update rates (runs per second; 0 = every frame), frame phase offsets and per-frame member caps
+    // (0 = no cap). Members of a slow group are spread evenly over the frames of its period.
+    inline constexpr float SENSOR_RATE = 30.0f;
+    inline constexpr std::uint32_t SENSOR_PHASE = 0;
+    inline constexpr std::uint32_t SENSOR_MAX_PER_FRAME = 0;
+    inline constexpr float ANIMATION_RATE = 15.0f;
+    inline constexpr std::uint32_t ANIMATION_PHASE = 1;
+    inline constexpr std::uint32_t ANIMATION_MAX_PER_FRAME = 0;
+    inline constexpr float AI_RATE = 10.0f;
+    inline constexpr std::uint32_t AI_PHASE = 2;
+    inline constexpr std::uint32_t AI_MAX_PER_FRAME = 256; // bounds per-frame AI cost for large enemy counts
+}
+
+namespace ActionConfig {
+    inline constexpr std::size_t ACTION_RESERVE = 64; // simultaneous actions supported without allocation
+}
+
+namespace RewindConfig {
+    inline constexpr int REWIND_KEY = KEY_BACKSPACE;            // hold to scrub the simulation backwards
+    inline constexpr std::size_t MAX_TICKS = 600;               // ~10 seconds at 60 ticks per second
+    inline constexpr std::size_t MEMORY_BUDGET_BYTES = 8u << 20; // hard cap for the snapshot ring buffer
+    inline constexpr std::uint64_t KEYFRAME_INTERVAL = 30;      // ticks between full snapshots
+    inline constexpr float CAPTURE_BUDGET_MICROS = 50.0f;       // warn when a capture exceeds this
+}
+
+namespace DeterminismConfig {
+    inline constexpr std::uint32_t DEFAULT_SEED = 0x5EED2024u;             // --deterministic without --seed
+    inline constexpr float FIXED_TIME_STEP = 1.0f / Config::TARGET_FPS;   // seconds per simulation tick
+    inline constexpr int MAX_CATCHUP_TICKS = 4;                            // ticks per rendered frame before dropping time
+}
+
+namespace NetConfig {
+    inline constexpr std::uint32_t PROTOCOL_MAGIC = 0x54454E47u;   // "GNET"
+    inline constexpr std::uint16_t PROTOCOL_VERSION = 1;
+    inline constexpr std::uint16_t DEFAULT_PORT = 7000;            // first player's port; the second uses the next one
+    inline constexpr int INPUT_DELAY_TICKS = 2;                    // local input is applied this many ticks late
+    inline constexpr int MAX_PREDICTION_TICKS = 8;                 // ticks simulated ahead of the remote input; also the longest rollback
+    inline constexpr std::size_t INPUT_HISTORY = 128;              // ticks of input kept per player (power of two)
+    inline constexpr std::size_t MAX_INPUTS_PER_PACKET = 64;       // unacknowledged inputs resent in every packet
+    inline constexpr std::size_t MAX_PACKET_SIZE = 256;
+    inline constexpr float HELLO_INTERVAL = 0.1f;                  // seconds between handshake packets
+    inline constexpr float DISCONNECT_TIMEOUT = 5.0f;              // seconds without a packet before the peer is given up
+    inline constexpr float CONNECT_TIMEOUT = 30.0f;                // seconds to wait for the peer to start
+    inline constexpr std::size_t SHIM_QUEUE_SIZE = 256;            // packets held back by the latency shim
+    inline constexpr float ROLLBACK_BUDGET_MS = 1000.0f / Config::TARGET_FPS * 0.5f; // warn when resimulation takes longer
+    static_assert((INPUT_HISTORY & (INPUT_HISTORY - 1)) == 0, "NetConfig::INPUT_HISTORY must be a power of two");
+    static_assert(INPUT_HISTORY > MAX_INPUTS_PER_PACKET + MAX_PREDICTION_TICKS + INPUT_DELAY_TICKS,
+                  "NetConfig::INPUT_HISTORY must cover the resend window");
+}
+
+namespace AutoplayConfig {
+    inline constexpr std::uint32_t MIN_HOLD_TICKS = 10;            // --autoplay holds each random input for 10..39 ticks
+    inline constexpr std::uint32_t HOLD_RANGE_TICKS = 30;
+}
+
+namespace SoakConfig {
+    inline constexpr std::uint64_t DEFAULT_TICKS = 36000;          // ticks per run without --ticks (10 simulated minutes)
+    inline constexpr std::uint64_t SAMPLE_INTERVAL_TICKS = 600;    // ticks between resource samples of a run
+    inline constexpr std::size_t WARMUP_SAMPLES = 2;               // first samples of a run ignored by the trend check (caches filling)
+    inline constexpr std::size_t MIN_TREND_SAMPLES = 4;            // shorter runs are reported but not judged
+    inline constexpr std::string_view DEFAULT_DIR = "soak";        // per-run sample files and logs
+    // A metric trends upward when the growth of its least-squares fit over the run exceeds
+    // max(absolute limit, ratio * fitted start value)
+    inline constexpr double FRAME_TIME_GROWTH_MS = 0.5;
+    inline constexpr double FRAME_TIME_GROWTH_RATIO = 0.5;
+    inline constexpr double RSS_GROWTH_BYTES = 4.0 * 1024 * 1024;
+    inline constexpr double RSS_GROWTH_RATIO = 0.1;
+    inline constexpr double ACTION_GROWTH = 8.0;                   // actions come and go with gameplay
+    inline constexpr double ACTION_GROWTH_RATIO = 0.5;
+    inline constexpr double LISTENER_GROWTH = 0.5;                 // listeners and cached textures must not grow at all
+}
+
+namespace BenchmarkConfig {
+    /// A named benchmark scene: a level plus zombies spawned on its walkable spans.
+    struct Scene {
+        std::string_view name;
+        std::size_t levelIndex;    // index into GameConfig::LEVELS
+        std::size_t extraZombies;  // in addition to the map's own actors
+    };
+    inline constexpr std::array SCENES {
+        Scene{"lvl_0", 0, 0},
+        Scene{"zombies_1k", 0, 1000},
+        Scene{"zombies_10k", 0, 10000},
+        Scene{"lvl_1", 1, 0},
+    };
+    inline constexpr std::uint64_t WARMUP_TICKS = 120;             // ticks simulated before measuring (caches, pools)
+    inline constexpr std::uint64_t DEFAULT_TICKS = 1800;           // measured ticks per scene without --ticks
+    inline constexpr std::string_view SWEEP_NAME = "sweep";        // --benchmark=sweep: scaling curve over actor counts
+    inline constexpr std::size_t SWEEP_LEVEL = 0;
+    inline constexpr std::array<std::size_t, 8> SWEEP_ZOMBIES {0, 100, 250, 500, 1000, 2500, 5000, 10000};
+    inline constexpr std::uint64_t SWEEP_TICKS = 600;              // measured ticks per sweep point without --ticks
+    inline constexpr float HITCH_BUDGET_MS = 1000.0f;              // no hitch reports while benchmarking
+}
+
+namespace AllocConfig {
+    // frames after start-up before --strict-alloc starts asserting (lazy loads, pool and buffer warm-up)
+    inline constexpr std::uint64_t STEADY_STATE_WARMUP_FRAMES = 120;
+}
+
+namespace ProfilerConfig {
+    inline constexpr int OVERLAY_KEY = KEY_F3;                  // toggle the profiler overlay
+    inline constexpr int TRACE_KEY = KEY_F4;                    // capture a Chrome trace of the next frames
+    inline constexpr std::size_t TRACE_FRAMES = 300;            // frames per trace capture (~5 s)
+    inline constexpr std::string_view TRACE_FILE = "profile_trace.json"; // written to the working directory
+    inline constexpr std::size_t HISTORY_FRAMES = 120;          // frames kept for the overlay graphs
+    inline constexpr std::size_t STATS_FRAMES = 600;            // frames covered by the p50/p95/p99/max statistics
+    inline constexpr float HITCH_BUDGET_MS = 25.0f;             // frames longer than this are reported as hitches
+    inline constexpr std::size_t HITCH_CONTEXT_FRAMES = 30;     // frames (including the hitch) written per report
+    inline constexpr std::size_t MAX_HITCH_REPORTS = 20;        // stop writing reports after this many
+    inline constexpr std::string_view HITCH_REPORT_PREFIX = "hitch_"; // reports: <prefix><frame>.txt
+}
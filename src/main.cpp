@@ -1,5 +1,4 @@
 #include "raylib.h"
-#define RAYTMX_IMPLEMENTATION
 #include "raytmx.h"
 #include "config.hpp"
 #include "player.h"
@@ -8,6 +7,325 @@
 #include "asset_manager.h"
 #include "enemy.h"
 #include "texture_manager.h"
+#include "map_manager.h"
+#include "time_rewind.h"
+#include "input_recorder.h"
+#include "input_replay.h"
+#include "profiler.h"
+#include "alloc_tracker.h"
+#include "latched_input.h"
+#include "render_state.h"
+#include "state_checksum_log.h"
+#include "triple_buffer.h"
+#include "rollback_session.h"
+#include "autoplay_input.h"
+#include "soak_monitor.h"
+#include "soak_runner.h"
+#include "benchmark_runner.h"
+#include "job_system.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+/**
+ * @brief Command line options.
+ *
+ * --record=<file>  record per-tick input of this session
+ * --replay=<file>  drive the session from a recording and verify its final state
+ * --headless       no rendering and no frame cap (requires --replay, or --deterministic with --ticks)
+ * --hitch-budget=<ms>  frame time above which the profiler writes a hitch report
+ * --strict-alloc   assert on any heap allocation once the game reached steady state
+ * --pipelined      simulate the next frame on a separate thread while the current one renders
+ *                  (windowed sessions only: not with --replay, --net-player, --autoplay, --headless,
+ *                  --benchmark or --soak-report)
+ * --deterministic  fixed-step simulation clock and a fixed level seed (DeterminismConfig)
+ * --seed=<n>       level seed (default: random, or DeterminismConfig::DEFAULT_SEED when deterministic)
+ * --ticks=<n>      stop after n simulated ticks
+ * --state-hash=<file>          write the simulation state hash of every tick
+ * --state-hash-compare=<file>  compare every tick's state hash against such a file, report the first difference
+ * --integrator=<scalar|sse2|avx2>  body integration kernel (default: fastest supported); the paths are
+ *                  bit-identical, so state hashes of runs with different kernels must match
+ * --net-player=<1|2>   two-player rollback netplay as this player (implies --deterministic; both
+ *                  processes need the same --seed)
+ * --net-port=<port>    local UDP port (default: NetConfig::DEFAULT_PORT + player - 1)
+ * --net-peer=<[ip:]port>  the other player's address (default: 127.0.0.1 and the other player's default port)
+ * --net-latency=<ms> --net-jitter=<ms> --net-loss=<percent>  simulate a bad link on outgoing packets
+ *                  (with --state-hash only final ticks are logged, and the logs of both players must match)
+ * --autoplay       drive the (local) player with scripted random input seeded by the level seed
+ * --soak=<runs>    soak test: run this many headless sessions of --ticks ticks (default
+ *                  SoakConfig::DEFAULT_TICKS) in parallel processes with --autoplay and seeds --seed,
+ *                  --seed + 1, ... (or all with --replay), then flag runs whose resources trend upward
+ * --soak-jobs=<n>  processes running at the same time (default: one per hardware thread)
+ * --job-threads=<n>  threads of the job system including the main thread (default: JobConfig); a soak
+ *                  test passes hardware threads / --soak-jobs to every run unless given
+ * --soak-dir=<dir> per-run samples, logs and summary.csv (default: SoakConfig::DEFAULT_DIR)
+ * --soak-report=<file>  sample this session's frame time, memory, actions and listeners into a file;
+ *                  a game over or completed level restarts it instead of ending the run
+ * --benchmark=<scene>  time update, collision and render of a BenchmarkConfig::SCENES scene for --ticks
+ *                  ticks (default BenchmarkConfig::DEFAULT_TICKS) of autoplay and write percentiles as JSON;
+ *                  "sweep" writes a CSV of frame times over BenchmarkConfig::SWEEP_ZOMBIES instead.
+ *                  --seed and --integrator apply, --headless leaves out rendering
+ * --benchmark-out=<file>  report file (default: benchmark_<scene>.json or benchmark_sweep.csv)
+ * --worlds=<n>     headless: build and simulate n independent autoplay worlds (seeds --seed, --seed + 1,
+ *                  ...) on their own threads for --ticks ticks and log their final state hashes;
+ *                  only --seed and --integrator apply
+ */
+struct LaunchOptions {
+    std::filesystem::path recordPath;
+    std::filesystem::path replayPath;
+    bool headless = false;
+    float hitchBudgetMillis = ProfilerConfig::HITCH_BUDGET_MS;
+    bool strictAlloc = false;
+    bool pipelined = false;
+    bool deterministic = false;
+    bool hasSeed = false;
+    std::uint32_t seed = 0;
+    std::uint64_t tickLimit = 0; /**< 0 = unlimited */
+    std::filesystem::path stateHashPath;
+    std::filesystem::path stateHashComparePath;
+    bool hasIntegrationPath = false;
+    BodyIntegrator::Path integrationPath = BodyIntegrator::Path::Scalar;
+    std::size_t netPlayer = 0; /**< 1 or 2 in netplay, 0 otherwise */
+    std::uint16_t netPort = 0; /**< 0 = default for the player */
+    bool hasNetPeer = false;
+    NetAddress netPeer;
+    LatencyShim::Settings netShim;
+    bool autoplay = false;
+    std::size_t soakRuns = 0; /**< 0 = no soak test */
+    std::size_t soakJobs = 0;
+    std::size_t jobThreads = 0; /**< 0 = JobConfig default */
+    std::filesystem::path soakDir{SoakConfig::DEFAULT_DIR};
+    std::filesystem::path soakReportPath;
+    std::string benchmarkScene; /**< empty = no benchmark */
+    std::filesystem::path benchmarkPath;
+    std::size_t worlds = 0; /**< 0 = one world on the main thread */
+};
+
+LaunchOptions ParseOptions(int argc, char** argv) {
+    constexpr std::string_view RECORD_OPTION = "--record=";
+    constexpr std::string_view REPLAY_OPTION = "--replay=";
+    constexpr std::string_view HITCH_BUDGET_OPTION = "--hitch-budget=";
+    constexpr std::string_view SEED_OPTION = "--seed=";
+    constexpr std::string_view TICKS_OPTION = "--ticks=";
+    constexpr std::string_view STATE_HASH_OPTION = "--state-hash=";
+    constexpr std::string_view STATE_HASH_COMPARE_OPTION = "--state-hash-compare=";
+    constexpr std::string_view INTEGRATOR_OPTION = "--integrator=";
+    constexpr std::string_view NET_PLAYER_OPTION = "--net-player=";
+    constexpr std::string_view NET_PORT_OPTION = "--net-port=";
+    constexpr std::string_view NET_PEER_OPTION = "--net-peer=";
+    constexpr std::string_view NET_LATENCY_OPTION = "--net-latency=";
+    constexpr std::string_view NET_JITTER_OPTION = "--net-jitter=";
+    constexpr std::string_view NET_LOSS_OPTION = "--net-loss=";
+    constexpr std::string_view SOAK_OPTION = "--soak=";
+    constexpr std::string_view SOAK_JOBS_OPTION = "--soak-jobs=";
+    constexpr std::string_view JOB_THREADS_OPTION = "--job-threads=";
+    constexpr std::string_view SOAK_DIR_OPTION = "--soak-dir=";
+    constexpr std::string_view SOAK_REPORT_OPTION = "--soak-report=";
+    constexpr std::string_view BENCHMARK_OPTION = "--benchmark=";
+    constexpr std::string_view BENCHMARK_OUT_OPTION = "--benchmark-out=";
+    constexpr std::string_view WORLDS_OPTION = "--worlds=";
+    LaunchOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg{argv[i]};
+        if (arg.starts_with(RECORD_OPTION)) {
+            options.recordPath = arg.substr(RECORD_OPTION.size());
+        } else if (arg.starts_with(REPLAY_OPTION)) {
+            options.replayPath = arg.substr(REPLAY_OPTION.size());
+        } else if (arg.starts_with(HITCH_BUDGET_OPTION)) {
+            const float budget = std::strtof(argv[i] + HITCH_BUDGET_OPTION.size(), nullptr);
+            if (budget > 0.0f) {
+                options.hitchBudgetMillis = budget;
+            } else {
+                TraceLog(LOG_WARNING, "Ignoring invalid hitch budget: %s", argv[i]);
+            }
+        } else if (arg.starts_with(SEED_OPTION)) {
+            options.seed = static_cast<std::uint32_t>(std::strtoul(argv[i] + SEED_OPTION.size(), nullptr, 0));
+            options.hasSeed = true;
+        } else if (arg.starts_with(TICKS_OPTION)) {
+            options.tickLimit = std::strtoull(argv[i] + TICKS_OPTION.size(), nullptr, 10);
+        } else if (arg.starts_with(STATE_HASH_OPTION)) {
+            options.stateHashPath = arg.substr(STATE_HASH_OPTION.size());
+        } else if (arg.starts_with(STATE_HASH_COMPARE_OPTION)) {
+            options.stateHashComparePath = arg.substr(STATE_HASH_COMPARE_OPTION.size());
+        } else if (arg.starts_with(INTEGRATOR_OPTION)) {
+            const std::string_view name = arg.substr(INTEGRATOR_OPTION.size());
+            options.hasIntegrationPath = true;
+            if (name == "scalar") {
+                options.integrationPath = BodyIntegrator::Path::Scalar;
+            } else if (name == "sse2") {
+                options.integrationPath = BodyIntegrator::Path::SSE2;
+            } else if (name == "avx2") {
+                options.integrationPath = BodyIntegrator::Path::AVX2;
+            } else {
+                options.hasIntegrationPath = false;
+                TraceLog(LOG_WARNING, "Ignoring unknown integrator: %s", argv[i]);
+            }
+        } else if (arg.starts_with(NET_PLAYER_OPTION)) {
+            const unsigned long player = std::strtoul(argv[i] + NET_PLAYER_OPTION.size(), nullptr, 10);
+            if (player == 1 || player == 2) {
+                options.netPlayer = player;
+            } else {
+                TraceLog(LOG_WARNING, "Ignoring invalid net player: %s", argv[i]);
+            }
+        } else if (arg.starts_with(NET_PORT_OPTION)) {
+            NetAddress address;
+            if (NetAddress::Parse(arg.substr(NET_PORT_OPTION.size()), address)) {
+                options.netPort = address.port;
+            } else {
+                TraceLog(LOG_WARNING, "Ignoring invalid net port: %s", argv[i]);
+            }
+        } else if (arg.starts_with(NET_PEER_OPTION)) {
+            options.hasNetPeer = NetAddress::Parse(arg.substr(NET_PEER_OPTION.size()), options.netPeer);
+            if (!options.hasNetPeer) {
+                TraceLog(LOG_WARNING, "Ignoring invalid net peer: %s", argv[i]);
+            }
+        } else if (arg.starts_with(NET_LATENCY_OPTION)) {
+            options.netShim.latencyMs = std::max(0.0f, std::strtof(argv[i] + NET_LATENCY_OPTION.size(), nullptr));
+        } else if (arg.starts_with(NET_JITTER_OPTION)) {
+            options.netShim.jitterMs = std::max(0.0f, std::strtof(argv[i] + NET_JITTER_OPTION.size(), nullptr));
+        } else if (arg.starts_with(NET_LOSS_OPTION)) {
+            options.netShim.lossPercent = std::clamp(std::strtof(argv[i] + NET_LOSS_OPTION.size(), nullptr), 0.0f, 100.0f);
+        } else if (arg.starts_with(SOAK_OPTION)) {
+            options.soakRuns = std::strtoull(argv[i] + SOAK_OPTION.size(), nullptr, 10);
+        } else if (arg.starts_with(SOAK_JOBS_OPTION)) {
+            options.soakJobs = std::strtoull(argv[i] + SOAK_JOBS_OPTION.size(), nullptr, 10);
+        } else if (arg.starts_with(JOB_THREADS_OPTION)) {
+            options.jobThreads = std::strtoull(argv[i] + JOB_THREADS_OPTION.size(), nullptr, 10);
+        } else if (arg.starts_with(SOAK_DIR_OPTION)) {
+            options.soakDir = arg.substr(SOAK_DIR_OPTION.size());
+        } else if (arg.starts_with(SOAK_REPORT_OPTION)) {
+            options.soakReportPath = arg.substr(SOAK_REPORT_OPTION.size());
+        } else if (arg.starts_with(BENCHMARK_OPTION)) {
+            options.benchmarkScene = arg.substr(BENCHMARK_OPTION.size());
+        } else if (arg.starts_with(BENCHMARK_OUT_OPTION)) {
+            options.benchmarkPath = arg.substr(BENCHMARK_OUT_OPTION.size());
+        } else if (arg.starts_with(WORLDS_OPTION)) {
+            options.worlds = std::strtoull(argv[i] + WORLDS_OPTION.size(), nullptr, 10);
+        } else if (arg == "--autoplay") {
+            options.autoplay = true;
+        } else if (arg == "--deterministic") {
+            options.deterministic = true;
+        } else if (arg == "--strict-alloc") {
+            options.strictAlloc = true;
+        } else if (arg == "--pipelined") {
+            options.pipelined = true;
+        } else if (arg == "--headless") {
+            options.headless = true;
+        } else {
+            TraceLog(LOG_WARNING, "Unknown option: %s", argv[i]);
+        }
+    }
+    // rollback needs both processes to simulate the same ticks bit for bit
+    if (options.netPlayer != 0) {
+        options.deterministic = true;
+    }
+    return options;
+}
+
+/* Hash of the level's complete simulation state, used to verify replays; scratch is reused between calls */
+std::uint64_t HashLevelState(const GameLevel& level, WorldState& scratch) {
+    level.SaveWorldState(scratch);
+    return HashWorldState(scratch);
+}
+
+/* --soak: start the runs as child processes of this executable and judge their samples */
+int RunSoakTest(const LaunchOptions& options, int argc, char** argv) {
+    SoakRunner::Settings settings;
+    settings.executable = std::filesystem::canonical(argv[0]);
+    settings.runs = options.soakRuns;
+    settings.jobs = options.soakJobs;
+    settings.jobThreads = options.jobThreads;
+    settings.ticks = options.tickLimit > 0 ? options.tickLimit : SoakConfig::DEFAULT_TICKS;
+    settings.baseSeed = options.hasSeed ? options.seed : DeterminismConfig::DEFAULT_SEED;
+    settings.replayPath = options.replayPath.empty() ? options.replayPath : std::filesystem::absolute(options.replayPath);
+    settings.outputDir = std::filesystem::absolute(options.soakDir);
+    // options that change how a session simulates are passed on to every run
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg{argv[i]};
+        if (arg.starts_with("--integrator=") || arg.starts_with("--hitch-budget=") || arg == "--strict-alloc") {
+            settings.extraArguments.emplace_back(arg);
+        }
+    }
+    return SoakRunner::Run(settings) ? 0 : 1;
+}
+
+/* --benchmark: time a scene (or the sweep) in the open window */
+int RunBenchmark(const LaunchOptions& options) {
+    BenchmarkRunner::Settings settings;
+    settings.scene = options.benchmarkScene;
+    settings.outputPath = options.benchmarkPath;
+    settings.ticks = options.tickLimit;
+    settings.seed = options.hasSeed ? options.seed : DeterminismConfig::DEFAULT_SEED;
+    settings.render = !options.headless;
+    settings.hasIntegrationPath = options.hasIntegrationPath;
+    settings.integrationPath = options.integrationPath;
+    return BenchmarkRunner::Run(settings) ? 0 : 1;
+}
+
+/* --worlds: each world is built and simulated on its own thread, off the window thread */
+int RunWorlds(const LaunchOptions& options, std::uint32_t seed) {
+    const std::string_view mapFileName = GameConfig::LEVELS[0];
+    // the worlds' threads cannot load the map (its tilesets need the GL context)
+    if (MapManager::Instance().GetMap(mapFileName) == nullptr) {
+        return 1;
+    }
+    struct Result {
+        bool loaded = false;
+        std::uint64_t ticks = 0;
+        std::uint64_t hash = 0;
+    };
+    std::vector<Result> results(options.worlds);
+    std::vector<std::thread> threads;
+    threads.reserve(options.worlds);
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < options.worlds; ++i) {
+        threads.emplace_back([&options, &results, mapFileName, i, worldSeed = seed + static_cast<std::uint32_t>(i)] {
+            GameLevel level{mapFileName, worldSeed};
+            Result& result = results[i];
+            result.loaded = level.IsLoaded();
+            if (!result.loaded) return;
+            if (options.hasIntegrationPath) {
+                level.SetIntegrationPath(options.integrationPath);
+            }
+            AutoplayInput autoplay{worldSeed};
+            level.GetContext().input.SetSource(&autoplay);
+            while (result.ticks < options.tickLimit && !level.IsFinished()) {
+                autoplay.BeginTick();
+                level.Step(DeterminismConfig::FIXED_TIME_STEP);
+                ++result.ticks;
+            }
+            level.GetContext().input.SetSource(nullptr);
+            WorldState scratch;
+            result.hash = HashLevelState(level, scratch);
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    int exitCode = 0;
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& result = results[i];
+        if (!result.loaded) {
+            TraceLog(LOG_ERROR, "World %zu: level failed to load", i);
+            exitCode = 1;
+            continue;
+        }
+        TraceLog(LOG_INFO, "World %zu: seed 0x%08X, %llu ticks, state hash 0x%016llX", i,
+                 seed + static_cast<std::uint32_t>(i), static_cast<unsigned long long>(result.ticks),
+                 static_cast<unsigned long long>(result.hash));
+    }
+    TraceLog(LOG_INFO, "Worlds: %zu in %.3f s", results.size(), seconds);
+    return exitCode;
+}
+}  // namespace
 
 /**
  * @brief Program entry: initializes systems, creates a level and runs the main loop.
@@ -20,29 +338,394 @@ int main(int argc, char** argv) {
     // Set assets relative to executable
     AssetManager::SetAssetRoot(exePath / GameConfig::RESOURCES_PATH);
 
+    const LaunchOptions options = ParseOptions(argc, argv);
+    // before anything creates the job system
+    JobSystem::SetWorkerCount(options.jobThreads);
+    if (options.soakRuns > 0) {
+        return RunSoakTest(options, argc, argv);
+    }
+
+    // Load the replay first: it decides which level and seed the session uses
+    InputReplay replay;
+    const bool replaying = !options.replayPath.empty();
+    if (replaying && !replay.Load(options.replayPath)) {
+        return 1;
+    }
+    const bool netplay = options.netPlayer != 0;
+    if (netplay && (replaying || !options.recordPath.empty())) {
+        TraceLog(LOG_ERROR, "--net-player cannot be combined with --record or --replay");
+        return 1;
+    }
+    if (options.autoplay && replaying) {
+        TraceLog(LOG_ERROR, "--autoplay cannot be combined with --replay");
+        return 1;
+    }
+    const bool benchmarking = !options.benchmarkScene.empty();
+    if (benchmarking && (replaying || netplay || !options.recordPath.empty())) {
+        TraceLog(LOG_ERROR, "--benchmark cannot be combined with --record, --replay or --net-player");
+        return 1;
+    }
+    // the simulation thread only runs plain windowed sessions
+    if (options.pipelined && (replaying || netplay || options.autoplay || options.headless || benchmarking ||
+                              !options.soakReportPath.empty())) {
+        TraceLog(LOG_ERROR, "--pipelined cannot be combined with --replay, --net-player, --autoplay, --headless, "
+                            "--benchmark or --soak-report");
+        return 1;
+    }
+    const bool multiWorld = options.worlds > 0;
+    if (multiWorld && (replaying || netplay || benchmarking || options.pipelined || !options.recordPath.empty() ||
+                       !options.soakReportPath.empty() || !options.stateHashPath.empty() ||
+                       !options.stateHashComparePath.empty())) {
+        TraceLog(LOG_ERROR, "--worlds cannot be combined with --record, --replay, --net-player, --pipelined, "
+                            "--benchmark, --soak-report or --state-hash");
+        return 1;
+    }
+    if (multiWorld && options.tickLimit == 0) {
+        TraceLog(LOG_ERROR, "--worlds requires --ticks=<n>");
+        return 1;
+    }
+    if (options.headless && !benchmarking && !replaying && !(options.deterministic && options.tickLimit > 0)) {
+        TraceLog(LOG_ERROR, "--headless requires --replay=<file> or --deterministic with --ticks=<n>");
+        return 1;
+    }
+    std::size_t levelIndex = replaying ? replay.GetHeader().levelIndex : 0;
+    if (levelIndex >= GameConfig::LEVELS.size()) {
+        TraceLog(LOG_ERROR, "Recording refers to unknown level %zu", levelIndex);
+        return 1;
+    }
+    std::uint32_t seed = options.deterministic ? DeterminismConfig::DEFAULT_SEED : std::random_device{}();
+    if (replaying) {
+        seed = replay.GetHeader().seed;
+    } else if (options.hasSeed) {
+        seed = options.seed;
+    }
+
+    // Headless still needs a (hidden) window: raylib and raytmx require a GL context to load textures
+    if (options.headless || multiWorld) {
+        SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    }
     InitWindow(Config::SCREEN_WIDTH, Config::SCREEN_HEIGHT, "THE GAME");
-    SetTargetFPS(Config::TARGET_FPS);
+    // Benchmarks run uncapped in their own levels
+    if (benchmarking) {
+        const int exitCode = RunBenchmark(options);
+        MapManager::Instance().UnloadAll();
+        TextureManager::Instance().UnloadAll();
+        CloseWindow();
+        return exitCode;
+    }
+    if (multiWorld) {
+        const int exitCode = RunWorlds(options, seed);
+        MapManager::Instance().UnloadAll();
+        TextureManager::Instance().UnloadAll();
+        CloseWindow();
+        return exitCode;
+    }
+    if (!options.headless) {
+        SetTargetFPS(Config::TARGET_FPS);
+    }
 
     // create the first level (just demo level) - will add level switching and simple menu later
-    GameLevel gameLevel0{GameConfig::LEVELS[0]};
+    GameLevel gameLevel0{GameConfig::LEVELS[levelIndex], seed, netplay ? std::size_t{2} : std::size_t{1}};
+    if (options.hasIntegrationPath) {
+        gameLevel0.SetIntegrationPath(options.integrationPath);
+        TraceLog(LOG_INFO, "Body integration kernel: %s",
+                 BodyIntegrator::GetPathName(gameLevel0.GetIntegrationPath()));
+    }
+    // actions, collisions and input of this world
+    WorldContext& world = gameLevel0.GetContext();
+    // per-tick world snapshots for scrubbing the simulation backwards
+    TimeRewind timeRewind;
+    bool rewinding = false;
+
+    InputRecorder recorder;
+    if (!options.recordPath.empty() &&
+        recorder.Open(options.recordPath, static_cast<std::uint16_t>(levelIndex), gameLevel0.GetSeed())) {
+        world.input.SetRecorder(&recorder);
+    }
+    if (replaying) {
+        world.input.SetSource(&replay);
+    }
+    // scripted random input; in netplay the session passes it on as the local player's input
+    AutoplayInput autoplay{seed + static_cast<std::uint32_t>(options.netPlayer)};
+    const bool autoplaying = options.autoplay && !netplay;
+    if (autoplaying) {
+        world.input.SetSource(&autoplay);
+    }
+    // resource samples of a soak run
+    SoakMonitor soakMonitor;
+    if (!options.soakReportPath.empty() && !soakMonitor.Open(options.soakReportPath)) {
+        return 1;
+    }
+    // per-tick state hashes for spotting the exact tick where two runs diverge
+    StateChecksumLog checksums;
+    WorldState hashScratch;
+    if (!options.stateHashPath.empty() && !options.stateHashComparePath.empty()) {
+        TraceLog(LOG_ERROR, "--state-hash and --state-hash-compare cannot be combined");
+        return 1;
+    }
+    if (!options.stateHashPath.empty() && !checksums.OpenWrite(options.stateHashPath)) {
+        return 1;
+    }
+    if (!options.stateHashComparePath.empty() && !checksums.OpenCompare(options.stateHashComparePath)) {
+        return 1;
+    }
+    if (options.deterministic) {
+        TraceLog(LOG_INFO, "Deterministic mode: seed 0x%08X, fixed step %.6f s", gameLevel0.GetSeed(),
+                 DeterminismConfig::FIXED_TIME_STEP);
+    }
+    // Rollback netplay: both players are simulated here, the remote one from its (predicted) network input
+    RollbackSession session;
+    if (netplay) {
+        RollbackSession::Settings netSettings;
+        netSettings.localPlayer = options.netPlayer - 1;
+        netSettings.localPort = options.netPort != 0
+                                    ? options.netPort
+                                    : static_cast<std::uint16_t>(NetConfig::DEFAULT_PORT + netSettings.localPlayer);
+        netSettings.peer.port = static_cast<std::uint16_t>(NetConfig::DEFAULT_PORT + 1 - netSettings.localPlayer);
+        if (options.hasNetPeer) {
+            netSettings.peer = options.netPeer;
+        }
+        netSettings.shim = options.netShim;
+        if (!session.Start(gameLevel0, netSettings, levelIndex, GetTime())) {
+            return 1;
+        }
+        gameLevel0.SetViewPlayer(netSettings.localPlayer);
+        if (checksums.IsOpen()) {
+            // only final ticks: predicted ones may still be rolled back
+            session.SetChecksumLog(&checksums);
+        }
+    }
+    // Rewinding changes the simulation outside of recorded input, so it is off for record/replay, state hashing and netplay
+    const bool rewindEnabled = !replaying && !recorder.IsOpen() && !checksums.IsOpen() && !netplay;
+    Profiler::Instance().SetHitchBudget(options.hitchBudgetMillis);
+    const auto sessionStart = std::chrono::steady_clock::now();
+    if (options.strictAlloc && !AllocTracker::IsEnabled()) {
+        TraceLog(LOG_WARNING, "--strict-alloc has no effect: built without allocation tracking");
+    }
+    std::uint64_t frameCount = 0;
+    // simulated (not rewound) ticks; read by the render thread when pipelined
+    std::atomic<std::uint64_t> simulatedTicks{0};
+    auto tickLimitReached = [&]() {
+        return options.tickLimit > 0 && simulatedTicks.load(std::memory_order_relaxed) >= options.tickLimit;
+    };
+    AllocCounts steadyStateStart;
+    // Start of every rendered frame: steady-state tracking and profiler hotkeys
+    auto beginFrame = [&]() {
+        // Steady state begins after the warm-up frames; from here on a frame should not allocate
+        if (frameCount++ == AllocConfig::STEADY_STATE_WARMUP_FRAMES) {
+            steadyStateStart = AllocTracker::GetTotals();
+            AllocTracker::SetStrict(options.strictAlloc);
+        }
+        PROFILE_BEGIN_FRAME();
+#if defined(GAME_PROFILER)
+        if (IsKeyPressed(ProfilerConfig::OVERLAY_KEY)) {
+            Profiler::Instance().ToggleOverlay();
+        }
+        if (IsKeyPressed(ProfilerConfig::TRACE_KEY)) {
+            Profiler::Instance().StartTraceCapture(path{ProfilerConfig::TRACE_FILE}, ProfilerConfig::TRACE_FRAMES);
+        }
+#endif
+    };
+    // One simulation tick: step back while the rewind key is held, simulate otherwise
+    auto simulateTick = [&](float delta) {
+        // While the rewind key is held, step back one buffered tick per frame instead of simulating
+        if (rewindEnabled && world.input.IsKeyDown(RewindConfig::REWIND_KEY) &&
+            timeRewind.StepBack(gameLevel0)) {
+            rewinding = true;
+            return;
+        }
+        if (rewinding) {
+            // keys released while rewinding must not leave restored movement running
+            world.input.SyncReleasedKeys();
+            rewinding = false;
+        }
+
+        // Poll input, perform the active actions and update all actors
+        if (autoplaying) {
+            autoplay.BeginTick();
+        }
+        recorder.BeginTick(delta);
+        gameLevel0.Step(delta);
+        simulatedTicks.fetch_add(1, std::memory_order_relaxed);
+        if (checksums.IsOpen()) {
+            checksums.Record(HashLevelState(gameLevel0, hashScratch));
+        }
+        // Record the resulting state for rewinding
+        if (rewindEnabled) {
+            timeRewind.Capture(gameLevel0);
+        }
+    };
+
+    // Netplay: one rollback frame per fixed step; the session simulates (and resimulates) the ticks
+    auto advanceNetplay = [&]() {
+        const std::uint8_t buttons = options.autoplay ? autoplay.BeginTick() : NetInputSource::SampleKeyboard();
+        if (session.AdvanceFrame(buttons, GetTime())) {
+            simulatedTicks.fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+    auto netplayRunning = [&]() { return !netplay || session.GetStatus() != RollbackSession::Status::Disconnected; };
+    // A soak run restarts the level when it ends (game over or exit reached)
+    auto levelFinished = [&]() {
+        if (!gameLevel0.IsFinished()) return false;
+        if (!soakMonitor.IsOpen() || replaying) return true;
+        gameLevel0.Restart();
+        soakMonitor.NoteRestart();
+        return false;
+    };
+
+    if (!options.pipelined) {
+        // real time not yet simulated by the fixed-step clock
+        float stepTime = 0.0f;
+        while ((options.headless || !WindowShouldClose()) && !levelFinished() && !tickLimitReached() &&
+               netplayRunning()) {
+            const auto frameStart = std::chrono::steady_clock::now();
+            beginFrame();
+            // Time step of this tick: recorded when replaying, fixed when deterministic, measured otherwise
+            if (replaying) {
+                float delta = 0.0f;
+                if (!replay.BeginTick(delta)) {
+                    PROFILE_END_FRAME();
+                    break;
+                }
+                simulateTick(delta);
+            } else if (netplay) {
+                // headless peers pace themselves to real time, so the network delays mean the same in ticks
+                if (options.headless) {
+                    std::this_thread::sleep_for(std::chrono::duration<float>(DeterminismConfig::FIXED_TIME_STEP));
+                }
+                stepTime += options.headless ? DeterminismConfig::FIXED_TIME_STEP : GetFrameTime();
+                int steps = 0;
+                while (stepTime >= DeterminismConfig::FIXED_TIME_STEP && steps < DeterminismConfig::MAX_CATCHUP_TICKS &&
+                       !gameLevel0.IsFinished() && !tickLimitReached() && netplayRunning()) {
+                    advanceNetplay();
+                    stepTime -= DeterminismConfig::FIXED_TIME_STEP;
+                    ++steps;
+                }
+                if (steps == DeterminismConfig::MAX_CATCHUP_TICKS) {
+                    stepTime = 0.0f;
+                }
+            } else if (options.deterministic) {
+                // simulate whole fixed steps of the elapsed time (exactly one per frame when headless)
+                stepTime += options.headless ? DeterminismConfig::FIXED_TIME_STEP : GetFrameTime();
+                int steps = 0;
+                while (stepTime >= DeterminismConfig::FIXED_TIME_STEP && steps < DeterminismConfig::MAX_CATCHUP_TICKS &&
+                       !gameLevel0.IsFinished() && !tickLimitReached()) {
+                    simulateTick(DeterminismConfig::FIXED_TIME_STEP);
+                    stepTime -= DeterminismConfig::FIXED_TIME_STEP;
+                    ++steps;
+                }
+                if (steps == DeterminismConfig::MAX_CATCHUP_TICKS) {
+                    stepTime = 0.0f;  // too far behind (e.g. after a stall): drop the backlog instead of spiralling
+                }
+            } else {
+                simulateTick(GetFrameTime());
+            }
+            // Render the game level
+            if (!options.headless) {
+                gameLevel0.Render();
+            }
+            if (soakMonitor.IsOpen()) {
+                const auto frameTime = std::chrono::steady_clock::now() - frameStart;
+                soakMonitor.RecordFrame(gameLevel0, simulatedTicks.load(std::memory_order_relaxed),
+                                        std::chrono::duration<double, std::milli>(frameTime).count());
+            }
+            PROFILE_END_FRAME();
+        }
+    } else {
+        /* The simulation thread computes tick N+1 while this (GL) thread draws tick N. Finished
+           ticks are handed over as render states through a lock-free triple buffer; input polled
+           here by raylib is latched for the simulation thread. The profiler only records this
+           thread, so simulation zones are not shown in this mode. */
+        LatchedInput latchedInput;
+        world.input.SetSource(&latchedInput);
+        TripleBuffer<RenderState> renderStates;
+        gameLevel0.CaptureRenderState(renderStates.WriteBuffer());
+        renderStates.Publish();
+
+        std::atomic<bool> simulationRunning{true};
+        std::thread simulation([&] {
+            using Clock = std::chrono::steady_clock;
+            const auto tickPeriod = std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(1.0 / Config::TARGET_FPS));
+            auto lastTick = Clock::now();
+            auto nextTick = lastTick + tickPeriod;
+            while (simulationRunning.load(std::memory_order_acquire) && !tickLimitReached()) {
+                const auto now = Clock::now();
+                const float measured = std::chrono::duration<float>(now - lastTick).count();
+                const float delta = options.deterministic ? DeterminismConfig::FIXED_TIME_STEP : measured;
+                lastTick = now;
 
-    while (!WindowShouldClose() && !gameLevel0.IsGameOver()) {
-        // Poll input and dispatch events
-        InputManager::Instance().Update();
+                latchedInput.BeginTick();
+                simulateTick(delta);
+                gameLevel0.CaptureRenderState(renderStates.WriteBuffer());
+                renderStates.Publish();
 
-        // Update game logic (perform active actions)
-        GameLogic::Instance().Update();
-        // Update all actors
-        gameLevel0.UpdateAll();
-        // Render the game level
-        gameLevel0.Render();
+                // pace ticks to the target frame rate; do not try to catch up after a stall
+                std::this_thread::sleep_until(nextTick);
+                nextTick = std::max(nextTick + tickPeriod, Clock::now());
+            }
+        });
+
+        while (!WindowShouldClose() && !gameLevel0.IsFinished() && !tickLimitReached()) {
+            beginFrame();
+            latchedInput.Latch();
+            renderStates.Acquire();
+            gameLevel0.Render(renderStates.ReadBuffer());
+            PROFILE_END_FRAME();
+        }
+        simulationRunning.store(false, std::memory_order_release);
+        simulation.join();
+        world.input.SetSource(nullptr);
+    }
+
+    AllocTracker::SetStrict(false);
+    if (AllocTracker::IsEnabled() && frameCount > AllocConfig::STEADY_STATE_WARMUP_FRAMES) {
+        const AllocCounts totals = AllocTracker::GetTotals();
+        const auto steadyFrames = static_cast<unsigned long long>(frameCount - AllocConfig::STEADY_STATE_WARMUP_FRAMES);
+        TraceLog(LOG_INFO, "Allocations in %llu steady-state frames: %llu (%llu bytes)", steadyFrames,
+                 static_cast<unsigned long long>(totals.allocations - steadyStateStart.allocations),
+                 static_cast<unsigned long long>(totals.bytes - steadyStateStart.bytes));
     }
+#if defined(GAME_PROFILER)
+    Profiler::Instance().LogFrameTimeStats();
+#endif
 
-    // Cleanup and close
-    GameLogic::Instance().Cleanup();
+    int exitCode = 0;
+    if (netplay) {
+        session.LogStats();
+        if (session.HasDesynced()) {
+            exitCode = 1;
+        }
+        session.Stop();
+    }
+    soakMonitor.Finish();
+    if (checksums.IsOpen() && !checksums.Finish()) {
+        exitCode = 1;
+    }
+    if (recorder.IsOpen()) {
+        recorder.Finish(HashLevelState(gameLevel0, hashScratch));
+        world.input.SetRecorder(nullptr);
+    }
+    if (replaying) {
+        world.input.SetSource(nullptr);
+        const double seconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - sessionStart).count();
+        const auto ticks = static_cast<unsigned long long>(replay.GetReplayedTicks());
+        TraceLog(LOG_INFO, "Replay: %llu ticks in %.3f s (%.0f ticks/s)", ticks, seconds,
+                 seconds > 0.0 ? ticks / seconds : 0.0);
+        if (!replay.HasFooter()) {
+            TraceLog(LOG_WARNING, "Replay: recording has no footer, final state cannot be verified");
+        } else if (HashLevelState(gameLevel0, hashScratch) == replay.GetExpectedHash()) {
+            TraceLog(LOG_INFO, "Replay: final state matches the recording");
+        } else {
+            TraceLog(LOG_ERROR, "Replay: final state DIFFERS from the recording");
+            exitCode = 1;
+        }
+    }
 
-    UnloadTMX(gameLevel0.GetMap());
+    // Cleanup and close (the level clears its actions when it goes out of scope)
+    MapManager::Instance().UnloadAll();
     TextureManager::Instance().UnloadAll();
     CloseWindow();
-    return 0;
+    return exitCode;
 }
@@ -0,0 +1,155 @@
+/*
+ * Checks that the SIMD kernels of BodyIntegrator return the same bits as their scalar
+ * references. Random velocities, gravity masks and time steps are integrated by every
+ * path; the lengths cover the empty batch, every remainder of the SSE2 and AVX2 widths
+ * and a large batch. Paths the CPU does not support are skipped.
+ */
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+#include "body_integrator.h"
+
+namespace {
+constexpr std::uint32_t SEED = 0x5EED1234u;
+constexpr int ROUNDS = 50;  // random inputs per length
+constexpr std::size_t LENGTHS[] = {0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12, 13, 15,
+                                   16, 17, 23, 24, 25, 31, 32, 33, 63, 64, 65, 255, 1000, 1027};
+
+using FloatKernel = void (*)(float*, float*, const std::uint32_t*, std::size_t, float) noexcept;
+using FixedKernel = void (*)(std::int32_t*, std::int32_t*, const std::uint32_t*, std::size_t, Fixed) noexcept;
+
+struct FloatPath {
+    BodyIntegrator::Path path;
+    FloatKernel kernel;
+};
+struct FixedPath {
+    BodyIntegrator::Path path;
+    FixedKernel kernel;
+};
+
+constexpr FloatPath FLOAT_PATHS[] = {
+    {BodyIntegrator::Path::SSE2, &BodyIntegrator::IntegrateSSE2},
+    {BodyIntegrator::Path::AVX2, &BodyIntegrator::IntegrateAVX2},
+};
+constexpr FixedPath FIXED_PATHS[] = {
+    {BodyIntegrator::Path::SSE2, &BodyIntegrator::IntegrateFixedSSE2},
+    {BodyIntegrator::Path::AVX2, &BodyIntegrator::IntegrateFixedAVX2},
+};
+
+bool Supported(BodyIntegrator::Path path) {
+    return static_cast<std::uint8_t>(path) <= static_cast<std::uint8_t>(BodyIntegrator::GetBestSupportedPath());
+}
+
+/* Random masks, mostly falling bodies with some grounded ones, like a level */
+void FillMasks(std::mt19937& rng, std::vector<std::uint32_t>& masks) {
+    std::bernoulli_distribution falling(0.75);
+    for (std::uint32_t& mask : masks) {
+        mask = falling(rng) ? BodyIntegrator::GRAVITY_ON : 0u;
+    }
+}
+
+/* Report the first differing body of two result arrays */
+template <typename T>
+bool Same(const char* what, const char* path, std::size_t length, const std::vector<T>& expected,
+          const std::vector<T>& actual) {
+    for (std::size_t i = 0; i < length; ++i) {
+        if (std::memcmp(&expected[i], &actual[i], sizeof(T)) != 0) {
+            std::fprintf(stderr, "FAIL %s %s: length %zu, body %zu differs from the scalar kernel\n", what, path,
+                         length, i);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool TestFloatPaths(std::mt19937& rng) {
+    std::uniform_real_distribution<float> velocity(-2000.0f, 2000.0f);
+    std::uniform_real_distribution<float> delta(0.0005f, 0.1f);
+    bool passed = true;
+    for (const FloatPath& candidate : FLOAT_PATHS) {
+        const char* name = BodyIntegrator::GetPathName(candidate.path);
+        if (!Supported(candidate.path)) {
+            std::printf("skip float %s: not supported by this CPU\n", name);
+            continue;
+        }
+        bool identical = true;
+        for (const std::size_t length : LENGTHS) {
+            for (int round = 0; round < ROUNDS && identical; ++round) {
+                std::vector<float> velocities(length);
+                std::vector<std::uint32_t> masks(length);
+                for (float& v : velocities) {
+                    v = velocity(rng);
+                }
+                FillMasks(rng, masks);
+                const float step = delta(rng);
+
+                std::vector<float> expectedVelocities = velocities;
+                std::vector<float> expectedDisplacements(length);
+                BodyIntegrator::IntegrateScalar(expectedVelocities.data(), expectedDisplacements.data(), masks.data(),
+                                                length, step);
+                std::vector<float> displacements(length);
+                candidate.kernel(velocities.data(), displacements.data(), masks.data(), length, step);
+
+                if (!Same("float velocity", name, length, expectedVelocities, velocities) ||
+                    !Same("float displacement", name, length, expectedDisplacements, displacements)) {
+                    identical = false;
+                }
+            }
+        }
+        std::printf("float %s: %s\n", name, identical ? "identical" : "MISMATCH");
+        passed = passed && identical;
+    }
+    return passed;
+}
+
+bool TestFixedPaths(std::mt19937& rng) {
+    // any raw velocity (the kernels wrap) and any step up to the largest one they accept
+    std::uniform_int_distribution<std::int32_t> velocity(std::numeric_limits<std::int32_t>::min(),
+                                                        std::numeric_limits<std::int32_t>::max());
+    std::uniform_int_distribution<std::int32_t> delta(0, BodyIntegrator::MAX_FIXED_STEP.raw);
+    bool passed = true;
+    for (const FixedPath& candidate : FIXED_PATHS) {
+        const char* name = BodyIntegrator::GetPathName(candidate.path);
+        if (!Supported(candidate.path)) {
+            std::printf("skip fixed %s: not supported by this CPU\n", name);
+            continue;
+        }
+        bool identical = true;
+        for (const std::size_t length : LENGTHS) {
+            for (int round = 0; round < ROUNDS && identical; ++round) {
+                std::vector<std::int32_t> velocities(length);
+                std::vector<std::uint32_t> masks(length);
+                for (std::int32_t& v : velocities) {
+                    v = velocity(rng);
+                }
+                FillMasks(rng, masks);
+                const Fixed step = Fixed::FromRaw(delta(rng));
+
+                std::vector<std::int32_t> expectedVelocities = velocities;
+                std::vector<std::int32_t> expectedDisplacements(length);
+                BodyIntegrator::IntegrateFixedScalar(expectedVelocities.data(), expectedDisplacements.data(),
+                                                     masks.data(), length, step);
+                std::vector<std::int32_t> displacements(length);
+                candidate.kernel(velocities.data(), displacements.data(), masks.data(), length, step);
+
+                if (!Same("fixed velocity", name, length, expectedVelocities, velocities) ||
+                    !Same("fixed displacement", name, length, expectedDisplacements, displacements)) {
+                    identical = false;
+                }
+            }
+        }
+        std::printf("fixed %s: %s\n", name, identical ? "identical" : "MISMATCH");
+        passed = passed && identical;
+    }
+    return passed;
+}
+}  // namespace
+
+int main() {
+    std::mt19937 rng{SEED};
+    const bool floatPassed = TestFloatPaths(rng);
+    const bool fixedPassed = TestFixedPaths(rng);
+    return floatPassed && fixedPassed ? 0 : 1;
+}
@@ -0,0 +1,245 @@
+/*
+ * Checks the trigger volumes of TriggerSystem: which points a rectangle, a polygon, a
+ * rotated rectangle and an ellipse read from a TMX object layer contain, and the
+ * Enter/Stay/Exit events an actor produces while it walks in and out of them and dies.
+ * The map is built in memory; the actors live in an empty level (no map file, no window).
+ */
+#include <cstdio>
+#include <memory>
+#include <span>
+#include <vector>
+#include "gamelevel.h"
+#include "event_handler.h"
+#include "trigger_system.h"
+
+namespace {
+// Volume indices, in object order
+constexpr std::uint32_t RECTANGLE = 0;
+constexpr std::uint32_t TRIANGLE = 1;
+constexpr std::uint32_t ROTATED = 2;
+constexpr std::uint32_t ELLIPSE = 3;
+
+/* A 2x2 collider centred on the point it is moved to */
+class Probe : public Actor {
+public:
+    Probe(GameLevel& level, std::uint32_t slot, std::uint32_t layer) : Actor(level, {}) {
+        SetCollider(0.0f, 0.0f, 2.0f, 2.0f);
+        SetCollisionFilter(layer, 0);
+        SetSpawnSlot(slot);
+    }
+    void MoveTo(Vector2 center) { SetPosition(center.x - 1.0f, center.y - 1.0f); }
+};
+
+class Recorder : public IEventHandler<TriggerEvent> {
+public:
+    void OnEvents(std::span<const TriggerEvent> batch) override { events.assign(batch.begin(), batch.end()); }
+    std::vector<TriggerEvent> events;
+};
+
+struct Expected {
+    std::uint32_t trigger;
+    ContactPhase phase;
+};
+
+const char* PhaseName(ContactPhase phase) {
+    switch (phase) {
+    case ContactPhase::Enter:
+        return "Enter";
+    case ContactPhase::Stay:
+        return "Stay";
+    case ContactPhase::Exit:
+        return "Exit";
+    }
+    return "?";
+}
+
+/* The map: 10x10 cells of 16 px with one object layer */
+struct TestMap {
+    char exitClass[5] = "Exit";
+    char checkpointName[11] = "Checkpoint";
+    char layerName[9] = "triggers";
+    Vector2 triangle[3] = {{0.0f, 0.0f}, {48.0f, 0.0f}, {0.0f, 48.0f}};
+    TmxObject objects[4]{};
+    TmxLayer layer{};
+    TmxMap map{};
+
+    TestMap() {
+        // axis-aligned rectangle covering 16..48 on both axes, classed as an exit
+        objects[RECTANGLE].type = OBJECT_TYPE_RECTANGLE;
+        objects[RECTANGLE].id = 1;
+        objects[RECTANGLE].typeString = exitClass;
+        objects[RECTANGLE].x = 16.0;
+        objects[RECTANGLE].y = 16.0;
+        objects[RECTANGLE].width = 32.0;
+        objects[RECTANGLE].height = 32.0;
+        // right triangle with its corner at (100, 100), untyped but named like a kind
+        objects[TRIANGLE].type = OBJECT_TYPE_POLYGON;
+        objects[TRIANGLE].id = 2;
+        objects[TRIANGLE].name = checkpointName;
+        objects[TRIANGLE].x = 100.0;
+        objects[TRIANGLE].y = 100.0;
+        objects[TRIANGLE].points = triangle;
+        objects[TRIANGLE].pointsLength = 3;
+        // 40x10 at (80, 20) turned 90 degrees clockwise about its position: x 70..80, y 20..60
+        objects[ROTATED].type = OBJECT_TYPE_RECTANGLE;
+        objects[ROTATED].id = 3;
+        objects[ROTATED].x = 80.0;
+        objects[ROTATED].y = 20.0;
+        objects[ROTATED].width = 40.0;
+        objects[ROTATED].height = 10.0;
+        objects[ROTATED].rotation = 90.0;
+        // ellipse inscribed in 16..48 x 100..116
+        objects[ELLIPSE].type = OBJECT_TYPE_ELLIPSE;
+        objects[ELLIPSE].id = 4;
+        objects[ELLIPSE].x = 16.0;
+        objects[ELLIPSE].y = 100.0;
+        objects[ELLIPSE].width = 32.0;
+        objects[ELLIPSE].height = 16.0;
+        for (TmxObject& object : objects) {
+            object.visible = true;
+        }
+
+        layer.type = LAYER_TYPE_OBJECT_GROUP;
+        layer.name = layerName;
+        layer.exact.objectGroup.objects = objects;
+        layer.exact.objectGroup.objectsLength = 4;
+        map.width = 10;
+        map.height = 10;
+        map.tileWidth = 16;
+        map.tileHeight = 16;
+    }
+};
+
+bool TestShapes(const TriggerSystem& triggers) {
+    struct Case {
+        std::uint32_t trigger;
+        Vector2 point;
+        bool inside;
+    };
+    constexpr Case CASES[] = {
+        {RECTANGLE, {30.0f, 30.0f}, true},  {RECTANGLE, {17.0f, 47.0f}, true},
+        {RECTANGLE, {10.0f, 30.0f}, false}, {RECTANGLE, {30.0f, 50.0f}, false},
+        {TRIANGLE, {110.0f, 110.0f}, true}, {TRIANGLE, {101.0f, 140.0f}, true},
+        {TRIANGLE, {140.0f, 140.0f}, false}, // inside the bounds, beyond the hypotenuse
+        {TRIANGLE, {90.0f, 110.0f}, false},
+        {ROTATED, {75.0f, 40.0f}, true},    {ROTATED, {71.0f, 58.0f}, true},
+        {ROTATED, {100.0f, 25.0f}, false},  // where the rectangle lies before the rotation
+        {ROTATED, {75.0f, 65.0f}, false},
+        {ELLIPSE, {32.0f, 108.0f}, true},   {ELLIPSE, {18.0f, 108.0f}, true},
+        {ELLIPSE, {18.0f, 101.0f}, false},  // corner of the bounds
+    };
+    bool passed = true;
+    if (triggers.GetCount() != 4) {
+        std::fprintf(stderr, "FAIL shapes: %zu volumes built, expected 4\n", triggers.GetCount());
+        return false;
+    }
+    if (triggers.Get(RECTANGLE).kind != TriggerKind::Exit || triggers.Get(TRIANGLE).kind != TriggerKind::Checkpoint ||
+        triggers.Get(ROTATED).kind != TriggerKind::Custom) {
+        std::fprintf(stderr, "FAIL shapes: kinds not taken from the class or the name\n");
+        passed = false;
+    }
+    if (triggers.Get(ROTATED).shape != TriggerShape::Polygon) {
+        std::fprintf(stderr, "FAIL shapes: rotated rectangle is not a polygon\n");
+        passed = false;
+    }
+    for (const Case& test : CASES) {
+        if (triggers.Contains(test.trigger, test.point) != test.inside) {
+            std::fprintf(stderr, "FAIL shapes: volume %u %s (%.0f, %.0f)\n", test.trigger,
+                         test.inside ? "does not contain" : "contains", test.point.x, test.point.y);
+            passed = false;
+        }
+    }
+    std::printf("shapes: %s\n", passed ? "ok" : "FAILED");
+    return passed;
+}
+
+bool TestPhases(TriggerSystem& triggers) {
+    GameLevel level{"no_such_map.tmx"};  // empty: only provides the actors' world context
+    EventBus events;
+    Recorder recorder;
+    events.Subscribe<TriggerEvent>(&recorder);
+
+    std::vector<std::unique_ptr<Actor>> actors;
+    auto walker = std::make_unique<Probe>(level, 0, CollisionConfig::LAYER_PLAYER);
+    auto enemy = std::make_unique<Probe>(level, 1, CollisionConfig::LAYER_ENEMY);
+    auto player = std::make_unique<Probe>(level, 2, CollisionConfig::LAYER_PLAYER);
+    Probe& walking = *walker;
+    enemy->MoveTo({30.0f, 30.0f});  // never reported: no volume reacts to enemies
+    player->MoveTo({32.0f, 108.0f});
+    actors.push_back(std::move(walker));
+    actors.push_back(std::move(enemy));
+    Actor* players[] = {player.get()};
+
+    struct Step {
+        const char* what;
+        Vector2 center;
+        bool die;
+        std::vector<Expected> walker;
+    };
+    const Step steps[] = {
+        {"outside", {5.0f, 5.0f}, false, {}},
+        {"enter", {30.0f, 30.0f}, false, {{RECTANGLE, ContactPhase::Enter}}},
+        {"stay", {31.0f, 30.0f}, false, {{RECTANGLE, ContactPhase::Stay}}},
+        {"move across", {75.0f, 40.0f}, false, {{RECTANGLE, ContactPhase::Exit}, {ROTATED, ContactPhase::Enter}}},
+        {"leave", {100.0f, 25.0f}, false, {{ROTATED, ContactPhase::Exit}}},
+        {"re-enter", {110.0f, 110.0f}, false, {{TRIANGLE, ContactPhase::Enter}}},
+        {"die inside", {110.0f, 110.0f}, true, {{TRIANGLE, ContactPhase::Exit}}},
+        {"dead", {110.0f, 110.0f}, false, {}},
+    };
+    bool passed = true;
+    bool playerEntered = false;
+    for (const Step& step : steps) {
+        walking.MoveTo(step.center);
+        if (step.die) walking.Destroy();
+        triggers.Update(actors, players, events);
+        recorder.events.clear();
+        events.Dispatch<TriggerEvent>();
+
+        // the player probe stands still in the ellipse: Enter once, then Stay
+        std::vector<Expected> walked;
+        for (const TriggerEvent& event : recorder.events) {
+            if (event.actor == &walking) {
+                walked.push_back({event.trigger, event.phase});
+            } else if (event.actor == player.get() && event.trigger == ELLIPSE &&
+                       event.phase == (playerEntered ? ContactPhase::Stay : ContactPhase::Enter)) {
+                playerEntered = true;
+            } else {
+                std::fprintf(stderr, "FAIL %s: unexpected %s of volume %u\n", step.what, PhaseName(event.phase),
+                             event.trigger);
+                passed = false;
+            }
+            if (event.kind != triggers.Get(event.trigger).kind) {
+                std::fprintf(stderr, "FAIL %s: event kind differs from its volume\n", step.what);
+                passed = false;
+            }
+        }
+        bool same = walked.size() == step.walker.size();
+        for (std::size_t i = 0; same && i < walked.size(); ++i) {
+            same = walked[i].trigger == step.walker[i].trigger && walked[i].phase == step.walker[i].phase;
+        }
+        if (!same) {
+            std::fprintf(stderr, "FAIL %s: %zu events, expected %zu:", step.what, walked.size(), step.walker.size());
+            for (const Expected& event : walked) {
+                std::fprintf(stderr, " %s %u", PhaseName(event.phase), event.trigger);
+            }
+            std::fprintf(stderr, "\n");
+            passed = false;
+        }
+    }
+    if (!playerEntered || triggers.GetOccupancyCount() != 1) {
+        std::fprintf(stderr, "FAIL phases: the player probe is not the only occupant left\n");
+        passed = false;
+    }
+    std::printf("phases: %s\n", passed ? "ok" : "FAILED");
+    return passed;
+}
+}  // namespace
+
+int main() {
+    TestMap test;
+    TriggerSystem triggers;
+    triggers.Build(&test.map, &test.layer);
+    const bool shapesPassed = TestShapes(triggers);
+    const bool phasesPassed = TestPhases(triggers);
+    return shapesPassed && phasesPassed ? 0 : 1;
+}